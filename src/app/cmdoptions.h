@@ -38,6 +38,9 @@ struct CmdOptions {
         ScoreTransposeOptions,
         ForceMode,
         SoundProfile,
+        JobsCount,
+        JobProcessArgs,
+        JobReportPath,
 
         // Video
     };
@@ -71,6 +74,7 @@ struct CmdOptions {
         std::optional<int> fps;
         std::optional<double> leadingSec;
         std::optional<double> trailingSec;
+        std::optional<bool> encodeInBackground;
     } exportVideo;
 
     struct {
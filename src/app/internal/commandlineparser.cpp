@@ -50,6 +50,33 @@ static QStringList prepareArguments(int argc, char** argv)
     return args;
 }
 
+//! NOTE The options of the app without the ones of the batch job itself,
+//! for the processes converting the shares of the batch job
+static QStringList batchJobProcessArguments(const QStringList& args)
+{
+    static const QStringList JOB_OPTIONS = { "-j", "--job", "--jobs", "--job-report" };
+
+    QStringList result;
+
+    for (int i = 1; i < args.size(); ++i) {
+        const QString& arg = args.at(i);
+
+        if (JOB_OPTIONS.contains(arg)) {
+            ++i; // skip the value
+            continue;
+        }
+
+        if (arg.startsWith("--job=") || arg.startsWith("--jobs=") || arg.startsWith("--job-report=")
+            || (arg.startsWith("-j") && !arg.startsWith("--"))) {
+            continue;
+        }
+
+        result << arg;
+    }
+
+    return result;
+}
+
 template<typename ... Args>
 QCommandLineOption internalCommandLineOption(Args&& ... args)
 {
@@ -84,6 +111,10 @@ void CommandLineParser::init()
     // Converter mode
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
+    m_parser.addOption(QCommandLineOption("jobs", "Use with '-j <file>', process up to 'count' conversions of the job concurrently, "
+                                                  "in separate processes", "count"));
+    m_parser.addOption(QCommandLineOption("job-report", "Use with '-j <file>', write the result and timing of each conversion "
+                                                        "to a JSON file", "file"));
     m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
     m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
     m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
@@ -130,6 +161,7 @@ void CommandLineParser::init()
     m_parser.addOption(QCommandLineOption("fps", "Frame per second [60, 30, 24]", "24"));
     m_parser.addOption(QCommandLineOption("ls", "Pause before playback in seconds (3.0)", "3.0"));
     m_parser.addOption(QCommandLineOption("ts", "Pause before end of video in seconds (3.0)", "3.0"));
+    m_parser.addOption(QCommandLineOption("video-single-thread", "Encode the video frames on the same thread they are drawn on"));
 #endif
 
     m_parser.addOption(QCommandLineOption("gp-linked", "create tabulature linked staves for guitar pro"));
@@ -305,6 +337,20 @@ void CommandLineParser::parse(int argc, char** argv)
         m_options.runMode = IApplication::RunMode::ConsoleApp;
         m_options.converterTask.type = ConvertType::Batch;
         m_options.converterTask.inputFile = fromUserInputPath(m_parser.value("j"));
+
+        if (m_parser.isSet("jobs")) {
+            std::optional<int> val = intValue("jobs");
+            if (val && val.value() > 0) {
+                m_options.converterTask.params[CmdOptions::ParamKey::JobsCount] = val.value();
+                m_options.converterTask.params[CmdOptions::ParamKey::JobProcessArgs] = batchJobProcessArguments(args);
+            } else {
+                LOGE() << "Option: --jobs not recognized jobs count: " << m_parser.value("jobs");
+            }
+        }
+
+        if (m_parser.isSet("job-report")) {
+            m_options.converterTask.params[CmdOptions::ParamKey::JobReportPath] = fromUserInputPath(m_parser.value("job-report"));
+        }
     }
 
     if (m_parser.isSet("score-media")) {
@@ -400,6 +446,10 @@ void CommandLineParser::parse(int argc, char** argv)
         if (m_parser.isSet("ts")) {
             m_options.exportVideo.trailingSec = doubleValue("ts");
         }
+
+        if (m_parser.isSet("video-single-thread")) {
+            m_options.exportVideo.encodeInBackground = false;
+        }
     }
 #endif
 
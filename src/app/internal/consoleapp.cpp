@@ -241,6 +241,7 @@ void ConsoleApp::applyCommandLineOptions(const CmdOptions& options, IApplication
     videoExportConfiguration()->setFps(options.exportVideo.fps);
     videoExportConfiguration()->setLeadingSec(options.exportVideo.leadingSec);
     videoExportConfiguration()->setTrailingSec(options.exportVideo.trailingSec);
+    videoExportConfiguration()->setEncodeInBackground(options.exportVideo.encodeInBackground);
 #endif
 
 #ifdef MUE_BUILD_IMPORTEXPORT_MODULE
@@ -274,9 +275,15 @@ int ConsoleApp::processConverter(const CmdOptions::ConverterTask& task)
     }
 
     switch (task.type) {
-    case ConvertType::Batch:
-        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode, soundProfile);
-        break;
+    case ConvertType::Batch: {
+        muse::io::path_t reportPath = task.params[CmdOptions::ParamKey::JobReportPath].toString();
+        size_t jobsCount = static_cast<size_t>(task.params.value(CmdOptions::ParamKey::JobsCount, 1).toInt());
+        std::vector<std::string> jobProcessArgs;
+        for (const QString& arg : task.params[CmdOptions::ParamKey::JobProcessArgs].toStringList()) {
+            jobProcessArgs.push_back(arg.toStdString());
+        }
+        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode, soundProfile, reportPath, jobsCount, jobProcessArgs);
+    } break;
     case ConvertType::File:
         ret = converter()->fileConvert(task.inputFile, task.outputFile, stylePath, forceMode, soundProfile);
         break;
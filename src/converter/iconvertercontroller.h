@@ -22,6 +22,9 @@
 #ifndef MU_CONVERTER_ICONVERTERCONTROLLER_H
 #define MU_CONVERTER_ICONVERTERCONTROLLER_H
 
+#include <string>
+#include <vector>
+
 #include "modularity/imoduleinterface.h"
 #include "types/ret.h"
 #include "io/path.h"
@@ -38,7 +41,9 @@ public:
                                   const muse::String& soundProfile = muse::String()) = 0;
     virtual muse::Ret batchConvert(const muse::io::path_t& batchJobFile,
                                    const muse::io::path_t& stylePath = muse::io::path_t(), bool forceMode = false,
-                                   const muse::String& soundProfile = muse::String()) = 0;
+                                   const muse::String& soundProfile = muse::String(),
+                                   const muse::io::path_t& reportPath = muse::io::path_t(), size_t jobsCount = 1,
+                                   const std::vector<std::string>& jobProcessArgs = {}) = 0;
 
     virtual muse::Ret convertScoreParts(const muse::io::path_t& in, const muse::io::path_t& out,
                                         const muse::io::path_t& stylePath = muse::io::path_t(), bool forceMode = false) = 0;
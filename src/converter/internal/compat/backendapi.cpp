@@ -294,25 +294,29 @@ Ret BackendApi::exportScorePngs(const INotationPtr notation, BackendJsonWriter&
 
     PageList notationPages = pages(notation);
 
-    bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        ByteArray pngData;
-        Buffer pngDevice(&pngData);
-        pngDevice.open(IODevice::ReadWrite);
+    std::vector<ByteArray> pngDatas(notationPages.size());
 
-        INotationWriter::Options options = {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
-        };
+    auto openBuffer = [&pngDatas](size_t i) -> std::unique_ptr<IODevice> {
+        std::unique_ptr<Buffer> pngDevice = std::make_unique<Buffer>(&pngDatas[i]);
+        pngDevice->open(IODevice::ReadWrite);
+        return pngDevice;
+    };
 
-        Ret writeRet = pngWriter->write(notation, pngDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
-            result = false;
-        }
+    INotationWriter::Options options = {
+        { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
+    };
 
-        bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(pngData.toQByteArrayNoCopy().toBase64(), !lastArrayValue);
+    //! NOTE: The pages are written in order, some writers compress them concurrently
+    bool result = true;
+    Ret writeRet = pngWriter->writePages(notation, pngDatas.size(), openBuffer, options);
+    if (!writeRet) {
+        LOGW() << writeRet.toString();
+        result = false;
+    }
+
+    for (size_t i = 0; i < pngDatas.size(); ++i) {
+        bool lastArrayValue = ((pngDatas.size() - 1) == i);
+        jsonWriter.addValue(pngDatas[i].toQByteArrayNoCopy().toBase64(), !lastArrayValue);
     }
 
     jsonWriter.closeArray(addSeparator);
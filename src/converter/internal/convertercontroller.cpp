@@ -25,10 +25,16 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonParseError>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <future>
 
 #include "global/io/file.h"
 #include "global/io/dir.h"
 #include "global/stringutils.h"
+#include "global/concurrency/taskscheduler.h"
 
 #include "convertercodes.h"
 #include "compat/backendapi.h"
@@ -46,7 +52,8 @@ static const std::string PNG_SUFFIX = "png";
 static const std::string SVG_SUFFIX = "svg";
 
 Ret ConverterController::batchConvert(const muse::io::path_t& batchJobFile, const muse::io::path_t& stylePath, bool forceMode,
-                                      const String& soundProfile)
+                                      const String& soundProfile, const muse::io::path_t& reportPath, size_t jobsCount,
+                                      const std::vector<std::string>& jobProcessArgs)
 {
     TRACEFUNC;
 
@@ -56,13 +63,38 @@ Ret ConverterController::batchConvert(const muse::io::path_t& batchJobFile, cons
         return batchJob.ret;
     }
 
-    StringList errors;
+    QElapsedTimer timer;
+    timer.start();
+
+    JobResultList results;
+
+    if (jobsCount > 1 && batchJob.val.size() > 1) {
+        results = runJobsInProcesses(batchJob.val, std::min(jobsCount, batchJob.val.size()), jobProcessArgs);
+    } else {
+        results.reserve(batchJob.val.size());
+
+        for (const Job& job : batchJob.val) {
+            results.push_back(runJob(job, stylePath, forceMode, soundProfile));
+        }
+    }
+
+    const int64_t totalDurationMs = timer.elapsed();
+    LOGI() << "batch finished, jobs: " << results.size() << ", total ms: " << totalDurationMs;
 
-    for (const Job& job : batchJob.val) {
-        Ret ret = fileConvert(job.in, job.out, stylePath, forceMode, soundProfile);
+    if (!reportPath.empty()) {
+        Ret ret = writeBatchReport(results, totalDurationMs, reportPath);
         if (!ret) {
+            LOGE() << "failed write batch report, err: " << ret.toString() << ", path: " << reportPath;
+        }
+    }
+
+    StringList errors;
+
+    for (const JobResult& result : results) {
+        if (!result.ret) {
             errors.emplace_back(String(u"failed convert, err: %1, in: %2, out: %3")
-                                .arg(String::fromStdString(ret.toString())).arg(job.in.toString()).arg(job.out.toString()));
+                                .arg(String::fromStdString(result.ret.toString()))
+                                .arg(result.job.in.toString()).arg(result.job.out.toString()));
         }
     }
 
@@ -73,6 +105,145 @@ Ret ConverterController::batchConvert(const muse::io::path_t& batchJobFile, cons
     return make_ret(Ret::Code::Ok);
 }
 
+ConverterController::JobResult ConverterController::runJob(const Job& job, const muse::io::path_t& stylePath, bool forceMode,
+                                                           const String& soundProfile)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    JobResult result;
+    result.job = job;
+    result.ret = fileConvert(job.in, job.out, stylePath, forceMode, soundProfile);
+    result.durationMs = timer.elapsed();
+
+    return result;
+}
+
+ConverterController::JobResultList ConverterController::runJobsInProcesses(const BatchJob& batchJob, size_t processCount,
+                                                                         const std::vector<std::string>& jobProcessArgs)
+{
+    TRACEFUNC;
+
+    //! NOTE The export goes through process-wide state (MScore::pdfPrinting, MScore::svgPrinting, MScore::pixelRatio,
+    //! the writers and the caches), so the concurrent jobs are run by other processes of the app, started with the same options.
+    //! Each process converts its share of the jobs as a batch job and reports the results
+    JobResultList results;
+    results.reserve(batchJob.size());
+    for (const Job& job : batchJob) {
+        results.push_back({ job, make_ret(Err::ConvertFailed), 0 });
+    }
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        LOGE() << "failed create temp dir for the batch job processes, err: " << tempDir.errorString();
+        for (JobResult& result : results) {
+            result.ret = make_ret(Err::BatchJobFileFailedOpen);
+        }
+        return results;
+    }
+
+    std::vector<std::vector<size_t> > shares(processCount);
+    for (size_t i = 0; i < results.size(); ++i) {
+        shares[i % processCount].push_back(i);
+    }
+
+    const std::string appPath = globalConfiguration()->appBinPath().toStdString();
+
+    auto runShare = [this, &results, &tempDir, &appPath, &jobProcessArgs](const std::vector<size_t>& share, size_t shareIdx) {
+        const QString jobPath = tempDir.filePath(QString("job-%1.json").arg(shareIdx));
+        const QString reportPath = tempDir.filePath(QString("report-%1.json").arg(shareIdx));
+
+        QJsonArray jobsArray;
+        for (size_t idx : share) {
+            QJsonObject obj;
+            obj["in"] = results[idx].job.in.toQString();
+            obj["out"] = results[idx].job.out.toQString();
+            jobsArray.append(obj);
+        }
+
+        QByteArray jobJson = QJsonDocument(jobsArray).toJson(QJsonDocument::Compact);
+        Ret ret = File::writeFile(jobPath, ByteArray::fromQByteArrayNoCopy(jobJson));
+        if (!ret) {
+            for (size_t idx : share) {
+                results[idx].ret = make_ret(Err::BatchJobFileFailedOpen, ret.toString());
+            }
+            return;
+        }
+
+        std::vector<std::string> args = jobProcessArgs;
+        args.insert(args.end(), { "-j", jobPath.toStdString(), "--job-report", reportPath.toStdString() });
+
+        const int code = process()->execute(appPath, args);
+
+        QFile reportFile(reportPath);
+        QJsonArray reportArray;
+        if (reportFile.open(QIODevice::ReadOnly)) {
+            reportArray = QJsonDocument::fromJson(reportFile.readAll()).object().value("jobs").toArray();
+        }
+
+        for (size_t i = 0; i < share.size(); ++i) {
+            JobResult& result = results[share[i]];
+            if (static_cast<int>(i) >= reportArray.size()) {
+                result.ret = make_ret(Err::ConvertFailed, "conversion process exited with code " + std::to_string(code));
+                continue;
+            }
+
+            const QJsonObject obj = reportArray.at(static_cast<int>(i)).toObject();
+            result.ret = obj["success"].toBool() ? make_ok() : Ret(obj["code"].toInt(), obj["error"].toString().toStdString());
+            result.durationMs = static_cast<int64_t>(obj["durationMs"].toDouble());
+        }
+    };
+
+    //! NOTE The threads only wait for the processes
+    TaskScheduler pool(static_cast<thread_pool_size_t>(processCount));
+    std::vector<std::future<void> > shareResults;
+    for (size_t i = 0; i < shares.size(); ++i) {
+        shareResults.push_back(pool.submit([&runShare, &shares, i]() {
+            runShare(shares[i], i);
+        }));
+    }
+
+    for (std::future<void>& shareResult : shareResults) {
+        shareResult.wait();
+    }
+
+    return results;
+}
+
+Ret ConverterController::writeBatchReport(const JobResultList& results, int64_t totalDurationMs, const muse::io::path_t& reportPath) const
+{
+    TRACEFUNC;
+
+    QJsonArray jobsArray;
+    size_t failedCount = 0;
+
+    for (const JobResult& result : results) {
+        QJsonObject obj;
+        obj["in"] = result.job.in.toQString();
+        obj["out"] = result.job.out.toQString();
+        obj["success"] = result.ret.success();
+        obj["code"] = result.ret.code();
+        obj["durationMs"] = static_cast<qint64>(result.durationMs);
+
+        if (!result.ret) {
+            obj["error"] = QString::fromStdString(result.ret.toString());
+            ++failedCount;
+        }
+
+        jobsArray.append(obj);
+    }
+
+    QJsonObject root;
+    root["jobs"] = jobsArray;
+    root["jobsCount"] = static_cast<qint64>(results.size());
+    root["failedCount"] = static_cast<qint64>(failedCount);
+    root["totalDurationMs"] = static_cast<qint64>(totalDurationMs);
+
+    QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+
+    return File::writeFile(reportPath, ByteArray::fromQByteArrayNoCopy(json));
+}
+
 Ret ConverterController::fileConvert(const muse::io::path_t& in, const muse::io::path_t& out, const muse::io::path_t& stylePath,
                                      bool forceMode,
                                      const String& soundProfile)
@@ -213,30 +384,35 @@ Ret ConverterController::convertPageByPage(INotationWriterPtr writer, INotationP
 {
     TRACEFUNC;
 
-    for (size_t i = 0; i < notation->elements()->pages().size(); i++) {
+    bool openFailed = false;
+
+    auto openFile = [&out, &openFailed](size_t i) -> std::unique_ptr<IODevice> {
         const String filePath = muse::io::path_t(io::dirpath(out) + "/"
                                                  + io::completeBasename(out) + "-%1."
                                                  + io::suffix(out)).toString().arg(i + 1);
 
-        File file(filePath);
-        if (!file.open(File::WriteOnly)) {
-            return make_ret(Err::OutFileFailedOpen);
+        std::unique_ptr<File> file = std::make_unique<File>(filePath);
+        if (!file->open(File::WriteOnly)) {
+            openFailed = true;
+            return nullptr;
         }
 
-        INotationWriter::Options options = {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-        };
+        file->setMeta("dir_path", out.toStdString());
+        file->setMeta("file_path", filePath.toStdString());
 
-        file.setMeta("dir_path", out.toStdString());
-        file.setMeta("file_path", filePath.toStdString());
+        return file;
+    };
 
-        Ret ret = writer->write(notation, file, options);
-        if (!ret) {
-            LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
-            return make_ret(Err::OutFileFailedWrite);
-        }
+    //! NOTE: The pages are written in order, some writers compress them concurrently.
+    //! Each file is opened when its page is written and closed right after
+    Ret ret = writer->writePages(notation, notation->elements()->pages().size(), openFile);
+    if (openFailed) {
+        return make_ret(Err::OutFileFailedOpen);
+    }
 
-        file.close();
+    if (!ret) {
+        LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
+        return make_ret(Err::OutFileFailedWrite);
     }
 
     return make_ret(Ret::Code::Ok);
@@ -23,6 +23,7 @@
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
 #include <list>
+#include <vector>
 
 #include "../iconvertercontroller.h"
 
@@ -31,6 +32,8 @@
 #include "project/inotationwritersregister.h"
 #include "project/iprojectrwregister.h"
 #include "context/iglobalcontext.h"
+#include "global/iglobalconfiguration.h"
+#include "global/iprocess.h"
 
 #include "types/retval.h"
 
@@ -41,6 +44,8 @@ class ConverterController : public IConverterController, public muse::Injectable
     muse::Inject<project::INotationWritersRegister> writers = { this };
     muse::Inject<project::IProjectRWRegister> projectRW = { this };
     muse::Inject<context::IGlobalContext> globalContext = { this };
+    muse::Inject<muse::IGlobalConfiguration> globalConfiguration = { this };
+    muse::Inject<muse::IProcess> process = { this };
 
 public:
     ConverterController(const muse::modularity::ContextPtr& iocCtx)
@@ -51,7 +56,9 @@ public:
                           const muse::String& soundProfile = muse::String()) override;
     muse::Ret batchConvert(const muse::io::path_t& batchJobFile,
                            const muse::io::path_t& stylePath = muse::io::path_t(), bool forceMode = false,
-                           const muse::String& soundProfile = muse::String()) override;
+                           const muse::String& soundProfile = muse::String(),
+                           const muse::io::path_t& reportPath = muse::io::path_t(), size_t jobsCount = 1,
+                           const std::vector<std::string>& jobProcessArgs = {}) override;
 
     muse::Ret convertScoreParts(const muse::io::path_t& in, const muse::io::path_t& out,
                                 const muse::io::path_t& stylePath = muse::io::path_t(), bool forceMode = false) override;
@@ -81,8 +88,20 @@ private:
 
     using BatchJob = std::list<Job>;
 
+    struct JobResult {
+        Job job;
+        muse::Ret ret;
+        int64_t durationMs = 0;
+    };
+
+    using JobResultList = std::vector<JobResult>;
+
     muse::RetVal<BatchJob> parseBatchJob(const muse::io::path_t& batchJobFile) const;
 
+    JobResult runJob(const Job& job, const muse::io::path_t& stylePath, bool forceMode, const muse::String& soundProfile);
+    JobResultList runJobsInProcesses(const BatchJob& batchJob, size_t processCount, const std::vector<std::string>& jobProcessArgs);
+    muse::Ret writeBatchReport(const JobResultList& results, int64_t totalDurationMs, const muse::io::path_t& reportPath) const;
+
     bool isConvertPageByPage(const std::string& suffix) const;
     muse::Ret convertPageByPage(project::INotationWriterPtr writer, notation::INotationPtr notation, const muse::io::path_t& out) const;
     muse::Ret convertFullNotation(project::INotationWriterPtr writer, notation::INotationPtr notation, const muse::io::path_t& out) const;
@@ -67,12 +67,14 @@ void EngravingElementsProvider::printStatistic(const std::string& title)
 
 void EngravingElementsProvider::reg(const mu::engraving::EngravingObject* e)
 {
+    std::lock_guard<std::mutex> lock(m_regMutex);
     m_elements.insert(e);
     m_statistics[e->typeName()].regCount++;
 }
 
 void EngravingElementsProvider::unreg(const mu::engraving::EngravingObject* e)
 {
+    std::lock_guard<std::mutex> lock(m_regMutex);
     m_elements.erase(e);
     m_statistics[e->typeName()].unregCount++;
 }
@@ -24,6 +24,7 @@
 
 #include <string>
 #include <map>
+#include <mutex>
 
 #include "iengravingelementsprovider.h"
 
@@ -63,6 +64,7 @@ private:
         int unregCount = 0;
     };
 
+    std::mutex m_regMutex; // the excerpts may be laid out concurrently
     std::map<std::string, ObjectStatistic> m_statistics;
 
     EngravingObjectSet m_elements;
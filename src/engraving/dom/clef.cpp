@@ -387,23 +387,23 @@ void Clef::changeClefToBarlinePos(ClefToBarlinePosition newPos)
             Measure* destMeas = endBarlineSeg->measure();
             meas->segments().remove(seg);
             destMeas->segments().insert(seg, endBarlineSeg);
-            seg->setRtick(endBarlineSeg->rtick());
             seg->setParent(destMeas);
+            seg->setRtick(endBarlineSeg->rtick());
         } else if (endRepeatSeg) {
             // Clef after the end repeat
             Measure* destMeas = endRepeatSeg->measure();
             meas->segments().remove(seg);
             destMeas->segments().insert(seg, endRepeatSeg->next());
-            seg->setRtick(endRepeatSeg->rtick());
             seg->setParent(destMeas);
+            seg->setRtick(endRepeatSeg->rtick());
         } else if (startRepeatSeg) {
             // End of previous measure
             Measure* destMeas = startRepeatSeg->measure()->prevMeasure();
             if (destMeas) {
                 meas->segments().remove(seg);
                 destMeas->segments().push_back(seg);
-                seg->setRtick(destMeas->ticks());
                 seg->setParent(destMeas);
+                seg->setRtick(destMeas->ticks());
             }
         }
     } else if (newPos == ClefToBarlinePosition::BEFORE) {
@@ -413,16 +413,16 @@ void Clef::changeClefToBarlinePos(ClefToBarlinePosition newPos)
             Measure* destMeas = refSeg->measure();
             meas->segments().remove(seg);
             destMeas->segments().insert(seg, refSeg);
-            seg->setRtick(refSeg->rtick());
             seg->setParent(destMeas);
+            seg->setRtick(refSeg->rtick());
         } else if (startRepeatSeg) {
             // End of previous measure
             Measure* destMeas = startRepeatSeg->measure()->prevMeasure();
             if (destMeas) {
                 meas->segments().remove(seg);
                 destMeas->segments().push_back(seg);
-                seg->setRtick(destMeas->ticks());
                 seg->setParent(destMeas);
+                seg->setRtick(destMeas->ticks());
             }
         }
     } else if (newPos == ClefToBarlinePosition::AFTER) {
@@ -432,15 +432,15 @@ void Clef::changeClefToBarlinePos(ClefToBarlinePosition newPos)
             Measure* destMeas = startRepeatSeg->measure();
             meas->segments().remove(seg);
             destMeas->segments().insert(seg, startRepeatSeg->next());
-            seg->setRtick(startRepeatSeg->rtick());
             seg->setParent(destMeas);
+            seg->setRtick(startRepeatSeg->rtick());
         } else if (isAtMeasureEnd) {
             Measure* destMeas = meas->nextMeasure();
             if (destMeas && !destMeas->header()) {
                 meas->segments().remove(seg);
                 destMeas->segments().push_front(seg);
-                seg->setRtick(Fraction(0, 1));
                 seg->setParent(destMeas);
+                seg->setRtick(Fraction(0, 1));
             } else if (destMeas) {
                 Segment* refSeg = destMeas->firstEnabled();
                 while (refSeg && refSeg->header()) {
@@ -449,8 +449,8 @@ void Clef::changeClefToBarlinePos(ClefToBarlinePosition newPos)
                 if (refSeg) {
                     meas->segments().remove(seg);
                     destMeas->segments().insert(seg, refSeg);
-                    seg->setRtick(refSeg->rtick());
                     seg->setParent(destMeas);
+                    seg->setRtick(refSeg->rtick());
                 }
             }
         }
@@ -194,7 +194,7 @@ void CmdState::reset()
     m_oneElement = true;
     m_mb = nullptr;
     m_oneMeasureBase = true;
-    m_locked = false;
+    m_lockCount = 0;
 }
 
 //---------------------------------------------------------
@@ -203,7 +203,7 @@ void CmdState::reset()
 
 void CmdState::setTick(const Fraction& t)
 {
-    if (m_locked) {
+    if (locked()) {
         return;
     }
 
@@ -222,7 +222,7 @@ void CmdState::setTick(const Fraction& t)
 
 void CmdState::setStaff(staff_idx_t st)
 {
-    if (m_locked || st == muse::nidx) {
+    if (locked() || st == muse::nidx) {
         return;
     }
 
@@ -240,7 +240,7 @@ void CmdState::setStaff(staff_idx_t st)
 
 void CmdState::setMeasureBase(const MeasureBase* mb)
 {
-    if (!mb || m_mb == mb || m_locked) {
+    if (!mb || m_mb == mb || locked()) {
         return;
     }
 
@@ -254,7 +254,7 @@ void CmdState::setMeasureBase(const MeasureBase* mb)
 
 void CmdState::setElement(const EngravingItem* e)
 {
-    if (!e || m_el == e || m_locked) {
+    if (!e || m_el == e || locked()) {
         return;
     }
 
@@ -419,8 +419,11 @@ void Score::endCmd(bool rollback, bool layoutAllParts)
     LOGD() << "Undo stack current macro child count: " << undoStack()->current()->childCount();
 
     const bool noUndo = undoStack()->current()->empty(); // nothing to undo?
+    undoStack()->setMemoryLimit(static_cast<size_t>(std::max(configuration()->undoHistoryMemoryLimitMb(), 0)) * 1024 * 1024);
     undoStack()->endMacro(noUndo);
 
+    LOGD() << "Undo history: " << undoStack()->macroCount() << " macros, " << undoStack()->memoryUsage() << " bytes";
+
     if (dirty()) {
         masterScore()->setPlaylistDirty(); // TODO: flag individual operations
     }
@@ -480,12 +483,14 @@ void Score::update(bool resetCmdState, bool layoutAllParts)
         ms->deletePostponed();
 
         if (cs.layoutRange()) {
+            std::vector<Score*> scores;
             for (Score* s : ms->scoreList()) {
                 if (s != this && !s->isOpen() && ms->scoreList().size() > 1 && !layoutAllParts) {
                     continue;
                 }
-                s->doLayoutRange(cs.startTick(), cs.endTick());
+                scores.push_back(s);
             }
+            ms->doLayoutScoresRange(scores, cs.startTick(), cs.endTick(), configuration()->isParallelPartsLayoutEnabled(), this);
             updateAll = true;
         }
     }
@@ -531,6 +536,16 @@ void Score::lockUpdates(bool locked)
     m_updatesLocked = locked;
 }
 
+//---------------------------------------------------------
+//   deleteLater
+//---------------------------------------------------------
+
+void Score::deleteLater(EngravingObject* e)
+{
+    std::lock_guard<std::mutex> lock(m_deleteLaterMutex);
+    m_updateState.deleteList.push_back(e);
+}
+
 //---------------------------------------------------------
 //   deletePostponed
 //---------------------------------------------------------
@@ -22,6 +22,7 @@
 #ifndef MU_ENGRAVING_CMD_H
 #define MU_ENGRAVING_CMD_H
 
+#include <atomic>
 #include <list>
 
 #include "../types/types.h"
@@ -74,8 +75,10 @@ public:
     staff_idx_t endStaff() const { return m_endStaff; }
     const EngravingItem* element() const;
 
-    void lock() { m_locked = true; }
-    void unlock() { m_locked = false; }
+    //! NOTE: Counted, the excerpts may be laid out concurrently (see MasterScore::doLayoutScoresRange)
+    void lock() { ++m_lockCount; }
+    void unlock() { --m_lockCount; }
+    bool locked() const { return m_lockCount > 0; }
 #ifndef NDEBUG
     void dump();
 #endif
@@ -93,7 +96,7 @@ private:
     bool m_oneElement = true;
     bool m_oneMeasureBase = true;
 
-    bool m_locked = false;
+    std::atomic<int> m_lockCount = 0;
 };
 }
 
@@ -0,0 +1,250 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "displaylist.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "engravingitem.h"
+
+using namespace mu::engraving;
+
+static constexpr size_t ITEMS_PER_CELL = 32;
+static constexpr size_t MAX_CELLS = 4096;
+
+//---------------------------------------------------------
+//   invalidate
+//---------------------------------------------------------
+
+void DisplayList::invalidate()
+{
+    m_valid = false;
+    m_lastValid = false;
+    m_entries.clear();
+    m_cells.clear();
+    m_visitMarks.clear();
+    m_lastPositions.clear();
+    m_lastItems.clear();
+}
+
+//---------------------------------------------------------
+//   build
+//---------------------------------------------------------
+
+void DisplayList::build(const RectF& rect, const std::vector<EngravingItem*>& items)
+{
+    m_rect = rect;
+
+    m_entries.clear();
+    m_entries.reserve(items.size());
+    for (EngravingItem* item : items) {
+        m_entries.push_back({ item, item->selected(), item->visible() });
+    }
+
+    sort();
+    m_valid = true;
+}
+
+//---------------------------------------------------------
+//   sort
+//    the paint order depends on selection and visibility,
+//    which can change without a relayout,
+//    so the entries remember the state they were sorted with
+//---------------------------------------------------------
+
+void DisplayList::sort()
+{
+    for (Entry& e : m_entries) {
+        e.selected = e.item->selected();
+        e.visible = e.item->visible();
+    }
+
+    std::stable_sort(m_entries.begin(), m_entries.end(), [](const Entry& e1, const Entry& e2) {
+        return elementLessThan(e1.item, e2.item);
+    });
+
+    buildCells();
+    m_lastValid = false;
+}
+
+//---------------------------------------------------------
+//   buildCells
+//---------------------------------------------------------
+
+void DisplayList::buildCells()
+{
+    const size_t cellCount = std::clamp(m_entries.size() / ITEMS_PER_CELL, size_t(1), MAX_CELLS);
+    const double w = m_rect.width();
+    const double h = m_rect.height();
+
+    if (w > 0.0 && h > 0.0) {
+        // keep the cells roughly square, a continuous view page is very wide
+        long cols = std::lround(std::sqrt(static_cast<double>(cellCount) * w / h));
+        m_cols = static_cast<int>(std::clamp(cols, 1L, static_cast<long>(cellCount)));
+        m_rows = std::max(1, static_cast<int>(cellCount) / m_cols);
+    } else {
+        m_cols = 1;
+        m_rows = 1;
+    }
+
+    m_cellWidth = w / m_cols;
+    m_cellHeight = h / m_rows;
+
+    m_cells.assign(static_cast<size_t>(m_cols) * m_rows, {});
+    for (size_t pos = 0; pos < m_entries.size(); ++pos) {
+        int col1, row1, col2, row2;
+        cellRange(m_entries[pos].item->pageBoundingRect(), col1, row1, col2, row2);
+        for (int row = row1; row <= row2; ++row) {
+            for (int col = col1; col <= col2; ++col) {
+                m_cells[static_cast<size_t>(row) * m_cols + col].push_back(static_cast<uint32_t>(pos));
+            }
+        }
+    }
+
+    m_visitMarks.assign(m_entries.size(), 0);
+    m_visitMark = 0;
+}
+
+//---------------------------------------------------------
+//   cellRange
+//---------------------------------------------------------
+
+void DisplayList::cellRange(const RectF& rect, int& col1, int& row1, int& col2, int& row2) const
+{
+    auto toCell = [](double v, double origin, double cellSize, int count) {
+        if (cellSize <= 0.0) {
+            return 0;
+        }
+        double idx = std::floor((v - origin) / cellSize);
+        return static_cast<int>(std::clamp(idx, 0.0, static_cast<double>(count - 1)));
+    };
+
+    col1 = toCell(rect.left(), m_rect.left(), m_cellWidth, m_cols);
+    col2 = toCell(rect.right(), m_rect.left(), m_cellWidth, m_cols);
+    row1 = toCell(rect.top(), m_rect.top(), m_cellHeight, m_rows);
+    row2 = toCell(rect.bottom(), m_rect.top(), m_cellHeight, m_rows);
+}
+
+//---------------------------------------------------------
+//   isOrderActual
+//---------------------------------------------------------
+
+bool DisplayList::isOrderActual(size_t pos) const
+{
+    const Entry& e = m_entries[pos];
+    return e.selected == e.item->selected() && e.visible == e.item->visible();
+}
+
+//---------------------------------------------------------
+//   collect
+//    returns false if the order of the found items is outdated
+//---------------------------------------------------------
+
+bool DisplayList::collect(const RectF& rect)
+{
+    m_lastPositions.clear();
+    m_lastItems.clear();
+
+    if (m_entries.empty()) {
+        return true;
+    }
+
+    int col1, row1, col2, row2;
+    cellRange(rect, col1, row1, col2, row2);
+
+    if (col1 == 0 && row1 == 0 && col2 == m_cols - 1 && row2 == m_rows - 1) {
+        // whole page, everything is already in order
+        m_lastPositions.resize(m_entries.size());
+        for (size_t pos = 0; pos < m_entries.size(); ++pos) {
+            m_lastPositions[pos] = static_cast<uint32_t>(pos);
+        }
+    } else if (col1 == col2 && row1 == row2) {
+        m_lastPositions = m_cells[static_cast<size_t>(row1) * m_cols + col1];
+    } else {
+        if (++m_visitMark == 0) {
+            std::fill(m_visitMarks.begin(), m_visitMarks.end(), 0);
+            m_visitMark = 1;
+        }
+
+        for (int row = row1; row <= row2; ++row) {
+            for (int col = col1; col <= col2; ++col) {
+                for (uint32_t pos : m_cells[static_cast<size_t>(row) * m_cols + col]) {
+                    if (m_visitMarks[pos] != m_visitMark) {
+                        m_visitMarks[pos] = m_visitMark;
+                        m_lastPositions.push_back(pos);
+                    }
+                }
+            }
+        }
+
+        // positions are the paint order, so there is no need to compare items
+        std::sort(m_lastPositions.begin(), m_lastPositions.end());
+    }
+
+    size_t count = 0;
+    for (uint32_t pos : m_lastPositions) {
+        if (!isOrderActual(pos)) {
+            return false;
+        }
+
+        EngravingItem* item = m_entries[pos].item;
+        if (!item->pageBoundingRect().intersects(rect)) {
+            continue;
+        }
+
+        m_lastPositions[count++] = pos;
+        m_lastItems.push_back(item);
+    }
+    m_lastPositions.resize(count);
+
+    return true;
+}
+
+//---------------------------------------------------------
+//   items
+//---------------------------------------------------------
+
+const std::vector<EngravingItem*>& DisplayList::items(const RectF& rect)
+{
+    if (m_lastValid && rect == m_lastRect) {
+        bool actual = std::all_of(m_lastPositions.begin(), m_lastPositions.end(), [this](uint32_t pos) {
+            return isOrderActual(pos);
+        });
+
+        if (actual) {
+            return m_lastItems;
+        }
+
+        sort();
+    }
+
+    if (!collect(rect)) {
+        sort();
+        collect(rect);
+    }
+
+    m_lastRect = rect;
+    m_lastValid = true;
+
+    return m_lastItems;
+}
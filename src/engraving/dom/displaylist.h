@@ -0,0 +1,89 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_ENGRAVING_DISPLAYLIST_H
+#define MU_ENGRAVING_DISPLAYLIST_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../types/types.h"
+
+namespace mu::engraving {
+class EngravingItem;
+
+//---------------------------------------------------------
+//   DisplayList
+//    items of a page retained in paint order (see elementLessThan)
+//    and bucketed into a coarse grid, so that repainting
+//    a region doesn't need to query the bsp tree and sort again
+//---------------------------------------------------------
+
+class DisplayList
+{
+public:
+    DisplayList() = default;
+
+    bool isValid() const { return m_valid; }
+    void invalidate();
+
+    void build(const RectF& rect, const std::vector<EngravingItem*>& items);
+
+    //! NOTE Returns items intersecting the rect, in paint order.
+    //! The result stays valid until the next call or invalidation
+    const std::vector<EngravingItem*>& items(const RectF& rect);
+
+private:
+    struct Entry {
+        EngravingItem* item = nullptr;
+        bool selected = false;
+        bool visible = false;
+    };
+
+    void sort();
+    void buildCells();
+    bool collect(const RectF& rect);
+    bool isOrderActual(size_t pos) const;
+    void cellRange(const RectF& rect, int& col1, int& row1, int& col2, int& row2) const;
+
+    bool m_valid = false;
+
+    RectF m_rect;
+    std::vector<Entry> m_entries; // in paint order
+
+    // each cell keeps positions of the entries it overlaps, ascending
+    int m_cols = 1;
+    int m_rows = 1;
+    double m_cellWidth = 0.0;
+    double m_cellHeight = 0.0;
+    std::vector<std::vector<uint32_t> > m_cells;
+    std::vector<uint32_t> m_visitMarks;
+    uint32_t m_visitMark = 0;
+
+    RectF m_lastRect;
+    bool m_lastValid = false;
+    std::vector<uint32_t> m_lastPositions;
+    std::vector<EngravingItem*> m_lastItems;
+};
+}
+
+#endif // MU_ENGRAVING_DISPLAYLIST_H
@@ -78,6 +78,8 @@ set(DOM_SRC
     ${CMAKE_CURRENT_LIST_DIR}/connector.h
     ${CMAKE_CURRENT_LIST_DIR}/deadslapped.cpp
     ${CMAKE_CURRENT_LIST_DIR}/deadslapped.h
+    ${CMAKE_CURRENT_LIST_DIR}/displaylist.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/displaylist.h
     ${CMAKE_CURRENT_LIST_DIR}/drumset.cpp
     ${CMAKE_CURRENT_LIST_DIR}/drumset.h
     ${CMAKE_CURRENT_LIST_DIR}/durationelement.cpp
@@ -419,6 +419,24 @@ static void changeProperty(EngravingObject* e, Pid t, const PropertyValue& st, P
 //   changeProperties
 //---------------------------------------------------------
 
+static void propagateProperty(EngravingItem* item, EngravingItem* linkedItem, Pid propertyId, const PropertyValue& propertyValue,
+                              PropertyFlags propertyFlag)
+{
+    PropertyPropagation propertyPropagate = item->propertyPropagation(linkedItem, propertyId);
+    switch (propertyPropagate) {
+    case PropertyPropagation::NONE:
+        break;
+    case PropertyPropagation::PROPAGATE:
+        changeProperty(linkedItem, propertyId, propertyValue, propertyFlag);
+        break;
+    case PropertyPropagation::UNLINK:
+        item->unlinkPropertyFromMaster(propertyId);
+        break;
+    default:
+        break;
+    }
+}
+
 static void changeProperties(EngravingObject* object, Pid propertyId, const PropertyValue& propertyValue, PropertyFlags propertyFlag)
 {
     const std::list<EngravingObject*> linkList = object->linkListForPropertyPropagation();
@@ -434,19 +452,17 @@ static void changeProperties(EngravingObject* object, Pid propertyId, const Prop
 
         EngravingItem* item = toEngravingItem(object);
         EngravingItem* linkedItem = toEngravingItem(linkedObject);
-        PropertyPropagation propertyPropagate = item->propertyPropagation(linkedItem, propertyId);
-        switch (propertyPropagate) {
-        case PropertyPropagation::NONE:
-            break;
-        case PropertyPropagation::PROPAGATE:
-            changeProperty(linkedObject, propertyId, propertyValue, propertyFlag);
-            break;
-        case PropertyPropagation::UNLINK:
-            item->unlinkPropertyFromMaster(propertyId);
-            break;
-        default:
-            break;
+
+        //! NOTE: The score of the linked item may be laid out concurrently
+        CrossScoreChanges* changes = CrossScoreChanges::current();
+        if (changes && linkedItem->score() != changes->score()) {
+            changes->defer(linkedItem->score(), [item, linkedItem, propertyId, propertyValue, propertyFlag]() {
+                propagateProperty(item, linkedItem, propertyId, propertyValue, propertyFlag);
+            });
+            continue;
         }
+
+        propagateProperty(item, linkedItem, propertyId, propertyValue, propertyFlag);
     }
 }
 
@@ -21,7 +21,13 @@
  */
 #include "masterscore.h"
 
+#include <future>
+#include <memory>
+#include <set>
+
 #include "io/buffer.h"
+#include "concurrency/taskscheduler.h"
+#include "containers.h"
 
 #include "compat/writescorehook.h"
 
@@ -372,6 +378,98 @@ void MasterScore::setLayout(const Fraction& tick1, const Fraction& tick2, staff_
     }
 }
 
+//---------------------------------------------------------
+//   doLayoutScoresRange
+//---------------------------------------------------------
+
+static muse::TaskScheduler* layoutScheduler()
+{
+    //! NOTE: Not the shared instance, the audio engine uses that one
+    static muse::TaskScheduler scheduler;
+    return &scheduler;
+}
+
+void MasterScore::doLayoutScoresRange(const std::vector<Score*>& scores, const Fraction& st, const Fraction& et, bool concurrently,
+                                      Score* currentScore)
+{
+    size_t excerptCount = 0;
+    for (const Score* s : scores) {
+        if (s != this) {
+            ++excerptCount;
+        }
+    }
+
+    if (!concurrently || excerptCount < 2) {
+        for (Score* s : scores) {
+            s->doLayoutRange(st, et);
+        }
+        return;
+    }
+
+    TRACEFUNC;
+
+    //! NOTE: The excerpts may depend on the layout of the linked elements of the master score
+    if (muse::contains(scores, static_cast<Score*>(this))) {
+        doLayoutRange(st, et);
+    }
+
+    //! NOTE: The layout range must not be changed until all the excerpts are laid out
+    m_cmdState.lock();
+
+    //! NOTE: An excerpt must not change the other scores while they are laid out,
+    //! these changes are queued and replayed below in the order of the scores
+    std::vector<Score*> excerpts;
+    std::vector<std::unique_ptr<CrossScoreChanges> > changes;
+    for (Score* s : scores) {
+        if (s != this) {
+            excerpts.push_back(s);
+            changes.push_back(std::make_unique<CrossScoreChanges>(s));
+        }
+    }
+
+    auto layoutExcerpt = [&excerpts, &changes, st, et](size_t idx) {
+        CrossScoreChanges::Scope scope(changes[idx].get());
+        excerpts[idx]->doLayoutRange(st, et);
+    };
+
+    std::vector<std::future<void> > results;
+    size_t currentIdx = muse::nidx;
+    for (size_t i = 0; i < excerpts.size(); ++i) {
+        if (excerpts[i] == currentScore) {
+            currentIdx = i;
+            continue;
+        }
+
+        results.push_back(layoutScheduler()->submit([&layoutExcerpt, i]() {
+            layoutExcerpt(i);
+        }));
+    }
+
+    if (currentIdx != muse::nidx) {
+        layoutExcerpt(currentIdx);
+    }
+
+    for (std::future<void>& result : results) {
+        result.wait();
+    }
+
+    //! NOTE: Laid out one after another, an excerpt would have seen the changes made by the ones before it
+    std::set<Score*> changedScores;
+    for (size_t i = 0; i < excerpts.size(); ++i) {
+        changes[i]->replay(undoStack());
+
+        if (muse::contains(changedScores, excerpts[i])) {
+            excerpts[i]->doLayoutRange(st, et);
+        }
+
+        for (Score* s : changes[i]->changedScores()) {
+            changedScores.insert(s);
+        }
+    }
+
+    m_cmdState.unlock();
+}
+
 //---------------------------------------------------------
 //   setPlaybackScore
 //---------------------------------------------------------
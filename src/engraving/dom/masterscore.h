@@ -126,6 +126,13 @@ public:
     void setLayout(const Fraction& tick, staff_idx_t staff, const EngravingItem* e = nullptr);
     void setLayout(const Fraction& tick1, const Fraction& tick2, staff_idx_t staff1, staff_idx_t staff2, const EngravingItem* e = nullptr);
 
+    //! NOTE: Lays out the given scores of this master score, the master score itself goes first.
+    //! If concurrently, the excerpts are then laid out on a thread pool
+    //! while the current one is laid out on the calling thread.
+    //! Their changes of the other scores are applied afterwards (see CrossScoreChanges)
+    void doLayoutScoresRange(const std::vector<Score*>& scores, const Fraction& st, const Fraction& et, bool concurrently,
+                             Score* currentScore = nullptr);
+
     CmdState& cmdState() override { return m_cmdState; }
     const CmdState& cmdState() const override { return m_cmdState; }
     void addLayoutFlags(LayoutFlags val) override { m_cmdState.layoutFlags |= val; }
@@ -611,15 +611,10 @@ Chord* Measure::findChord(Fraction t, track_idx_t track)
 ChordRest* Measure::findChordRest(Fraction t, track_idx_t track)
 {
     t -= tick();
-    for (const Segment& seg : m_segments) {
-        if (seg.rtick() > t) {
-            return 0;
-        }
-        if (seg.rtick() == t) {
-            EngravingItem* el = seg.element(track);
-            if (el && el->isChordRest()) {
-                return toChordRest(el);
-            }
+    for (Segment* seg = m_segments.lowerBound(t); seg && seg->rtick() == t; seg = seg->next()) {
+        EngravingItem* el = seg->element(track);
+        if (el && el->isChordRest()) {
+            return toChordRest(el);
         }
     }
     return 0;
@@ -631,18 +626,7 @@ ChordRest* Measure::findChordRest(Fraction t, track_idx_t track)
 
 Segment* Measure::tick2segment(const Fraction& _t, SegmentType st)
 {
-    Fraction t = _t - tick();
-    for (Segment& s : m_segments) {
-        if (s.rtick() == t) {
-            if (s.segmentType() & st) {
-                return &s;
-            }
-        }
-        if (s.rtick() > t) {
-            break;
-        }
-    }
-    return 0;
+    return m_segments.find(st, _t - tick());
 }
 
 //---------------------------------------------------------
@@ -653,25 +637,7 @@ Segment* Measure::tick2segment(const Fraction& _t, SegmentType st)
 
 Segment* Measure::findSegmentR(SegmentType st, const Fraction& t) const
 {
-    Segment* s;
-    if (t > (ticks() * Fraction(1, 2))) {
-        // search backwards
-        for (s = last(); s && s->rtick() > t; s = s->prev()) {
-        }
-        while (s && s->prev() && s->prev()->rtick() == t) {
-            s = s->prev();
-        }
-    } else {
-        // search forwards
-        for (s = first(); s && s->rtick() < t; s = s->next()) {
-        }
-    }
-    for (; s && s->rtick() == t; s = s->next()) {
-        if (s->segmentType() & st) {
-            return s;
-        }
-    }
-    return 0;
+    return m_segments.find(st, t);
 }
 
 //---------------------------------------------------------
@@ -757,10 +723,8 @@ void Measure::add(EngravingItem* e)
     {
         Segment* seg   = toSegment(e);
         Fraction t     = seg->rtick();
-        Segment* s;
+        Segment* s     = m_segments.lowerBound(t);
 
-        for (s = first(); s && s->rtick() < t; s = s->next()) {
-        }
         while (s && s->rtick() == t) {
             if (!seg->isChordRestType() && (seg->segmentType() == s->segmentType())) {
                 LOGD("there is already a <%s> segment", seg->subTypeName());
@@ -834,7 +798,7 @@ void Measure::add(EngravingItem* e)
         break;
 
     case ElementType::MEASURE:
-        m_mmRest = toMeasure(e);
+        setMMRest(toMeasure(e));
         break;
 
     case ElementType::STAFFTYPE_CHANGE:
@@ -953,7 +917,7 @@ void Measure::remove(EngravingItem* e)
         break;
 
     case ElementType::MEASURE:
-        m_mmRest = 0;
+        setMMRest(nullptr);
         break;
 
     case ElementType::STAFFTYPE_CHANGE:
@@ -2725,7 +2689,7 @@ bool Measure::setProperty(Pid propertyId, const PropertyValue& value)
         m_timesig = value.value<Fraction>();
         break;
     case Pid::TIMESIG_ACTUAL:
-        m_len = value.value<Fraction>();
+        setTicks(value.value<Fraction>());
         break;
     case Pid::MEASURE_NUMBER_MODE:
         setMeasureNumberMode(MeasureNumberMode(value.toInt()));
@@ -2828,6 +2792,18 @@ Measure* Measure::mmRestLast() const
     return score()->lastMeasure();
 }
 
+//---------------------------------------------------------
+//   setMMRest
+//---------------------------------------------------------
+
+void Measure::setMMRest(Measure* m)
+{
+    if (m_mmRest != m) {
+        m_mmRest = m;
+        ticksChanged();
+    }
+}
+
 //---------------------------------------------------------
 //   coveringMMRestOrThis
 //    if multi-measure rests are enabled,
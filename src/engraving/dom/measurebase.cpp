@@ -22,6 +22,8 @@
 
 #include "measurebase.h"
 
+#include <algorithm>
+
 #include "factory.h"
 #include "layoutbreak.h"
 #include "measure.h"
@@ -342,7 +344,53 @@ Fraction MeasureBase::tick() const
 
 void MeasureBase::setTick(const Fraction& f)
 {
-    m_tick = f;
+    if (m_tick != f) {
+        m_tick = f;
+        ticksChanged();
+    }
+}
+
+void MeasureBase::setTicks(const Fraction& f)
+{
+    if (m_len != f) {
+        m_len = f;
+        ticksChanged();
+    }
+}
+
+//---------------------------------------------------------
+//   ticksChanged
+//---------------------------------------------------------
+
+void MeasureBase::ticksChanged()
+{
+    if (Score* s = score()) {
+        s->measures()->ticksChanged();
+    }
+}
+
+//---------------------------------------------------------
+//   setNext
+//---------------------------------------------------------
+
+void MeasureBase::setNext(MeasureBase* e)
+{
+    if (m_next != e) {
+        m_next = e;
+        ticksChanged();
+    }
+}
+
+//---------------------------------------------------------
+//   setPrev
+//---------------------------------------------------------
+
+void MeasureBase::setPrev(MeasureBase* e)
+{
+    if (m_prev != e) {
+        m_prev = e;
+        ticksChanged();
+    }
 }
 
 //---------------------------------------------------------
@@ -727,6 +775,7 @@ void MeasureBaseList::push_front(MeasureBase* e)
 
 void MeasureBaseList::add(MeasureBase* e)
 {
+    ticksChanged();
     MeasureBase* el = e->next();
     if (el == 0) {
         push_back(e);
@@ -748,6 +797,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
 {
+    ticksChanged();
     --m_size;
     if (el->prev()) {
         el->prev()->setNext(el->next());
@@ -767,6 +817,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 {
+    ticksChanged();
     ++m_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         ++m_size;
@@ -791,6 +842,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 {
+    ticksChanged();
     --m_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         --m_size;
@@ -815,6 +867,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
 {
+    ticksChanged();
     nb->setPrev(ob->prev());
     nb->setNext(ob->next());
     if (ob->prev()) {
@@ -837,3 +890,173 @@ void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
         e->setParent(nb);
     }
 }
+
+//---------------------------------------------------------
+//   TickIndex
+//---------------------------------------------------------
+
+void MeasureBaseList::TickIndex::reset()
+{
+    sorted = true;
+    items.clear();
+    ticks.clear();
+    endTicks.clear();
+}
+
+Measure* MeasureBaseList::TickIndex::findMeasure(const Fraction& tick) const
+{
+    if (items.empty()) {
+        return nullptr;
+    }
+
+    size_t idx = 0;
+    if (sorted) {
+        idx = std::upper_bound(ticks.cbegin(), ticks.cend(), tick) - ticks.cbegin();
+    } else {
+        while (idx < ticks.size() && !(tick < ticks[idx])) {
+            ++idx;
+        }
+    }
+
+    if (idx == 0) {
+        return nullptr;
+    }
+
+    // check last measure
+    if (idx == items.size() && tick > endTicks.back()) {
+        return nullptr;
+    }
+
+    return toMeasure(items[idx - 1]);
+}
+
+MeasureBase* MeasureBaseList::TickIndex::findMeasureBase(const Fraction& tick) const
+{
+    if (!sorted) {
+        for (size_t idx = 0; idx < items.size(); ++idx) {
+            if (tick >= ticks[idx] && tick < endTicks[idx]) {
+                return items[idx];
+            }
+        }
+        return nullptr;
+    }
+
+    size_t idx = std::upper_bound(ticks.cbegin(), ticks.cend(), tick) - ticks.cbegin();
+    if (idx == 0 || !(tick < endTicks[idx - 1])) {
+        return nullptr;
+    }
+
+    return items[idx - 1];
+}
+
+//---------------------------------------------------------
+//   actualIndex
+//    rebuilds the index if the list has changed since it was built.
+//    Concurrent readers of an actual index don't lock,
+//    the revision is published after the index is built
+//---------------------------------------------------------
+
+template<typename Build>
+const MeasureBaseList::TickIndex& MeasureBaseList::actualIndex(TickIndex& index, Build build) const
+{
+    uint64_t revision = m_ticksRevision.load(std::memory_order_relaxed);
+    if (index.revision.load(std::memory_order_acquire) == revision) {
+        return index;
+    }
+
+    std::lock_guard<std::mutex> lock(m_tickIndexMutex);
+    if (index.revision.load(std::memory_order_relaxed) != revision) {
+        index.reset();
+        build(index);
+        index.revision.store(revision, std::memory_order_release);
+    }
+
+    return index;
+}
+
+//---------------------------------------------------------
+//   measureBaseAt
+//---------------------------------------------------------
+
+MeasureBase* MeasureBaseList::measureBaseAt(const Fraction& tick) const
+{
+    const TickIndex& index = actualIndex(m_measureBaseIndex, [this](TickIndex& newIndex) {
+        for (MeasureBase* mb = m_first; mb; mb = mb->next()) {
+            Fraction st = mb->tick();
+            Fraction et = st + mb->ticks();
+            if (!(st < et)) {
+                continue; // empty measure bases (frames) never contain a tick
+            }
+
+            //! NOTE: the binary search needs the measure bases not to overlap
+            if (!newIndex.endTicks.empty() && st < newIndex.endTicks.back()) {
+                newIndex.sorted = false;
+            }
+
+            newIndex.items.push_back(mb);
+            newIndex.ticks.push_back(st);
+            newIndex.endTicks.push_back(et);
+        }
+    });
+
+    return index.findMeasureBase(tick);
+}
+
+//---------------------------------------------------------
+//   measureAt
+//---------------------------------------------------------
+
+Measure* MeasureBaseList::measureAt(const Fraction& tick) const
+{
+    const TickIndex& index = actualIndex(m_measureIndex, [this](TickIndex& newIndex) {
+        for (MeasureBase* mb = m_first; mb; mb = mb->next()) {
+            if (!mb->isMeasure()) {
+                continue;
+            }
+
+            Fraction st = mb->tick();
+            if (!newIndex.ticks.empty() && st < newIndex.ticks.back()) {
+                newIndex.sorted = false;
+            }
+
+            newIndex.items.push_back(mb);
+            newIndex.ticks.push_back(st);
+            newIndex.endTicks.push_back(mb->endTick());
+        }
+    });
+
+    return index.findMeasure(tick);
+}
+
+//---------------------------------------------------------
+//   measureMMAt
+//---------------------------------------------------------
+
+Measure* MeasureBaseList::measureMMAt(const Fraction& tick, bool createMultiMeasureRests) const
+{
+    TickIndex& mmIndex = m_measureMMIndex[createMultiMeasureRests ? 1 : 0];
+    const TickIndex& index = actualIndex(mmIndex, [this, createMultiMeasureRests](TickIndex& newIndex) {
+        MeasureBase* mb = m_first;
+        while (mb && !mb->isMeasure()) {
+            mb = mb->next();
+        }
+
+        Measure* m = toMeasure(mb);
+        if (m && createMultiMeasureRests && m->hasMMRest()) {
+            m = m->mmRest();
+        }
+
+        for (; m; m = m->nextMeasureMM()) {
+            Fraction st = m->tick();
+            if (!newIndex.ticks.empty() && st < newIndex.ticks.back()) {
+                newIndex.sorted = false;
+            }
+
+            newIndex.items.push_back(m);
+            newIndex.ticks.push_back(st);
+            newIndex.endTicks.push_back(m->endTick());
+        }
+    });
+
+    return index.findMeasure(tick);
+}
@@ -28,6 +28,10 @@
  Definition of MeasureBase class.
 */
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include "engravingitem.h"
 
 namespace mu::engraving {
@@ -90,10 +94,10 @@ public:
 
     MeasureBase* next() const { return m_next; }
     MeasureBase* nextMM() const;
-    void setNext(MeasureBase* e) { m_next = e; }
+    void setNext(MeasureBase* e);
     MeasureBase* prev() const { return m_prev; }
     MeasureBase* prevMM() const;
-    void setPrev(MeasureBase* e) { m_prev = e; }
+    void setPrev(MeasureBase* e);
     MeasureBase* top() const;
 
     MeasureBase* getInScore(Score* score, bool useNextMeasureFallback = false) const;
@@ -126,7 +130,7 @@ public:
     void setTick(const Fraction& f);
 
     Fraction ticks() const { return m_len; }
-    void setTicks(const Fraction& f) { m_len = f; }
+    void setTicks(const Fraction& f);
 
     Fraction endTick() const { return m_tick + m_len; }
 
@@ -181,6 +185,10 @@ public:
     void setOldWidth(double n) { m_oldWidth = n; }
     double oldWidth() const { return m_oldWidth; }
 
+    //! NOTE: Called whenever the measure is linked, unlinked, moved or resized,
+    //! invalidates the tick index of the measure list of its score
+    void ticksChanged();
+
 protected:
 
     MeasureBase(const ElementType& type, System* system = 0);
@@ -210,7 +218,7 @@ public:
     MeasureBaseList();
     MeasureBase* first() const { return m_first; }
     MeasureBase* last()  const { return m_last; }
-    void clear() { m_first = m_last = 0; m_size = 0; }
+    void clear() { m_first = m_last = 0; m_size = 0; ticksChanged(); }
     void add(MeasureBase*);
     void remove(MeasureBase*);
     void insert(MeasureBase*, MeasureBase*);
@@ -219,13 +227,48 @@ public:
     int size() const { return m_size; }
     bool empty() const { return m_size == 0; }
 
+    //! NOTE: Binary searches over a snapshot of the measure ticks, rebuilt lazily after the measures change.
+    //! The results are the same as the ones of walking the list:
+    //! measureBaseAt - the first measure base with tick <= t < endTick
+    //! measureAt - the last measure with tick <= t, the last measure is only returned if t <= its endTick
+    //! measureMMAt - the same as measureAt over the measures and mm rests as seen by nextMeasureMM()
+    MeasureBase* measureBaseAt(const Fraction& tick) const;
+    Measure* measureAt(const Fraction& tick) const;
+    Measure* measureMMAt(const Fraction& tick, bool createMultiMeasureRests) const;
+
+    //! NOTE: Invalidates the tick index, it's rebuilt on the next lookup
+    void ticksChanged() { m_ticksRevision.fetch_add(1, std::memory_order_relaxed); }
+
 private:
     void push_back(MeasureBase* e);
     void push_front(MeasureBase* e);
 
+    struct TickIndex {
+        std::atomic<uint64_t> revision = 0; // the revision of the list it was built for, 0 - never built
+        bool sorted = true; // false while the ticks are being fixed, then the lookups fall back to a linear search
+        std::vector<MeasureBase*> items;
+        std::vector<Fraction> ticks;
+        std::vector<Fraction> endTicks;
+
+        void reset();
+        Measure* findMeasure(const Fraction& tick) const;
+        MeasureBase* findMeasureBase(const Fraction& tick) const;
+    };
+
+    template<typename Build>
+    const TickIndex& actualIndex(TickIndex& index, Build build) const;
+
     int m_size = 0;
     MeasureBase* m_first = nullptr;
     MeasureBase* m_last = nullptr;
+
+    std::atomic<uint64_t> m_ticksRevision = 1;
+
+    //! NOTE: Only taken to rebuild an index, the lookups of an actual index don't lock
+    mutable std::mutex m_tickIndexMutex;
+    mutable TickIndex m_measureBaseIndex;
+    mutable TickIndex m_measureIndex;
+    mutable TickIndex m_measureMMIndex[2]; // by createMultiMeasureRests
 };
 } // namespace mu::engraving
 #endif
@@ -74,6 +74,28 @@ std::vector<EngravingItem*> Page::items(const PointF& point)
     return bspTree.items(point);
 }
 
+//---------------------------------------------------------
+//   paintItems
+//---------------------------------------------------------
+
+const std::vector<EngravingItem*>& Page::paintItems(const RectF& rect)
+{
+    if (!m_displayList.isValid()) {
+        doRebuildDisplayList();
+    }
+    return m_displayList.items(rect);
+}
+
+//---------------------------------------------------------
+//   invalidateBspTree
+//---------------------------------------------------------
+
+void Page::invalidateBspTree()
+{
+    m_bspTreeValid = false;
+    m_displayList.invalidate();
+}
+
 //---------------------------------------------------------
 //   appendSystem
 //---------------------------------------------------------
@@ -272,6 +294,29 @@ void Page::doRebuildBspTree()
     int n = 0;
     scanElements(&n, countElements, false);
 
+    bspTree.initialize(spatialIndexRect(), n);
+    scanElements(&bspTree, &bspInsert, false);
+    m_bspTreeValid = true;
+}
+
+//---------------------------------------------------------
+//   doRebuildDisplayList
+//---------------------------------------------------------
+
+void Page::doRebuildDisplayList()
+{
+    std::vector<EngravingItem*> el;
+    scanElements(&el, collectElements, false);
+
+    m_displayList.build(spatialIndexRect(), el);
+}
+
+//---------------------------------------------------------
+//   spatialIndexRect
+//---------------------------------------------------------
+
+RectF Page::spatialIndexRect() const
+{
     RectF r;
     if (score()->linearMode()) {
         double w = 0.0;
@@ -288,9 +333,7 @@ void Page::doRebuildBspTree()
         r = abbox();
     }
 
-    bspTree.initialize(r, n);
-    scanElements(&bspTree, &bspInsert, false);
-    m_bspTreeValid = true;
+    return r;
 }
 
 //---------------------------------------------------------
@@ -27,6 +27,7 @@
 
 #include "engravingitem.h"
 #include "bsp.h"
+#include "displaylist.h"
 
 namespace mu::engraving {
 class RootItem;
@@ -75,7 +76,8 @@ public:
 
     std::vector<EngravingItem*> items(const RectF& r);
     std::vector<EngravingItem*> items(const PointF& p);
-    void invalidateBspTree() { m_bspTreeValid = false; }
+    const std::vector<EngravingItem*>& paintItems(const RectF& r);  ///< items in paint order
+    void invalidateBspTree();
     PointF pagePos() const override { return PointF(); }       ///< position in page coordinates
     std::vector<EngravingItem*> elements() const;              ///< list of visible elements
     RectF tbbox() const;                             // tight bounding box, excluding white space
@@ -93,6 +95,8 @@ private:
     Page(RootItem* parent);
 
     void doRebuildBspTree();
+    void doRebuildDisplayList();
+    RectF spatialIndexRect() const;
     String replaceTextMacros(const String&) const;
 
     std::vector<System*> m_systems;
@@ -100,6 +104,8 @@ private:
 
     BspTree bspTree;
     bool m_bspTreeValid = false;
+
+    DisplayList m_displayList;
 };
 } // namespace mu::engraving
 #endif
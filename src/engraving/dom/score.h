@@ -28,8 +28,10 @@
  Definition of Score class.
 */
 
+#include <atomic>
 #include <set>
 #include <memory>
+#include <mutex>
 #include <optional>
 
 #include "global/async/channel.h"
@@ -551,7 +553,7 @@ public:
     bool selectionEmpty() const { return m_selection.staffStart() == m_selection.staffEnd(); }
     bool selectionChanged() const { return m_updateState.selectionChanged; }
     void setSelectionChanged(bool val) { m_updateState.selectionChanged = val; }
-    void deleteLater(EngravingObject* e) { m_updateState.deleteList.push_back(e); }
+    void deleteLater(EngravingObject* e);
     void deletePostponed();
 
     void changeSelectedNotesVoice(voice_idx_t);
@@ -1069,7 +1071,7 @@ private:
 
     void updateStavesNumberForSystems();
 
-    int m_linkId = 0;
+    std::atomic<int> m_linkId = 0;
     MasterScore* m_masterScore = nullptr;
     std::list<MuseScoreView*> m_viewer;
     Excerpt* m_excerpt = nullptr;
@@ -1085,6 +1087,7 @@ private:
     int m_pageNumberOffset = 0;          // Offset for page numbers.
 
     UpdateState m_updateState;
+    std::mutex m_deleteLaterMutex;         // the excerpts may be laid out concurrently
 
     MeasureBaseList m_measures;            // here are the notes
     std::vector<Part*> m_parts;
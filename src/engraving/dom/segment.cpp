@@ -191,6 +191,28 @@ void Segment::setParent(Measure* parent)
     EngravingItem::setParent(parent);
 }
 
+//---------------------------------------------------------
+//   setRtick
+//---------------------------------------------------------
+
+void Segment::setRtick(const Fraction& v)
+{
+    assert(v >= Fraction(0, 1));
+    if (m_tick == v) {
+        return;
+    }
+
+    // the measure looks its segments up by tick
+    SegmentList* segments = explicitParent() && explicitParent()->isMeasure() ? &toMeasure(explicitParent())->segments() : nullptr;
+    const size_t idx = segments ? segments->tickChanging(this) : 0;
+
+    m_tick = v;
+
+    if (segments) {
+        segments->tickChanged(idx);
+    }
+}
+
 //---------------------------------------------------------
 //   setSegmentType
 //---------------------------------------------------------
@@ -186,7 +186,7 @@ public:
     double computeDurationStretch(const Segment* prevSeg, Fraction minTicks, Fraction maxTicks);
 
     Fraction rtick() const override { return m_tick; }
-    void setRtick(const Fraction& v) { assert(v >= Fraction(0, 1)); m_tick = v; }
+    void setRtick(const Fraction& v);
     Fraction tick() const override;
 
     Fraction ticks() const { return m_ticks; }
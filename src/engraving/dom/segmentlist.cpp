@@ -21,6 +21,9 @@
  */
 
 #include "segmentlist.h"
+
+#include <algorithm>
+
 #include "segment.h"
 #include "score.h"
 
@@ -118,6 +121,16 @@ void SegmentList::check()
         ASSERT_X(String(u"SegmentList::check: counted %1 but _size is %d2").arg(n, m_size));
         m_size = n;
     }
+    size_t idx = 0;
+    for (Segment* s = m_first; s; s = s->next(), ++idx) {
+        if (idx >= m_index.size() || m_index[idx] != s) {
+            ASSERT_X("SegmentList::check: index out of sync");
+            break;
+        }
+    }
+    if (idx != m_index.size()) {
+        ASSERT_X("SegmentList::check: index out of sync");
+    }
 }
 
 #endif
@@ -134,11 +147,19 @@ void SegmentList::insert(Segment* e, Segment* el)
     } else if (el == first()) {
         push_front(e);
     } else {
+        const size_t idx = indexOf(el);
         ++m_size;
         e->setNext(el);
         e->setPrev(el->prev());
         el->prev()->setNext(e);
         el->setPrev(e);
+        if (idx < m_index.size()) {
+            m_unorderedCount -= unorderedPairs(idx - 1, idx);
+            m_index.insert(m_index.begin() + idx, e);
+            m_unorderedCount += unorderedPairs(idx - 1, idx + 1);
+        } else {
+            updateIndex();
+        }
     }
     check();
 }
@@ -162,6 +183,7 @@ void SegmentList::remove(Segment* e)
         ASSERT_X(String(u"segment %1 not in list").arg(String::fromAscii(e->subTypeName())));
     }
 #endif
+    const size_t idx = indexOf(e);
     --m_size;
     if (e == m_first) {
         m_first = m_first->next();
@@ -180,6 +202,13 @@ void SegmentList::remove(Segment* e)
         e->prev()->setNext(e->next());
         e->next()->setPrev(e->prev());
     }
+    if (idx < m_index.size()) {
+        m_unorderedCount -= unorderedPairs(idx - 1, idx + 1);
+        m_index.erase(m_index.begin() + idx);
+        m_unorderedCount += unorderedPairs(idx - 1, idx);
+    } else {
+        updateIndex();
+    }
 }
 
 //---------------------------------------------------------
@@ -197,6 +226,8 @@ void SegmentList::push_back(Segment* e)
     }
     e->setPrev(m_last);
     m_last = e;
+    m_index.push_back(e);
+    m_unorderedCount += unorderedPairs(m_index.size() - 2, m_index.size() - 1);
     check();
 }
 
@@ -215,9 +246,127 @@ void SegmentList::push_front(Segment* e)
     }
     e->setNext(m_first);
     m_first = e;
+    m_index.insert(m_index.begin(), e);
+    m_unorderedCount += unorderedPairs(0, 1);
     check();
 }
 
+//---------------------------------------------------------
+//   lowerBound
+///   The first segment at or after the tick \a rtick,
+///   relative to the measure.
+//---------------------------------------------------------
+
+Segment* SegmentList::lowerBound(const Fraction& rtick) const
+{
+    if (!isOrdered()) {
+        for (Segment* s = m_first; s; s = s->next()) {
+            if (s->rtick() >= rtick) {
+                return s;
+            }
+        }
+        return nullptr;
+    }
+
+    auto it = std::lower_bound(m_index.cbegin(), m_index.cend(), rtick, [](const Segment* s, const Fraction& t) {
+        return s->rtick() < t;
+    });
+
+    return it != m_index.cend() ? *it : nullptr;
+}
+
+//---------------------------------------------------------
+//   find
+///   The first segment of one of the \a types at the tick
+///   \a rtick, relative to the measure.
+//---------------------------------------------------------
+
+Segment* SegmentList::find(SegmentType types, const Fraction& rtick) const
+{
+    for (Segment* s = lowerBound(rtick); s && s->rtick() == rtick; s = s->next()) {
+        if (s->segmentType() & types) {
+            return s;
+        }
+    }
+    return nullptr;
+}
+
+//---------------------------------------------------------
+//   updateIndex
+///   Rebuild the index after the tick of a segment changed.
+//---------------------------------------------------------
+
+void SegmentList::updateIndex()
+{
+    m_index.clear();
+    m_index.reserve(m_size);
+
+    for (Segment* s = m_first; s; s = s->next()) {
+        m_index.push_back(s);
+    }
+
+    m_unorderedCount = unorderedPairs(0, m_index.size());
+}
+
+//---------------------------------------------------------
+//   tickChanging
+///   The position of the segment \a s in the index, taken
+///   before its tick changes. The list order doesn't depend
+///   on the tick, so only the neighbours are checked again.
+//---------------------------------------------------------
+
+size_t SegmentList::tickChanging(const Segment* s)
+{
+    const size_t idx = indexOf(s);
+    if (idx < m_index.size()) {
+        m_unorderedCount -= unorderedPairs(idx - 1, idx + 1);
+    }
+    return idx;
+}
+
+void SegmentList::tickChanged(size_t idx)
+{
+    if (idx < m_index.size()) {
+        m_unorderedCount += unorderedPairs(idx - 1, idx + 1);
+    }
+}
+
+size_t SegmentList::indexOf(const Segment* s) const
+{
+    if (isOrdered()) {
+        auto it = std::lower_bound(m_index.cbegin(), m_index.cend(), s->rtick(), [](const Segment* seg, const Fraction& t) {
+            return seg->rtick() < t;
+        });
+        for (; it != m_index.cend() && (*it)->rtick() == s->rtick(); ++it) {
+            if (*it == s) {
+                return it - m_index.cbegin();
+            }
+        }
+
+        // the segments are ordered, so it's not in the list
+        return m_index.size();
+    }
+
+    return std::find(m_index.cbegin(), m_index.cend(), s) - m_index.cbegin();
+}
+
+//---------------------------------------------------------
+//   unorderedPairs
+///   The number of neighbours out of order among the index
+///   entries from \a first to \a last, both may be out of range
+//---------------------------------------------------------
+
+size_t SegmentList::unorderedPairs(size_t first, size_t last) const
+{
+    size_t count = 0;
+    for (size_t idx = first + 1; idx <= last && idx < m_index.size(); ++idx) {
+        if (idx > 0 && m_index[idx - 1]->rtick() > m_index[idx]->rtick()) {
+            ++count;
+        }
+    }
+    return count;
+}
+
 //---------------------------------------------------------
 //   firstCRSegment
 //---------------------------------------------------------
@@ -23,6 +23,8 @@
 #ifndef MU_ENGRAVING_SEGMENTLIST_H
 #define MU_ENGRAVING_SEGMENTLIST_H
 
+#include <vector>
+
 #include "segment.h"
 
 namespace mu::engraving {
@@ -36,7 +38,7 @@ class SegmentList
 {
 public:
     SegmentList() { clear(); }
-    void clear() { m_first = m_last = 0; m_size = 0; }
+    void clear() { m_first = m_last = 0; m_size = 0; m_index.clear(); m_unorderedCount = 0; }
 #ifndef NDEBUG
     void check();
 #else
@@ -58,6 +60,16 @@ public:
     void push_front(Segment*);
     void insert(Segment* e, Segment* el);    // insert e before el
 
+    Segment* lowerBound(const Fraction& rtick) const;
+    Segment* find(SegmentType types, const Fraction& rtick) const;
+
+    void updateIndex();
+
+    //! NOTE Called around a change of the tick of the segment \a s, so only its neighbours are checked.
+    //! tickChanging() returns the position to pass to tickChanged()
+    size_t tickChanging(const Segment* s);
+    void tickChanged(size_t idx);
+
     class iterator
     {
         Segment* p;
@@ -83,10 +95,19 @@ public:
     const_iterator end() const { return 0; }
 
 private:
+    size_t indexOf(const Segment* s) const;
+    bool isOrdered() const { return m_unorderedCount == 0; }
+    size_t unorderedPairs(size_t first, size_t last) const;
 
     Segment* m_first = nullptr;          // First item of segment list
     Segment* m_last = nullptr;           // Last item of segment list
     int m_size = 0;                      // Number of items in segment list
+
+    //! NOTE: The segments in the list order, for the binary search by tick.
+    //! If their ticks are out of order (e.g. in the middle of an edit), the lookups scan the list.
+    //! m_unorderedCount is the number of neighbours whose ticks are out of order
+    std::vector<Segment*> m_index;
+    size_t m_unorderedCount = 0;
 };
 
 // Segment* begin(SegmentList& l) { return l.first(); }
@@ -182,6 +182,48 @@ void UndoCommand::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   UndoCommand::memoryUsage
+//---------------------------------------------------------
+
+size_t UndoCommand::memoryUsage() const
+{
+    return sizeof(UndoCommand) + childrenMemoryUsage();
+}
+
+size_t UndoCommand::childrenMemoryUsage() const
+{
+    //! NOTE: A node of std::list holds two links besides the value
+    constexpr size_t LIST_NODE_SIZE = 3 * sizeof(void*);
+
+    size_t usage = childList.size() * LIST_NODE_SIZE;
+    for (const UndoCommand* c : childList) {
+        usage += c->memoryUsage();
+    }
+
+    return usage;
+}
+
+size_t UndoCommand::itemsMemoryUsage(const EngravingObject* root)
+{
+    //! NOTE: The items differ in size, this is about the size of an item with its layout data
+    constexpr size_t ITEM_MEMORY_USAGE = sizeof(EngravingItem) + sizeof(EngravingItem::LayoutData);
+
+    size_t usage = 0;
+    std::vector<const EngravingObject*> objects { root };
+    while (!objects.empty()) {
+        const EngravingObject* obj = objects.back();
+        objects.pop_back();
+
+        usage += ITEM_MEMORY_USAGE;
+        for (const EngravingObject* child : obj->children()) {
+            objects.push_back(child);
+        }
+    }
+
+    return usage;
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -346,6 +388,11 @@ void UndoStack::beginMacro(Score* score)
 
 void UndoStack::push(UndoCommand* cmd, EditData* ed)
 {
+    if (CrossScoreChanges* changes = CrossScoreChanges::current()) {
+        changes->push(cmd, ed);
+        return;
+    }
+
     if (!curCmd) {
         // this can happen for layout() outside of a command (load)
         if (!ScoreLoad::loading()) {
@@ -356,6 +403,15 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
         delete cmd;
         return;
     }
+
+    //! NOTE: Repeated changes of a property (e.g. while dragging) only need the first command,
+    //! it already holds the value to restore on undo
+    if (cmd->type() == CommandType::ChangeProperty && !curCmd->commands().empty()
+        && static_cast<ChangeProperty*>(cmd)->canMergeInto(curCmd->commands().back())) {
+        cmd->redo(ed);
+        delete cmd;
+        return;
+    }
 #ifndef QT_NO_DEBUG
     if (!strcmp(cmd->name(), "ChangeProperty")) {
         ChangeProperty* cp = static_cast<ChangeProperty*>(cmd);
@@ -374,6 +430,11 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
 
 void UndoStack::push1(UndoCommand* cmd)
 {
+    if (CrossScoreChanges* changes = CrossScoreChanges::current()) {
+        changes->push1(cmd);
+        return;
+    }
+
     if (!curCmd) {
         if (!ScoreLoad::loading()) {
             LOGW("no active command, UndoStack %p", this);
@@ -393,27 +454,66 @@ void UndoStack::remove(size_t idx)
     assert(curIdx != muse::nidx);
     // remove redo stack
     while (list.size() > curIdx) {
-        UndoCommand* cmd = muse::takeLast(list);
         stateList.pop_back();
-        cmd->cleanup(false);      // delete elements for which UndoCommand() holds ownership
-        delete cmd;
+        deleteMacro(muse::takeLast(list), false);      // delete elements for which UndoCommand() holds ownership
 //            --curIdx;
     }
     while (list.size() > idx) {
-        UndoCommand* cmd = muse::takeLast(list);
         stateList.pop_back();
-        cmd->cleanup(true);
-        delete cmd;
+        deleteMacro(muse::takeLast(list), true);
     }
     curIdx = idx;
 }
 
+//---------------------------------------------------------
+//   deleteMacro
+//---------------------------------------------------------
+
+void UndoStack::deleteMacro(UndoMacro* macro, bool undo)
+{
+    m_memoryUsage -= std::min(m_memoryUsage, macro->memoryUsage());
+    macro->cleanup(undo);
+    delete macro;
+}
+
+//---------------------------------------------------------
+//   dropOldestMacros
+//    keep the history within the memory limit
+//---------------------------------------------------------
+
+void UndoStack::dropOldestMacros()
+{
+    if (m_memoryLimit == 0 || m_memoryUsage <= m_memoryLimit) {
+        return;
+    }
+
+    size_t count = 0;
+    while (m_memoryUsage > m_memoryLimit && count + 1 < curIdx) {
+        deleteMacro(list[count], true);
+        ++count;
+    }
+
+    if (count == 0) {
+        return;
+    }
+
+    list.erase(list.begin(), list.begin() + count);
+    stateList.erase(stateList.begin(), stateList.begin() + count);
+    curIdx -= count;
+    m_firstIdx += count;
+
+    LOGI() << "dropped " << count << " undo macros, memory usage: " << m_memoryUsage << " of " << m_memoryLimit << " bytes";
+}
+
 //---------------------------------------------------------
 //   mergeCommands
 //---------------------------------------------------------
 
 void UndoStack::mergeCommands(size_t startIdx)
 {
+    //! NOTE: The macros from the start on may have been dropped already, then merge all the remaining ones
+    startIdx = startIdx > m_firstIdx ? startIdx - m_firstIdx : 0;
+
     assert(startIdx <= curIdx);
 
     if (startIdx >= list.size()) {
@@ -422,10 +522,16 @@ void UndoStack::mergeCommands(size_t startIdx)
 
     UndoMacro* startMacro = list[startIdx];
 
+    m_memoryUsage -= std::min(m_memoryUsage, startMacro->memoryUsage());
+
     for (size_t idx = startIdx + 1; idx < curIdx; ++idx) {
+        m_memoryUsage -= std::min(m_memoryUsage, list[idx]->memoryUsage());
         startMacro->append(std::move(*list[idx]));
+        m_memoryUsage += list[idx]->memoryUsage();
     }
     remove(startIdx + 1);   // TODO: remove from startIdx to curIdx only
+
+    m_memoryUsage += startMacro->memoryUsage();
 }
 
 //---------------------------------------------------------
@@ -463,16 +569,17 @@ void UndoStack::endMacro(bool rollback)
     } else {
         // remove redo stack
         while (list.size() > curIdx) {
-            UndoCommand* cmd = muse::takeLast(list);
             stateList.pop_back();
-            cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
-            delete cmd;
+            deleteMacro(muse::takeLast(list), false);        // delete elements for which UndoCommand() holds ownership
         }
         list.push_back(curCmd);
         stateList.push_back(nextState++);
         ++curIdx;
+        m_memoryUsage += curCmd->memoryUsage();
     }
     curCmd = 0;
+
+    dropOldestMacros();
 }
 
 //---------------------------------------------------------
@@ -491,6 +598,7 @@ void UndoStack::reopen()
     --curIdx;
     curCmd = muse::takeAt(list, curIdx);
     stateList.erase(stateList.begin() + curIdx);
+    m_memoryUsage -= std::min(m_memoryUsage, curCmd->memoryUsage());
     for (auto i : curCmd->commands()) {
         LOG_UNDO() << "   " << i->name();
     }
@@ -506,7 +614,7 @@ void UndoStack::undo(EditData* ed)
     // Are we currently editing text?
     if (ed && ed->element && ed->element->isTextBase()) {
         TextEditData* ted = static_cast<TextEditData*>(ed->getData(ed->element).get());
-        if (ted && ted->startUndoIdx == curIdx) {
+        if (ted && ted->startUndoIdx == getCurIdx()) {
             // No edits to undo, so do nothing
             return;
         }
@@ -530,6 +638,112 @@ void UndoStack::redo(EditData* ed)
     }
 }
 
+//---------------------------------------------------------
+//   CrossScoreChanges
+//---------------------------------------------------------
+
+static thread_local CrossScoreChanges* s_currentCrossScoreChanges = nullptr;
+
+CrossScoreChanges::CrossScoreChanges(const Score* score)
+    : m_score(score)
+{
+}
+
+CrossScoreChanges::~CrossScoreChanges()
+{
+    for (Change& change : m_changes) {
+        delete change.command;
+    }
+}
+
+CrossScoreChanges* CrossScoreChanges::current()
+{
+    return s_currentCrossScoreChanges;
+}
+
+CrossScoreChanges::Scope::Scope(CrossScoreChanges* changes)
+    : m_previous(s_currentCrossScoreChanges)
+{
+    s_currentCrossScoreChanges = changes;
+}
+
+CrossScoreChanges::Scope::~Scope()
+{
+    s_currentCrossScoreChanges = m_previous;
+}
+
+bool CrossScoreChanges::changesOwnScoreOnly(const UndoCommand* cmd) const
+{
+    //! NOTE: The links are shared with the linked elements of the other scores
+    if (cmd->type() == CommandType::Link || cmd->type() == CommandType::Unlink) {
+        return false;
+    }
+
+    const std::vector<const EngravingObject*> objects = cmd->objectItems();
+    if (objects.empty()) {
+        return false;
+    }
+
+    for (const EngravingObject* object : objects) {
+        if (object && object->score() != m_score) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void CrossScoreChanges::push(UndoCommand* cmd, EditData* ed)
+{
+    if (!changesOwnScoreOnly(cmd)) {
+        for (const EngravingObject* object : cmd->objectItems()) {
+            if (object && object->score() != m_score) {
+                m_changedScores.insert(object->score());
+            }
+        }
+
+        m_changes.push_back({ cmd, ed, false, nullptr });
+        return;
+    }
+
+    cmd->redo(ed);
+
+    if (!m_score->undoStack()->active()) {
+        delete cmd;
+        return;
+    }
+
+    m_changes.push_back({ cmd, nullptr, true, nullptr });
+}
+
+void CrossScoreChanges::push1(UndoCommand* cmd)
+{
+    m_changes.push_back({ cmd, nullptr, true, nullptr });
+}
+
+void CrossScoreChanges::defer(Score* target, std::function<void()> change)
+{
+    m_changedScores.insert(target);
+    m_changes.push_back({ nullptr, nullptr, false, std::move(change) });
+}
+
+void CrossScoreChanges::replay(UndoStack* stack)
+{
+    assert(!current());
+
+    for (Change& change : m_changes) {
+        if (change.func) {
+            change.func();
+        } else if (change.executed) {
+            stack->push1(change.command);
+        } else {
+            stack->push(change.command, change.editData);
+        }
+    }
+
+    m_changes.clear();
+}
+
 //---------------------------------------------------------
 //   UndoMacro
 //---------------------------------------------------------
@@ -617,6 +831,12 @@ bool UndoMacro::empty() const
     return childCount() == 0;
 }
 
+size_t UndoMacro::memoryUsage() const
+{
+    return sizeof(*this) + childrenMemoryUsage()
+           + (m_undoSelectionInfo.elements.capacity() + m_redoSelectionInfo.elements.capacity()) * sizeof(EngravingItem*);
+}
+
 void UndoMacro::append(UndoMacro&& other)
 {
     appendChildren(&other);
@@ -800,6 +1020,7 @@ AddElement::AddElement(EngravingItem* e)
 {
     DO_ASSERT_X(!e->generated(), String(u"Generated item %1 passed to AddElement").arg(String::fromAscii(e->typeName())));
     element = e;
+    elementMemoryUsage = itemsMemoryUsage(e);
 }
 
 //---------------------------------------------------------
@@ -1005,6 +1226,7 @@ RemoveElement::RemoveElement(EngravingItem* e)
         const Note* note = toNote(element);
         removeNote(note);
     }
+    elementMemoryUsage = itemsMemoryUsage(element);
 }
 
 //---------------------------------------------------------
@@ -1441,6 +1663,9 @@ ChangeElement::ChangeElement(EngravingItem* oe, EngravingItem* ne)
 {
     oldElement = oe;
     newElement = ne;
+
+    //! NOTE: The command owns one of them, depending on whether it's undone
+    elementsMemoryUsage = std::max(itemsMemoryUsage(oe), itemsMemoryUsage(ne));
 }
 
 void ChangeElement::flip(EditData*)
@@ -2085,6 +2310,22 @@ void ChangeMStaffProperties::flip(EditData*)
     stemless = s;
 }
 
+//---------------------------------------------------------
+//   InsertRemoveMeasures
+//---------------------------------------------------------
+
+InsertRemoveMeasures::InsertRemoveMeasures(MeasureBase* _fm, MeasureBase* _lm, bool _moveStc)
+    : fm(_fm), lm(_lm), moveStc(_moveStc)
+{
+    //! NOTE: The measures own their segments and these own the rest
+    for (const MeasureBase* mb = fm; mb; mb = mb->next()) {
+        measuresMemoryUsage += itemsMemoryUsage(mb);
+        if (mb == lm) {
+            break;
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   getCourtesyClefs
 //    remember clefs at the end of previous measure
@@ -2663,6 +2904,17 @@ std::vector<const EngravingObject*> ChangeProperty::objectItems() const
     return compoundObjects(element);
 }
 
+bool ChangeProperty::canMergeInto(const UndoCommand* previous) const
+{
+    //! NOTE: The derived commands do more than setting the property
+    if (strcmp(name(), "ChangeProperty") != 0 || strcmp(previous->name(), "ChangeProperty") != 0) {
+        return false;
+    }
+
+    const ChangeProperty* other = static_cast<const ChangeProperty*>(previous);
+    return other->element == element && other->id == id && other->childCount() == 0 && childCount() == 0;
+}
+
 //---------------------------------------------------------
 //   ChangeBracketProperty::flip
 //---------------------------------------------------------
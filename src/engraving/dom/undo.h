@@ -28,7 +28,9 @@
  Definition of undo-related classes and structs.
 */
 
+#include <functional>
 #include <map>
+#include <set>
 
 #include "modularity/ioc.h"
 #include "../iengravingfontsprovider.h"
@@ -110,6 +112,8 @@ class UndoCommand
 protected:
     virtual void flip(EditData*) {}
     void appendChildren(UndoCommand*);
+    size_t childrenMemoryUsage() const;
+    static size_t itemsMemoryUsage(const EngravingObject* root);
 
 public:
     enum class Filter {
@@ -132,6 +136,10 @@ public:
     const std::list<UndoCommand*>& commands() const { return childList; }
     virtual std::vector<const EngravingObject*> objectItems() const { return {}; }
     virtual void cleanup(bool undo);
+
+    //! NOTE: An estimate of the memory held by the command and its children,
+    //! the commands holding more than a few pointers or owning items override it
+    virtual size_t memoryUsage() const;
 // #ifndef QT_NO_DEBUG
     virtual const char* name() const { return "UndoCommand"; }
 // #endif
@@ -183,6 +191,8 @@ public:
 
     ChangesInfo changesInfo() const;
 
+    size_t memoryUsage() const override;
+
     static bool canRecordSelectedElement(const EngravingItem* e);
 
     UNDO_NAME("UndoMacro")
@@ -209,7 +219,15 @@ class UndoStack
     size_t curIdx = 0;
     bool isLocked = false;
 
+    //! NOTE: The oldest macros are dropped to keep the history within the memory limit,
+    //! the indices given out by getCurIdx() are counted from the very first macro
+    size_t m_firstIdx = 0;
+    size_t m_memoryLimit = 0;
+    size_t m_memoryUsage = 0;
+
     void remove(size_t idx);
+    void deleteMacro(UndoMacro* macro, bool undo);
+    void dropOldestMacros();
 
 public:
     UndoStack();
@@ -226,7 +244,7 @@ public:
     bool canUndo() const { return curIdx > 0; }
     bool canRedo() const { return curIdx < list.size(); }
     bool isClean() const { return cleanState == stateList[curIdx]; }
-    size_t getCurIdx() const { return curIdx; }
+    size_t getCurIdx() const { return m_firstIdx + curIdx; }
     UndoMacro* current() const { return curCmd; }
     UndoMacro* last() const { return curIdx > 0 ? list[curIdx - 1] : 0; }
     UndoMacro* prev() const { return curIdx > 1 ? list[curIdx - 2] : 0; }
@@ -236,6 +254,67 @@ public:
 
     void mergeCommands(size_t startIdx);
     void cleanRedoStack() { remove(curIdx); }
+
+    //! NOTE: 0 means no limit. The last macro is always kept
+    void setMemoryLimit(size_t bytes) { m_memoryLimit = bytes; }
+    size_t memoryLimit() const { return m_memoryLimit; }
+    size_t memoryUsage() const { return m_memoryUsage; }
+    size_t macroCount() const { return list.size(); }
+};
+
+//---------------------------------------------------------
+//   CrossScoreChanges
+//    the changes the layout of an excerpt makes while the other
+//    scores are laid out concurrently (see MasterScore::doLayoutScoresRange)
+//---------------------------------------------------------
+
+class CrossScoreChanges
+{
+public:
+    explicit CrossScoreChanges(const Score* score);
+    ~CrossScoreChanges();
+
+    //! NOTE: The changes collected on the calling thread, if any
+    static CrossScoreChanges* current();
+
+    //! NOTE: Collects the changes made on the calling thread while alive
+    class Scope
+    {
+    public:
+        explicit Scope(CrossScoreChanges* changes);
+        ~Scope();
+
+    private:
+        CrossScoreChanges* m_previous = nullptr;
+    };
+
+    const Score* score() const { return m_score; }
+
+    //! NOTE: The commands changing only the score are executed right away, the other ones
+    //! (and the ones changing the links, shared with the other scores) are queued
+    void push(UndoCommand* cmd, EditData* ed);
+    void push1(UndoCommand* cmd);
+    void defer(Score* target, std::function<void()> change);
+
+    //! NOTE: Pushes everything to the stack in the order it was made, on the main thread
+    void replay(UndoStack* stack);
+
+    //! NOTE: The scores changed by the queued changes
+    const std::set<Score*>& changedScores() const { return m_changedScores; }
+
+private:
+    struct Change {
+        UndoCommand* command = nullptr;
+        EditData* editData = nullptr;
+        bool executed = false;
+        std::function<void()> func;
+    };
+
+    bool changesOwnScoreOnly(const UndoCommand* cmd) const;
+
+    const Score* m_score = nullptr;
+    std::vector<Change> m_changes;
+    std::set<Score*> m_changedScores;
 };
 
 class InsertPart : public UndoCommand
@@ -519,12 +598,15 @@ class ChangeElement : public UndoCommand
 
     EngravingItem* oldElement = nullptr;
     EngravingItem* newElement = nullptr;
+    size_t elementsMemoryUsage = 0;
 
     void flip(EditData*) override;
 
 public:
     ChangeElement(EngravingItem* oldElement, EngravingItem* newElement);
 
+    size_t memoryUsage() const override { return sizeof(*this) + elementsMemoryUsage + childrenMemoryUsage(); }
+
     UNDO_TYPE(CommandType::ChangeElement)
     UNDO_NAME("ChangeElement")
     UNDO_CHANGED_OBJECTS({ oldElement, newElement })
@@ -632,6 +714,7 @@ class AddElement : public UndoCommand
     OBJECT_ALLOCATOR(engraving, AddElement)
 
     EngravingItem* element = nullptr;
+    size_t elementMemoryUsage = 0;
 
     void endUndoRedo(bool) const;
     void undo(EditData*) override;
@@ -647,6 +730,8 @@ public:
 
     std::vector<const EngravingObject*> objectItems() const override;
 
+    size_t memoryUsage() const override { return sizeof(*this) + elementMemoryUsage + childrenMemoryUsage(); }
+
     UNDO_TYPE(CommandType::AddElement)
 };
 
@@ -655,6 +740,7 @@ class RemoveElement : public UndoCommand
     OBJECT_ALLOCATOR(engraving, RemoveElement)
 
     EngravingItem* element = nullptr;
+    size_t elementMemoryUsage = 0;
 
 public:
     RemoveElement(EngravingItem*);
@@ -665,6 +751,8 @@ public:
 
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override;
 
+    size_t memoryUsage() const override { return sizeof(*this) + elementMemoryUsage + childrenMemoryUsage(); }
+
     UNDO_TYPE(CommandType::RemoveElement)
     UNDO_CHANGED_OBJECTS({ element })
 };
@@ -791,6 +879,8 @@ public:
     UNDO_TYPE(CommandType::ChangeStyle)
     UNDO_NAME("ChangeStyle")
     UNDO_CHANGED_OBJECTS({ score })
+
+    size_t memoryUsage() const override { return sizeof(*this) + childrenMemoryUsage(); }
 };
 
 class ChangeStyleValues : public UndoCommand
@@ -890,6 +980,7 @@ class InsertRemoveMeasures : public UndoCommand
 
     MeasureBase* fm = nullptr;
     MeasureBase* lm = nullptr;
+    size_t measuresMemoryUsage = 0;
 
     static std::vector<Clef*> getCourtesyClefs(Measure* m);
 
@@ -900,10 +991,11 @@ protected:
     void insertMeasures();
 
 public:
-    InsertRemoveMeasures(MeasureBase* _fm, MeasureBase* _lm, bool _moveStc)
-        : fm(_fm), lm(_lm), moveStc(_moveStc) {}
+    InsertRemoveMeasures(MeasureBase* _fm, MeasureBase* _lm, bool _moveStc);
     virtual void undo(EditData*) override = 0;
     virtual void redo(EditData*) override = 0;
+
+    size_t memoryUsage() const override { return sizeof(*this) + measuresMemoryUsage + childrenMemoryUsage(); }
     UNDO_CHANGED_OBJECTS({ fm, lm })
 };
 
@@ -1133,6 +1225,11 @@ public:
 
     std::vector<const EngravingObject*> objectItems() const override;
 
+    size_t memoryUsage() const override { return sizeof(*this) + childrenMemoryUsage(); }
+
+    //! NOTE: Whether the command only repeats the change of the given one, which is then enough to undo both
+    bool canMergeInto(const UndoCommand* previous) const;
+
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override
     {
         return f == UndoCommand::Filter::ChangePropertyLinked && muse::contains(target->linkList(), element);
@@ -23,6 +23,7 @@
 
 #include "modularity/ioc.h"
 #include "global/allocator.h"
+#include "global/iglobalconfiguration.h"
 
 #include "draw/ifontprovider.h"
 #include "draw/internal/ifontsdatabase.h"
@@ -177,6 +178,10 @@ void EngravingModule::onInit(const IApplication::RunMode& mode)
 
 #ifndef ENGRAVING_NO_INTERNAL
     // Init fonts
+    if (auto globalConfiguration = ioc()->resolve<IGlobalConfiguration>(moduleName())) {
+        m_engravingfonts->setMetricsCacheDir(globalConfiguration->userAppDataPath() + "/fontmetricscache");
+    }
+
 #ifdef MUSE_MODULE_DRAW_USE_QTFONTMETRICS
     {
         // Symbols
@@ -111,6 +111,13 @@ public:
 
     virtual bool isAccessibleEnabled() const = 0;
 
+    //! NOTE: 0 means no limit
+    virtual int undoHistoryMemoryLimitMb() const = 0;
+    virtual void setUndoHistoryMemoryLimitMb(int limit) = 0;
+
+    virtual bool isParallelPartsLayoutEnabled() const = 0;
+    virtual void setParallelPartsLayoutEnabled(bool enabled) = 0;
+
     /// these configurations will be removed after solving https://github.com/musescore/MuseScore/issues/14294
     virtual bool guitarProImportExperimental() const = 0;
     virtual bool negativeFretsAllowed() const = 0;
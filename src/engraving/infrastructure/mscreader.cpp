@@ -264,7 +264,13 @@ Ret MscReader::ZipFileReader::open(IODevice* device, const path_t& filePath)
             return make_ret(Err::FileNotFound, filePath);
         }
 
-        m_device = new File(filePath);
+        File* file = new File(filePath);
+
+        //! NOTE Usually only some of the entries are needed (e.g. only the score and the thumbnail for the meta),
+        //! so don't load the whole container, the zip reader only touches the entries it reads
+        file->setMapOnRead(true);
+
+        m_device = file;
         m_selfDeviceOwner = true;
     }
 
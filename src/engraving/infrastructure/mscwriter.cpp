@@ -100,6 +100,10 @@ bool MscWriter::hasError() const
 
 MscWriter::IWriter* MscWriter::writer() const
 {
+    if (!m_writer && m_params.deferred) {
+        m_writer = new DeferredWriter(&m_deferredFiles);
+    }
+
     if (!m_writer) {
         switch (m_params.mode) {
         case MscIoMode::Zip:
@@ -203,6 +207,24 @@ void MscWriter::writeViewSettingsJsonFile(const ByteArray& data, const muse::io:
     addFileData(pathPrefix.toString() + u"viewsettings.json", data);
 }
 
+Ret MscWriter::writeTo(MscWriter& writer) const
+{
+    IF_ASSERT_FAILED(m_params.deferred && !isOpened()) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    for (const DeferredFile& file : m_deferredFiles) {
+        if (!writer.addFileData(file.fileName, file.data)) {
+            return make_ret(Ret::Code::UnknownError);
+        }
+    }
+
+    //! NOTE The container file is among the collected ones
+    writer.m_meta.isWritten = m_meta.isWritten;
+
+    return make_ok();
+}
+
 void MscWriter::writeMeta()
 {
     if (m_meta.isWritten) {
@@ -469,3 +491,36 @@ bool MscWriter::XmlFileWriter::addFileData(const String& fileName, const ByteArr
 
     return true;
 }
+
+MscWriter::DeferredWriter::DeferredWriter(std::vector<DeferredFile>* files)
+    : m_files(files)
+{
+}
+
+Ret MscWriter::DeferredWriter::open(io::IODevice*, const path_t&)
+{
+    m_files->clear();
+    m_isOpened = true;
+    return true;
+}
+
+void MscWriter::DeferredWriter::close()
+{
+    m_isOpened = false;
+}
+
+bool MscWriter::DeferredWriter::isOpened() const
+{
+    return m_isOpened;
+}
+
+bool MscWriter::DeferredWriter::hasError() const
+{
+    return false;
+}
+
+bool MscWriter::DeferredWriter::addFileData(const String& fileName, const ByteArray& data)
+{
+    m_files->push_back({ fileName, data });
+    return true;
+}
@@ -22,6 +22,8 @@
 #ifndef MU_ENGRAVING_MSCWRITER_H
 #define MU_ENGRAVING_MSCWRITER_H
 
+#include <vector>
+
 #include "types/string.h"
 #include "types/ret.h"
 #include "io/path.h"
@@ -44,6 +46,10 @@ public:
         muse::io::path_t filePath;
         muse::String mainFileName;
         MscIoMode mode = MscIoMode::Zip;
+
+        //! NOTE Only collect the files in memory, they are written later by writeTo(),
+        //! possibly on another thread. The device, the file path and the mode are not used
+        bool deferred = false;
     };
 
     MscWriter() = default;
@@ -69,6 +75,9 @@ public:
     void writeAudioSettingsJsonFile(const muse::ByteArray& data, const muse::io::path_t& pathPrefix = "");
     void writeViewSettingsJsonFile(const muse::ByteArray& data, const muse::io::path_t& pathPrefix = "");
 
+    //! NOTE Writes the files collected by this deferred writer, after it is closed, to an opened writer
+    muse::Ret writeTo(MscWriter& writer) const;
+
 private:
 
     struct IWriter {
@@ -122,6 +131,24 @@ private:
         muse::TextStream* m_stream = nullptr;
     };
 
+    struct DeferredFile {
+        muse::String fileName;
+        muse::ByteArray data;
+    };
+
+    struct DeferredWriter : public IWriter
+    {
+        DeferredWriter(std::vector<DeferredFile>* files);
+        muse::Ret open(muse::io::IODevice* device, const muse::io::path_t& filePath) override;
+        void close() override;
+        bool isOpened() const override;
+        bool hasError() const override;
+        bool addFileData(const muse::String& fileName, const muse::ByteArray& data) override;
+    private:
+        std::vector<DeferredFile>* m_files = nullptr;
+        bool m_isOpened = false;
+    };
+
     struct Meta {
         std::vector<muse::String> files;
         bool isWritten = false;
@@ -143,6 +170,7 @@ private:
     mutable IWriter* m_writer = nullptr;
     Meta m_meta;
     bool m_hadError = false;
+    mutable std::vector<DeferredFile> m_deferredFiles;
 };
 }
 
@@ -19,6 +19,7 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
+#include <array>
 #include <cfloat>
 
 #include "shape.h"
@@ -34,6 +35,111 @@ using namespace muse;
 using namespace muse::draw;
 using namespace mu::engraving;
 
+//---------------------------------------------------------
+//   SolidGeometry
+//    The left and right edges and the bottoms of the elements of a shape
+//    that can collide vertically, i.e. neither flat nor of zero width,
+//    packed in separate arrays in the order of the elements. The inner
+//    loops of the collision queries then read contiguous memory and
+//    don't branch.
+//---------------------------------------------------------
+
+namespace {
+class SolidGeometry
+{
+public:
+    explicit SolidGeometry(const std::vector<ShapeElement>& elements)
+    {
+        double* data = m_inline.data();
+        size_t capacity = INLINE_CAPACITY;
+        if (elements.size() > INLINE_CAPACITY) {
+            //! NOTE The queries are called very often, so the buffer of the thread is reused
+            //! instead of allocating one every time. It's only taken by one geometry at a time
+            static thread_local std::vector<double> s_buffer;
+            static thread_local bool s_bufferTaken = false;
+
+            std::vector<double>* buffer = &m_heap;
+            if (!s_bufferTaken) {
+                s_bufferTaken = true;
+                m_bufferTaken = &s_bufferTaken;
+                buffer = &s_buffer;
+            }
+
+            if (buffer->size() < 3 * elements.size()) {
+                buffer->resize(3 * elements.size());
+            }
+            data = buffer->data();
+            capacity = elements.size();
+        }
+
+        m_left = data;
+        m_right = data + capacity;
+        m_bottom = data + 2 * capacity;
+
+        for (const ShapeElement& r : elements) {
+            const double left = r.left();
+            const double right = r.right();
+            if (r.height() <= 0.0 || left == right) {
+                continue;
+            }
+            m_left[m_size] = left;
+            m_right[m_size] = right;
+            m_bottom[m_size] = r.bottom();
+            ++m_size;
+        }
+    }
+
+    ~SolidGeometry()
+    {
+        if (m_bufferTaken) {
+            *m_bufferTaken = false;
+        }
+    }
+
+    SolidGeometry(const SolidGeometry&) = delete;
+    SolidGeometry& operator=(const SolidGeometry&) = delete;
+
+    bool empty() const { return m_size == 0; }
+
+    //! NOTE Folds bottom - top into dist with std::max, over the elements
+    //! horizontally intersecting [left, right], see mu::engraving::intersects
+    double maxBottomOverTop(double left, double right, double top, double clearance, double dist) const
+    {
+        const double rightWithClearance = right + clearance;
+        for (size_t i = 0; i < m_size; ++i) {
+            const bool hit = (m_right[i] + clearance > left) & (m_left[i] < rightWithClearance);
+            const double d = m_bottom[i] - top;
+            dist = (hit & (dist < d)) ? d : dist;
+        }
+        return dist;
+    }
+
+    //! NOTE Folds top - bottom into dist with std::min
+    double minTopUnderBottom(double left, double right, double top, double clearance, double dist) const
+    {
+        const double rightWithClearance = right + clearance;
+        for (size_t i = 0; i < m_size; ++i) {
+            const bool hit = (m_right[i] + clearance > left) & (m_left[i] < rightWithClearance);
+            const double d = top - m_bottom[i];
+            dist = (hit & (d < dist)) ? d : dist;
+        }
+        return dist;
+    }
+
+private:
+    static constexpr size_t INLINE_CAPACITY = 16;
+
+    std::array<double, 3 * INLINE_CAPACITY> m_inline;
+    std::vector<double> m_heap;
+    bool* m_bufferTaken = nullptr;
+
+    double* m_left = nullptr;
+    double* m_right = nullptr;
+    double* m_bottom = nullptr;
+    size_t m_size = 0;
+};
+}
+
 Shape::Shape(const std::vector<RectF>& rects, const EngravingItem* p)
 {
     m_type = Type::Composite;
@@ -207,22 +313,18 @@ double Shape::minVerticalDistance(const Shape& a, double minHorizontalClearance)
     }
 
     double dist = -DBL_MAX; // min real
+    const SolidGeometry above(m_elements);
+    if (above.empty()) {
+        return dist;
+    }
+
     for (const RectF& r2 : a.m_elements) {
-        if (r2.height() <= 0.0) {
-            continue;
-        }
         double bx1 = r2.left();
         double bx2 = r2.right();
-        for (const RectF& r1 : m_elements) {
-            if (r1.height() <= 0.0) {
-                continue;
-            }
-            double ax1 = r1.left();
-            double ax2 = r1.right();
-            if (mu::engraving::intersects(ax1, ax2, bx1, bx2, minHorizontalClearance)) {
-                dist = std::max(dist, r1.bottom() - r2.top());
-            }
+        if (r2.height() <= 0.0 || bx1 == bx2) {
+            continue;
         }
+        dist = above.maxBottomOverTop(bx1, bx2, r2.top(), minHorizontalClearance, dist);
     }
     return dist;
 }
@@ -242,22 +344,18 @@ double Shape::verticalClearance(const Shape& a, double minHorizontalDistance) co
     }
 
     double dist = DBL_MAX; // max real
+    const SolidGeometry above(m_elements);
+    if (above.empty()) {
+        return dist;
+    }
+
     for (const RectF& r2 : a.m_elements) {
-        if (r2.height() <= 0.0) {
-            continue;
-        }
         double bx1 = r2.left();
         double bx2 = r2.right();
-        for (const RectF& r1 : m_elements) {
-            if (r1.height() <= 0.0) {
-                continue;
-            }
-            double ax1 = r1.left();
-            double ax2 = r1.right();
-            if (mu::engraving::intersects(ax1, ax2, bx1, bx2, minHorizontalDistance)) {
-                dist = std::min(dist, r2.top() - r1.bottom());
-            }
+        if (r2.height() <= 0.0 || bx1 == bx2) {
+            continue;
         }
+        dist = above.minTopUnderBottom(bx1, bx2, r2.top(), minHorizontalDistance, dist);
     }
     return dist;
 }
@@ -22,6 +22,8 @@
 
 #include "skyline.h"
 
+#include <algorithm>
+
 #include "realfn.h"
 #include "draw/painter.h"
 
@@ -103,12 +105,16 @@ SkylineLine SkylineLine::getFilteredCopy(std::function<bool(const ShapeElement&)
     SkylineLine newSkylineLine(*this);
 
     newSkylineLine.m_shape.clear();
+    newSkylineLine.m_tops.clear();
+    newSkylineLine.m_bottoms.clear();
+    newSkylineLine.m_envelopesDirty = false;
 
     for (const ShapeElement& shapeEl : m_shape.elements()) {
         if (filterOut(shapeEl)) {
             continue;
         }
         newSkylineLine.m_shape.add(shapeEl);
+        newSkylineLine.addToEnvelopes(shapeEl);
     }
 
     return newSkylineLine;
@@ -140,6 +146,111 @@ void SkylineLine::add(const ShapeElement& r)
     }
 
     m_shape.add(r);
+    if (!m_envelopesDirty) {
+        addToEnvelopes(r);
+    }
+}
+
+void SkylineLine::addToEnvelopes(const ShapeElement& r) const
+{
+    //! NOTE Flat elements never collide, see Shape::minVerticalDistance
+    if (r.height() <= 0.0) {
+        return;
+    }
+
+    m_tops.add(r.left(), r.right(), r.top());
+    m_bottoms.add(r.left(), r.right(), r.bottom());
+}
+
+void SkylineLine::rebuildEnvelopes() const
+{
+    m_tops.clear();
+    m_bottoms.clear();
+
+    for (const ShapeElement& r : m_shape.elements()) {
+        addToEnvelopes(r);
+    }
+
+    m_envelopesDirty = false;
+}
+
+const SkylineLine::Envelope& SkylineLine::tops() const
+{
+    if (m_envelopesDirty) {
+        rebuildEnvelopes();
+    }
+
+    return m_tops;
+}
+
+const SkylineLine::Envelope& SkylineLine::bottoms() const
+{
+    if (m_envelopesDirty) {
+        rebuildEnvelopes();
+    }
+
+    return m_bottoms;
+}
+
+//---------------------------------------------------------
+//   Envelope
+//---------------------------------------------------------
+
+void SkylineLine::Envelope::add(double left, double right, double value)
+{
+    if (!(right > left)) {
+        return;
+    }
+
+    const size_t begin = split(left);
+    const size_t end = split(right);
+
+    for (size_t i = begin; i < end; ++i) {
+        m_steps[i].value = m_lowest ? std::min(m_steps[i].value, value) : std::max(m_steps[i].value, value);
+    }
+
+    // merge the neighbouring steps of the same height
+    auto first = m_steps.begin() + (begin > 0 ? begin - 1 : 0);
+    auto last = m_steps.begin() + end + 1;
+    auto merged = std::unique(first, last, [](const Step& s1, const Step& s2) {
+        return s1.value == s2.value;
+    });
+    m_steps.erase(merged, last);
+}
+
+size_t SkylineLine::Envelope::split(double x)
+{
+    auto it = std::upper_bound(m_steps.begin(), m_steps.end(), x, [](double x, const Step& step) {
+        return x < step.x;
+    });
+
+    if (it != m_steps.begin() && std::prev(it)->x == x) {
+        return std::distance(m_steps.begin(), std::prev(it));
+    }
+
+    const double value = it == m_steps.begin() ? noValue() : std::prev(it)->value;
+    it = m_steps.insert(it, Step { x, value });
+
+    return std::distance(m_steps.begin(), it);
+}
+
+size_t SkylineLine::Envelope::stepEndingAfter(double x) const
+{
+    auto it = std::upper_bound(m_steps.begin(), m_steps.end(), x, [](double x, const Step& step) {
+        return x < step.x;
+    });
+
+    return it == m_steps.begin() ? 0 : std::distance(m_steps.begin(), it) - 1;
+}
+
+void SkylineLine::Envelope::translateY(double y)
+{
+    const double none = noValue();
+    for (Step& step : m_steps) {
+        if (step.value != none) {
+            step.value += y;
+        }
+    }
 }
 
 double SkylineLine::staffLinesTopAtX(double x) const
@@ -187,6 +298,9 @@ void SkylineLine::clear()
 {
     m_staffLineEdges.clear();
     m_shape.clear();
+    m_tops.clear();
+    m_bottoms.clear();
+    m_envelopesDirty = false;
 }
 
 //-------------------------------------------------------------------
@@ -200,29 +314,138 @@ double Skyline::minDistance(const Skyline& s, double minHorizontalClearance) con
     return south().minDistance(s.north(), minHorizontalClearance);
 }
 
+//! NOTE The results are the same as the ones of Shape::minVerticalDistance and Shape::verticalClearance.
+//! A pair of elements is within the clearance if and only if a pair of the steps they cover is,
+//! so only the steps are compared. A negative clearance can't be applied to the steps that way
 double SkylineLine::minDistance(const SkylineLine& sl, double minHorizontalClearance) const
 {
-    return m_shape.minVerticalDistance(sl.m_shape, minHorizontalClearance);
+    if (m_shape.empty() || sl.m_shape.empty()) {
+        return 0.0;
+    }
+
+    if (minHorizontalClearance < 0.0) {
+        return m_shape.minVerticalDistance(sl.m_shape, minHorizontalClearance);
+    }
+
+    return minDistance(bottoms(), sl.tops(), minHorizontalClearance);
 }
 
 double SkylineLine::minDistanceToShapeAbove(const Shape& shapeAbove, double minHorizontalClearance) const
 {
-    return shapeAbove.minVerticalDistance(m_shape, minHorizontalClearance);
+    if (m_shape.empty() || shapeAbove.empty()) {
+        return 0.0;
+    }
+
+    if (minHorizontalClearance < 0.0) {
+        return shapeAbove.minVerticalDistance(m_shape, minHorizontalClearance);
+    }
+
+    return minDistance(shapeAbove, tops(), minHorizontalClearance);
 }
 
 double SkylineLine::minDistanceToShapeBelow(const Shape& shapeBelow, double minHorizontalClearance) const
 {
-    return m_shape.minVerticalDistance(shapeBelow, minHorizontalClearance);
+    if (m_shape.empty() || shapeBelow.empty()) {
+        return 0.0;
+    }
+
+    if (minHorizontalClearance < 0.0) {
+        return m_shape.minVerticalDistance(shapeBelow, minHorizontalClearance);
+    }
+
+    return minDistance(bottoms(), shapeBelow, minHorizontalClearance);
 }
 
 double SkylineLine::verticalClearanceAbove(const Shape& shapeAbove) const
 {
-    return shapeAbove.verticalClearance(m_shape);
+    if (m_shape.empty() || shapeAbove.empty()) {
+        return 0.0;
+    }
+
+    const double dist = minDistance(shapeAbove, tops(), 0.0);
+    return dist == -DBL_MAX ? DBL_MAX : -dist;
 }
 
 double SkylineLine::verticalClaranceBelow(const Shape& shapeBelow) const
 {
-    return m_shape.verticalClearance(shapeBelow);
+    if (m_shape.empty() || shapeBelow.empty()) {
+        return 0.0;
+    }
+
+    const double dist = minDistance(bottoms(), shapeBelow, 0.0);
+    return dist == -DBL_MAX ? DBL_MAX : -dist;
+}
+
+//! NOTE Both envelopes are sorted, the lower steps are walked once along the upper ones
+double SkylineLine::minDistance(const Envelope& bottoms, const Envelope& tops, double minHorizontalClearance)
+{
+    const std::vector<Envelope::Step>& upper = bottoms.steps();
+    const std::vector<Envelope::Step>& lower = tops.steps();
+
+    double dist = -DBL_MAX;
+    size_t first = 0;
+    for (size_t i = 0; i + 1 < upper.size(); ++i) {
+        const double bottom = upper[i].value;
+        if (bottom == bottoms.noValue()) {
+            continue;
+        }
+
+        const double left = upper[i].x - minHorizontalClearance;
+        const double right = upper[i + 1].x + minHorizontalClearance;
+        while (first + 1 < lower.size() && lower[first + 1].x <= left) {
+            ++first;
+        }
+
+        for (size_t j = first; j + 1 < lower.size() && lower[j].x < right; ++j) {
+            if (lower[j].value != tops.noValue()) {
+                dist = std::max(dist, bottom - lower[j].value);
+            }
+        }
+    }
+
+    return dist;
+}
+
+double SkylineLine::minDistance(const Shape& shapeAbove, const Envelope& tops, double minHorizontalClearance)
+{
+    const std::vector<Envelope::Step>& lower = tops.steps();
+
+    double dist = -DBL_MAX;
+    for (const ShapeElement& r : shapeAbove.elements()) {
+        if (r.height() <= 0.0 || r.width() <= 0.0) {
+            continue;
+        }
+
+        const double right = r.right() + minHorizontalClearance;
+        for (size_t j = tops.stepEndingAfter(r.left() - minHorizontalClearance); j + 1 < lower.size() && lower[j].x < right; ++j) {
+            if (lower[j].value != tops.noValue()) {
+                dist = std::max(dist, r.bottom() - lower[j].value);
+            }
+        }
+    }
+
+    return dist;
+}
+
+double SkylineLine::minDistance(const Envelope& bottoms, const Shape& shapeBelow, double minHorizontalClearance)
+{
+    const std::vector<Envelope::Step>& upper = bottoms.steps();
+
+    double dist = -DBL_MAX;
+    for (const ShapeElement& r : shapeBelow.elements()) {
+        if (r.height() <= 0.0 || r.width() <= 0.0) {
+            continue;
+        }
+
+        const double right = r.right() + minHorizontalClearance;
+        for (size_t i = bottoms.stepEndingAfter(r.left() - minHorizontalClearance); i + 1 < upper.size() && upper[i].x < right; ++i) {
+            if (upper[i].value != bottoms.noValue()) {
+                dist = std::max(dist, upper[i].value - r.top());
+            }
+        }
+    }
+
+    return dist;
 }
 
 void Skyline::paint(Painter& painter, double lineWidth) const // DEBUG only
@@ -268,9 +491,26 @@ bool SkylineLine::valid() const
 SkylineLine& SkylineLine::translateY(double y)
 {
     m_shape.translateY(y);
+    m_tops.translateY(y);
+    m_bottoms.translateY(y);
     return *this;
 }
 
+void SkylineLine::translateY(const EngravingItem* item, double y)
+{
+    bool translated = false;
+    for (ShapeElement& shapeEl : m_shape.elements()) {
+        if (shapeEl.item() == item) {
+            shapeEl.translate(0.0, y);
+            translated = true;
+        }
+    }
+
+    if (translated) {
+        m_envelopesDirty = true;
+    }
+}
+
 double SkylineLine::top(double startX, double endX)
 {
     double top = DBL_MAX;
@@ -52,7 +52,14 @@ public:
     void add(const Shape& s);
 
     template<typename Predicate>
-    inline bool remove_if(Predicate p) { return m_shape.remove_if(p); }
+    inline bool remove_if(Predicate p)
+    {
+        if (!m_shape.remove_if(p)) {
+            return false;
+        }
+        m_envelopesDirty = true;
+        return true;
+    }
     SkylineLine getFilteredCopy(std::function<bool(const ShapeElement&)> filterOut) const;
 
     void clear();
@@ -67,6 +74,7 @@ public:
     bool valid() const;
 
     SkylineLine& translateY(double y);
+    void translateY(const EngravingItem* item, double y);
 
     double top(double startX = -DBL_MAX, double endX = DBL_MAX);
     double bottom(double startX = -DBL_MAX, double endX = DBL_MAX);
@@ -74,9 +82,48 @@ public:
     bool isNorth() const { return m_isNorth; }
 
     const std::vector<ShapeElement>& elements() const { return m_shape.elements(); }
-    std::vector<ShapeElement>& elements() { return m_shape.elements(); }
 
 private:
+    //! NOTE Piecewise constant outline of the elements: the lowest top (or the highest bottom)
+    //! of the elements covering each open interval between two sorted x breakpoints.
+    //! The last step has no value and runs to the infinity
+    class Envelope
+    {
+    public:
+        struct Step {
+            double x = 0.0;
+            double value = 0.0;
+        };
+
+        Envelope(bool lowest)
+            : m_lowest(lowest) {}
+
+        void add(double left, double right, double value);
+        void clear() { m_steps.clear(); }
+        void translateY(double y);
+
+        double noValue() const { return m_lowest ? DBL_MAX : -DBL_MAX; }
+        const std::vector<Step>& steps() const { return m_steps; }
+
+        //! NOTE Index of the first step which ends after x
+        size_t stepEndingAfter(double x) const;
+
+    private:
+        size_t split(double x);
+
+        bool m_lowest = true;
+        std::vector<Step> m_steps;
+    };
+
+    void addToEnvelopes(const ShapeElement& r) const;
+    void rebuildEnvelopes() const;
+    const Envelope& tops() const;
+    const Envelope& bottoms() const;
+
+    static double minDistance(const Envelope& bottoms, const Envelope& tops, double minHorizontalClearance);
+    static double minDistance(const Shape& shapeAbove, const Envelope& tops, double minHorizontalClearance);
+    static double minDistance(const Envelope& bottoms, const Shape& shapeBelow, double minHorizontalClearance);
+
     double staffLinesTopAtX(double x) const;
     double staffLinesBottomAtX(double x) const;
 
@@ -84,6 +131,13 @@ private:
     const bool m_isNorth;
     Shape m_shape;
 
+    //! NOTE Kept up to date on every addition to the shape, so the distance queries
+    //! are a sweep over the steps instead of a test of every pair of elements.
+    //! Moving or removing elements only marks them dirty, they are rebuilt on the next query
+    mutable Envelope m_tops = Envelope(true);
+    mutable Envelope m_bottoms = Envelope(false);
+    mutable bool m_envelopesDirty = false;
+
     struct StaffLineEdge {
         double top = 0.0;
         double bottom = 0.0;
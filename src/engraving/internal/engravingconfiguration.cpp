@@ -47,6 +47,10 @@ static const Settings::Key INVERT_SCORE_COLOR("engraving", "engraving/scoreColor
 
 static const Settings::Key DYNAMICS_APPLY_TO_ALL_VOICES("engraving", "score/dynamicsApplyToAllVoices");
 
+static const Settings::Key UNDO_HISTORY_MEMORY_LIMIT("engraving", "engraving/undo/memoryLimitMb");
+
+static const Settings::Key PARALLEL_PARTS_LAYOUT("engraving", "engraving/layout/parallelParts");
+
 struct VoiceColor {
     Settings::Key key;
     Color color;
@@ -101,6 +105,12 @@ void EngravingConfiguration::init()
     VOICE_COLORS[ALL_VOICES_IDX] = VoiceColor { std::move(key), currentColor };
 
     settings()->setDefaultValue(DYNAMICS_APPLY_TO_ALL_VOICES, Val(true));
+
+    settings()->setDefaultValue(UNDO_HISTORY_MEMORY_LIMIT, Val(512));
+    settings()->setDescription(UNDO_HISTORY_MEMORY_LIMIT, muse::qtrc("engraving", "Undo history memory limit (MB), 0 for no limit").toStdString());
+    settings()->setCanBeManuallyEdited(UNDO_HISTORY_MEMORY_LIMIT, true, Val(0), Val(16384));
+
+    settings()->setDefaultValue(PARALLEL_PARTS_LAYOUT, Val(false));
 }
 
 muse::io::path_t EngravingConfiguration::appDataPath() const
@@ -317,6 +327,26 @@ bool EngravingConfiguration::isAccessibleEnabled() const
     return accessibilityConfiguration() ? accessibilityConfiguration()->enabled() : false;
 }
 
+int EngravingConfiguration::undoHistoryMemoryLimitMb() const
+{
+    return settings()->value(UNDO_HISTORY_MEMORY_LIMIT).toInt();
+}
+
+void EngravingConfiguration::setUndoHistoryMemoryLimitMb(int limit)
+{
+    settings()->setSharedValue(UNDO_HISTORY_MEMORY_LIMIT, Val(limit));
+}
+
+bool EngravingConfiguration::isParallelPartsLayoutEnabled() const
+{
+    return settings()->value(PARALLEL_PARTS_LAYOUT).toBool();
+}
+
+void EngravingConfiguration::setParallelPartsLayoutEnabled(bool enabled)
+{
+    settings()->setSharedValue(PARALLEL_PARTS_LAYOUT, Val(enabled));
+}
+
 bool EngravingConfiguration::guitarProImportExperimental() const
 {
     return guitarProConfiguration() ? guitarProConfiguration()->experimental() : false;
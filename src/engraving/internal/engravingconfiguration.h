@@ -94,6 +94,12 @@ public:
 
     bool isAccessibleEnabled() const override;
 
+    int undoHistoryMemoryLimitMb() const override;
+    void setUndoHistoryMemoryLimitMb(int limit) override;
+
+    bool isParallelPartsLayoutEnabled() const override;
+    void setParallelPartsLayoutEnabled(bool enabled) override;
+
     bool guitarProImportExperimental() const override;
     bool negativeFretsAllowed() const override;
     bool crossNoteHeadAlwaysBlack() const override;
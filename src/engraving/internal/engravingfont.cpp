@@ -21,6 +21,8 @@
  */
 #include "engravingfont.h"
 
+#include "engravingfontmetricscache.h"
+
 #include "serialization/json.h"
 #include "io/file.h"
 #include "io/fileinfo.h"
@@ -55,11 +57,14 @@ EngravingFont::EngravingFont(const std::string& name, const std::string& family,
 EngravingFont::EngravingFont(const EngravingFont& other)
     : muse::Injectable(other.iocContext())
 {
+    std::shared_lock lock(other.m_shapesMutex);
+
     m_loaded = false;
     m_symbols  = other.m_symbols;
     m_name     = other.m_name;
     m_family   = other.m_family;
     m_fontPath = other.m_fontPath;
+    m_metricsCacheDir = other.m_metricsCacheDir;
 }
 
 // =============================================
@@ -92,7 +97,12 @@ double EngravingFont::textEnclosureThickness()
 
 void EngravingFont::ensureLoad()
 {
-    if (m_loaded) {
+    if (m_loaded.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard loadLock(m_loadMutex);
+    if (m_loaded.load(std::memory_order_relaxed)) {
         return;
     }
 
@@ -107,6 +117,36 @@ void EngravingFont::ensureLoad()
     m_font.setNoFontMerging(true);
     m_font.setHinting(Font::Hinting::PreferVerticalHinting);
 
+    const path_t metadataPath = FileInfo(m_fontPath).path() + u"/metadata.json";
+
+    //! NOTE The metrics don't change as long as the font and its metadata don't,
+    //! so they are loaded from the cache if possible instead of being computed again
+    EngravingFontMetricsCache metricsCache(m_metricsCacheDir);
+    ByteArray metricsStamp;
+    ByteArray metricsKey;
+    if (!m_metricsCacheDir.empty()) {
+        //! NOTE The files are only hashed when their stamp doesn't match the stored one
+        metricsStamp = metricsCache.fileStamp(m_fontPath, metadataPath);
+        metricsKey = metricsCache.storedKey(m_name, metricsStamp);
+
+        const bool stampMatches = !metricsKey.empty();
+        if (!stampMatches) {
+            metricsKey = metricsCache.contentKey(m_fontPath, metadataPath);
+        }
+
+        if (!metricsKey.empty() && loadCachedMetrics(metricsCache, metricsKey)) {
+            if (!stampMatches) {
+                //! NOTE The files were touched but their content is the same, the new stamp is stored
+                storeCachedMetrics(metricsCache, metricsStamp, metricsKey);
+            }
+
+            loadComposedGlyphs();
+            m_engravingDefaults.insert({ Sid::MusicalTextFont, String(u"%1 Text").arg(String::fromStdString(m_family)) });
+            m_loaded.store(true, std::memory_order_release);
+            return;
+        }
+    }
+
     for (size_t id = 0; id < m_symbols.size(); ++id) {
         Smufl::Code code = Smufl::code(static_cast<SymId>(id));
         if (!code.isValid()) {
@@ -116,7 +156,7 @@ void EngravingFont::ensureLoad()
         computeMetrics(sym, code);
     }
 
-    File metadataFile(FileInfo(m_fontPath).path() + u"/metadata.json");
+    File metadataFile(metadataPath);
     if (!metadataFile.open(IODevice::ReadOnly)) {
         LOGE() << "Failed to open glyph metadata file: " << metadataFile.filePath();
         return;
@@ -134,7 +174,63 @@ void EngravingFont::ensureLoad()
     loadStylisticAlternates(metadataJson.value("glyphsWithAlternates").toObject());
     loadEngravingDefaults(metadataJson.value("engravingDefaults").toObject());
 
-    m_loaded = true;
+    if (!metricsKey.empty()) {
+        storeCachedMetrics(metricsCache, metricsStamp, metricsKey);
+    }
+
+    m_engravingDefaults.insert({ Sid::MusicalTextFont, String(u"%1 Text").arg(String::fromStdString(m_family)) });
+
+    m_loaded.store(true, std::memory_order_release);
+}
+
+void EngravingFont::setMetricsCacheDir(const path_t& dir)
+{
+    m_metricsCacheDir = dir;
+}
+
+bool EngravingFont::loadCachedMetrics(const EngravingFontMetricsCache& cache, const ByteArray& key)
+{
+    EngravingFontMetricsCache::Metrics metrics;
+    if (!cache.load(m_name, key, metrics) || metrics.symbols.size() != m_symbols.size()) {
+        return false;
+    }
+
+    for (size_t id = 0; id < m_symbols.size(); ++id) {
+        EngravingFontMetricsCache::SymMetrics& cached = metrics.symbols[id];
+        Sym& sym = m_symbols[id];
+        sym.code = cached.code;
+        sym.bbox = cached.bbox;
+        sym.advance = cached.advance;
+        sym.smuflAnchors = std::move(cached.smuflAnchors);
+    }
+
+    m_engravingDefaults = std::move(metrics.engravingDefaults);
+    m_textEnclosureThickness = metrics.textEnclosureThickness;
+
+    return true;
+}
+
+void EngravingFont::storeCachedMetrics(const EngravingFontMetricsCache& cache, const ByteArray& stamp, const ByteArray& key) const
+{
+    EngravingFontMetricsCache::Metrics metrics;
+    metrics.symbols.resize(m_symbols.size());
+
+    for (size_t id = 0; id < m_symbols.size(); ++id) {
+        const Sym& sym = m_symbols[id];
+        EngravingFontMetricsCache::SymMetrics& cached = metrics.symbols[id];
+        cached.code = sym.code;
+        cached.bbox = sym.bbox;
+        cached.advance = sym.advance;
+        cached.smuflAnchors = sym.smuflAnchors;
+    }
+
+    metrics.engravingDefaults = m_engravingDefaults;
+    metrics.textEnclosureThickness = m_textEnclosureThickness;
+
+    Ret ret = cache.store(m_name, stamp, key, metrics);
+    if (!ret) {
+        LOGW() << "failed write font metrics cache for " << m_name << ", err: " << ret.toString();
+    }
 }
 
 void EngravingFont::loadGlyphsWithAnchors(const JsonObject& glyphsWithAnchors)
@@ -495,8 +591,6 @@ void EngravingFont::loadEngravingDefaults(const JsonObject& engravingDefaultsObj
 
         applyEngravingDefault(key, engravingDefaultsObject.value(key).toDouble());
     }
-
-    m_engravingDefaults.insert({ Sid::MusicalTextFont, String(u"%1 Text").arg(String::fromStdString(m_family)) });
 }
 
 void EngravingFont::computeMetrics(EngravingFont::Sym& sym, const Smufl::Code& code)
@@ -617,12 +711,25 @@ Shape EngravingFont::shapeWithCutouts(SymId id, double mag)
 
 Shape EngravingFont::shapeWithCutouts(SymId id, const SizeF& mag)
 {
-    Shape& shape = sym(id).shapeWithCutouts;
-    if (shape.empty()) {
-        constructShapeWithCutouts(shape, id);
+    {
+        std::shared_lock lock(m_shapesMutex);
+        const Shape& shape = sym(id).shapeWithCutouts;
+        if (!shape.empty()) {
+            return shape.scaled(mag);
+        }
+    }
+
+    //! NOTE Built outside of the lock, only from the metrics
+    Shape shape;
+    constructShapeWithCutouts(shape, id);
+
+    std::unique_lock lock(m_shapesMutex);
+    Shape& cached = sym(id).shapeWithCutouts;
+    if (cached.empty()) {
+        cached = shape;
     }
 
-    return shape.scaled(mag);
+    return cached.scaled(mag);
 }
 
 void EngravingFont::constructShapeWithCutouts(Shape& shape, SymId id)
@@ -767,9 +874,10 @@ void EngravingFont::draw(SymId id, Painter* painter, const SizeF& mag, const Poi
 
     painter->save();
     double size = 20.0 * MScore::pixelRatio;
-    m_font.setPointSizeF(size);
+    Font font = m_font;
+    font.setPointSizeF(size);
     painter->scale(mag.width(), mag.height());
-    painter->setFont(m_font);
+    painter->setFont(font);
     if (angle != 0) {
         const double _width = sym.bbox.width() / 2;
         const double _height = sym.bbox.height() / 2;
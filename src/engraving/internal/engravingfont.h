@@ -22,6 +22,9 @@
 #ifndef MU_ENGRAVING_ENGRAVINGFONT_H
 #define MU_ENGRAVING_ENGRAVINGFONT_H
 
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 
 #include "iengravingfont.h"
@@ -31,6 +34,7 @@
 #include "iengravingfontsprovider.h"
 
 #include "io/path.h"
+#include "types/bytearray.h"
 
 #include "infrastructure/smufl.h"
 #include "infrastructure/shape.h"
@@ -48,6 +52,7 @@ class Painter;
 
 namespace mu::engraving {
 class Shape;
+class EngravingFontMetricsCache;
 
 class EngravingFont : public IEngravingFont, public muse::Injectable
 {
@@ -95,6 +100,8 @@ public:
 
     void ensureLoad();
 
+    void setMetricsCacheDir(const muse::io::path_t& dir);
+
 private:
 
     friend class SymbolFonts;
@@ -125,6 +132,9 @@ private:
     void loadEngravingDefaults(const muse::JsonObject& engravingDefaultsObject);
     void computeMetrics(Sym& sym, const Smufl::Code& code);
 
+    bool loadCachedMetrics(const EngravingFontMetricsCache& cache, const muse::ByteArray& key);
+    void storeCachedMetrics(const EngravingFontMetricsCache& cache, const muse::ByteArray& stamp, const muse::ByteArray& key) const;
+
     void constructShapeWithCutouts(Shape& shape, SymId id);
 
     Sym& sym(SymId id);
@@ -132,13 +142,19 @@ private:
 
     bool useFallbackFont(SymId id) const;
 
-    bool m_loaded = false;
+    //! NOTE The metrics are immutable after load, so they can be read from several threads.
+    //! Only the lazily built shapes with cutouts are guarded
+    std::atomic<bool> m_loaded = false;
+    std::mutex m_loadMutex;
+    mutable std::shared_mutex m_shapesMutex;
+
     std::vector<Sym> m_symbols;
-    mutable muse::draw::Font m_font;
+    muse::draw::Font m_font;
 
     std::string m_name;
     std::string m_family;
     muse::io::path_t m_fontPath;
+    muse::io::path_t m_metricsCacheDir;
 
     std::unordered_map<Sid, PropertyValue> m_engravingDefaults;
     double m_textEnclosureThickness = 0;
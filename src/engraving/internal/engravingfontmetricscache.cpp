@@ -0,0 +1,408 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "engravingfontmetricscache.h"
+
+#include <cctype>
+#include <cstring>
+
+#include "dom/mscore.h"
+#include "infrastructure/smufl.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace muse::io;
+using namespace mu::engraving;
+
+static const char CACHE_MAGIC[4] = { 'M', 'S', 'F', 'M' };
+static constexpr uint32_t CACHE_VERSION = 2;
+
+enum class DefaultValueType : uint8_t {
+    Real,
+    Bool
+};
+
+namespace {
+struct ReadBuffer {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t pos = 0;
+};
+}
+
+template<typename T>
+static void writeValue(ByteArray& out, const T& val)
+{
+    out.push_back(reinterpret_cast<const uint8_t*>(&val), sizeof(T));
+}
+
+template<typename T>
+static bool readValue(ReadBuffer& in, T& val)
+{
+    if (in.pos + sizeof(T) > in.size) {
+        return false;
+    }
+
+    std::memcpy(&val, in.data + in.pos, sizeof(T));
+    in.pos += sizeof(T);
+    return true;
+}
+
+static void writeSym(ByteArray& out, uint32_t idx, const EngravingFontMetricsCache::SymMetrics& sym)
+{
+    writeValue(out, idx);
+    writeValue(out, static_cast<uint32_t>(sym.code));
+    writeValue(out, sym.bbox.x());
+    writeValue(out, sym.bbox.y());
+    writeValue(out, sym.bbox.width());
+    writeValue(out, sym.bbox.height());
+    writeValue(out, sym.advance);
+    writeValue(out, static_cast<uint8_t>(sym.smuflAnchors.size()));
+
+    for (const auto& pair : sym.smuflAnchors) {
+        writeValue(out, static_cast<uint8_t>(pair.first));
+        writeValue(out, pair.second.x());
+        writeValue(out, pair.second.y());
+    }
+}
+
+static bool readSym(ReadBuffer& in, EngravingFontMetricsCache::SymMetrics& sym)
+{
+    uint32_t code = 0;
+    double x = 0.0;
+    double y = 0.0;
+    double width = 0.0;
+    double height = 0.0;
+    uint8_t anchorCount = 0;
+
+    bool ok = readValue(in, code) && readValue(in, x) && readValue(in, y) && readValue(in, width) && readValue(in, height)
+              && readValue(in, sym.advance) && readValue(in, anchorCount);
+    if (!ok) {
+        return false;
+    }
+
+    sym.code = static_cast<char32_t>(code);
+    sym.bbox = RectF(x, y, width, height);
+    sym.smuflAnchors.clear();
+
+    for (uint8_t i = 0; i < anchorCount; ++i) {
+        uint8_t anchorId = 0;
+        double anchorX = 0.0;
+        double anchorY = 0.0;
+        if (!readValue(in, anchorId) || !readValue(in, anchorX) || !readValue(in, anchorY)) {
+            return false;
+        }
+
+        if (anchorId > static_cast<uint8_t>(SmuflAnchorId::opticalCenter)) {
+            return false;
+        }
+
+        sym.smuflAnchors[static_cast<SmuflAnchorId>(anchorId)] = PointF(anchorX, anchorY);
+    }
+
+    return true;
+}
+
+//! NOTE The metrics also depend on the codes the SymIds are looked up by,
+//! on the resolution they are computed at and on the font engine that computes them
+static ByteArray symCodeTable()
+{
+    ByteArray table;
+    table.reserve((static_cast<size_t>(SymId::lastSym) + 1) * 2 * sizeof(uint32_t) + 16);
+    for (size_t id = 0; id <= static_cast<size_t>(SymId::lastSym); ++id) {
+        Smufl::Code code = Smufl::code(static_cast<SymId>(id));
+        writeValue(table, static_cast<uint32_t>(code.smuflCode));
+        writeValue(table, static_cast<uint32_t>(code.musicSymBlockCode));
+    }
+
+    writeValue(table, DPI_F);
+#ifdef MUSE_MODULE_DRAW_USE_QTFONTMETRICS
+    writeValue(table, uint8_t(1));
+#else
+    writeValue(table, uint8_t(0));
+#endif
+
+    return table;
+}
+
+//! NOTE Reads the stamp and the key, the buffer is left at the metrics
+static bool readHeader(ReadBuffer& in, ReadBuffer& stamp, ReadBuffer& key)
+{
+    char magic[4] = {};
+    uint32_t version = 0;
+
+    bool ok = readValue(in, magic) && readValue(in, version);
+    if (!ok || std::memcmp(magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || version != CACHE_VERSION) {
+        return false;
+    }
+
+    for (ReadBuffer* blob : { &stamp, &key }) {
+        uint32_t size = 0;
+        if (!readValue(in, size) || in.pos + size > in.size) {
+            return false;
+        }
+
+        *blob = ReadBuffer { in.data + in.pos, size };
+        in.pos += size;
+    }
+
+    return true;
+}
+
+static bool equals(const ReadBuffer& blob, const ByteArray& data)
+{
+    return blob.size == data.size() && std::memcmp(blob.data, data.constData(), blob.size) == 0;
+}
+
+EngravingFontMetricsCache::EngravingFontMetricsCache(const io::path_t& cacheDir)
+    : m_cacheDir(cacheDir)
+{
+}
+
+ByteArray EngravingFontMetricsCache::fileStamp(const io::path_t& fontPath, const io::path_t& metadataPath) const
+{
+    ByteArray stamp;
+
+    for (const io::path_t& path : { fontPath, metadataPath }) {
+        RetVal<uint64_t> size = fileSystem()->fileSize(path);
+        if (!size.ret) {
+            return ByteArray();
+        }
+
+        std::string modified = fileSystem()->lastModified(path).toString().toStdString();
+
+        writeValue(stamp, size.val);
+        writeValue(stamp, static_cast<uint32_t>(modified.size()));
+        stamp.push_back(reinterpret_cast<const uint8_t*>(modified.data()), modified.size());
+    }
+
+    stamp.push_back(cryptographicHash()->hash(symCodeTable(), ICryptographicHash::Algorithm::Md4));
+
+    return stamp;
+}
+
+ByteArray EngravingFontMetricsCache::contentKey(const io::path_t& fontPath, const io::path_t& metadataPath) const
+{
+    TRACEFUNC;
+
+    RetVal<ByteArray> fontData = fileSystem()->readFile(fontPath);
+    if (!fontData.ret) {
+        return ByteArray();
+    }
+
+    RetVal<ByteArray> metadata = fileSystem()->readFile(metadataPath);
+    if (!metadata.ret) {
+        return ByteArray();
+    }
+
+    ByteArray key;
+    key.push_back(cryptographicHash()->hash(fontData.val, ICryptographicHash::Algorithm::Md4));
+    key.push_back(cryptographicHash()->hash(metadata.val, ICryptographicHash::Algorithm::Md4));
+    key.push_back(cryptographicHash()->hash(symCodeTable(), ICryptographicHash::Algorithm::Md4));
+
+    return key;
+}
+
+ByteArray EngravingFontMetricsCache::storedKey(const std::string& fontName, const ByteArray& stamp) const
+{
+    io::path_t path = cacheFilePath(fontName);
+    if (stamp.empty() || !fileSystem()->exists(path)) {
+        return ByteArray();
+    }
+
+    RetVal<FileMappingPtr> mapping = fileSystem()->mapFile(path);
+    if (!mapping.ret) {
+        return ByteArray();
+    }
+
+    ReadBuffer in { mapping.val->data(), mapping.val->size() };
+    ReadBuffer storedStamp;
+    ReadBuffer key;
+
+    if (!readHeader(in, storedStamp, key) || !equals(storedStamp, stamp)) {
+        return ByteArray();
+    }
+
+    return ByteArray(key.data, key.size);
+}
+
+bool EngravingFontMetricsCache::load(const std::string& fontName, const ByteArray& key, Metrics& metrics) const
+{
+    TRACEFUNC;
+
+    io::path_t path = cacheFilePath(fontName);
+    if (key.empty() || !fileSystem()->exists(path)) {
+        return false;
+    }
+
+    RetVal<FileMappingPtr> mapping = fileSystem()->mapFile(path);
+    if (!mapping.ret) {
+        LOGW() << "failed map font metrics cache: " << path << ", err: " << mapping.ret.toString();
+        return false;
+    }
+
+    ReadBuffer in { mapping.val->data(), mapping.val->size() };
+    ReadBuffer cachedStamp;
+    ReadBuffer cachedKey;
+
+    if (!readHeader(in, cachedStamp, cachedKey)) {
+        return false;
+    }
+
+    if (!equals(cachedKey, key)) {
+        //! NOTE The font has changed, the cache will be rewritten
+        return false;
+    }
+
+    uint32_t symbolsSize = 0;
+    uint32_t symCount = 0;
+    if (!readValue(in, symbolsSize) || !readValue(in, symCount)) {
+        return false;
+    }
+
+    Metrics result;
+    result.symbols.resize(symbolsSize);
+
+    for (uint32_t i = 0; i < symCount; ++i) {
+        uint32_t idx = 0;
+        if (!readValue(in, idx) || idx >= symbolsSize || !readSym(in, result.symbols[idx])) {
+            LOGW() << "font metrics cache is corrupted: " << path;
+            return false;
+        }
+    }
+
+    uint32_t defaultCount = 0;
+    if (!readValue(in, defaultCount)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < defaultCount; ++i) {
+        int32_t sid = 0;
+        uint8_t type = 0;
+        double value = 0.0;
+        if (!readValue(in, sid) || !readValue(in, type) || !readValue(in, value)) {
+            LOGW() << "font metrics cache is corrupted: " << path;
+            return false;
+        }
+
+        if (sid < 0 || sid >= static_cast<int32_t>(Sid::STYLES)) {
+            return false;
+        }
+
+        switch (static_cast<DefaultValueType>(type)) {
+        case DefaultValueType::Real:
+            result.engravingDefaults.insert({ static_cast<Sid>(sid), value });
+            break;
+        case DefaultValueType::Bool:
+            result.engravingDefaults.insert({ static_cast<Sid>(sid), value != 0.0 });
+            break;
+        default:
+            return false;
+        }
+    }
+
+    if (!readValue(in, result.textEnclosureThickness)) {
+        return false;
+    }
+
+    metrics = std::move(result);
+    return true;
+}
+
+Ret EngravingFontMetricsCache::store(const std::string& fontName, const ByteArray& stamp, const ByteArray& key,
+                                     const Metrics& metrics) const
+{
+    TRACEFUNC;
+
+    ByteArray out;
+    out.push_back(reinterpret_cast<const uint8_t*>(CACHE_MAGIC), sizeof(CACHE_MAGIC));
+    writeValue(out, CACHE_VERSION);
+    writeValue(out, static_cast<uint32_t>(stamp.size()));
+    out.push_back(stamp);
+    writeValue(out, static_cast<uint32_t>(key.size()));
+    out.push_back(key);
+
+    //! NOTE Only the symbols that have something to restore are written
+    std::vector<uint32_t> cachedSyms;
+    for (size_t idx = 0; idx < metrics.symbols.size(); ++idx) {
+        const SymMetrics& sym = metrics.symbols.at(idx);
+        if (sym.code != 0 || !sym.smuflAnchors.empty()) {
+            cachedSyms.push_back(static_cast<uint32_t>(idx));
+        }
+    }
+
+    writeValue(out, static_cast<uint32_t>(metrics.symbols.size()));
+    writeValue(out, static_cast<uint32_t>(cachedSyms.size()));
+    for (uint32_t idx : cachedSyms) {
+        writeSym(out, idx, metrics.symbols.at(idx));
+    }
+
+    std::vector<std::pair<Sid, const PropertyValue*> > defaults;
+    for (const auto& pair : metrics.engravingDefaults) {
+        P_TYPE type = pair.second.type();
+        if (type == P_TYPE::REAL || type == P_TYPE::BOOL) {
+            defaults.emplace_back(pair.first, &pair.second);
+        }
+    }
+
+    writeValue(out, static_cast<uint32_t>(defaults.size()));
+    for (const auto& pair : defaults) {
+        writeValue(out, static_cast<int32_t>(pair.first));
+        if (pair.second->type() == P_TYPE::BOOL) {
+            writeValue(out, static_cast<uint8_t>(DefaultValueType::Bool));
+            writeValue(out, pair.second->toBool() ? 1.0 : 0.0);
+        } else {
+            writeValue(out, static_cast<uint8_t>(DefaultValueType::Real));
+            writeValue(out, pair.second->toReal());
+        }
+    }
+
+    writeValue(out, metrics.textEnclosureThickness);
+
+    Ret ret = fileSystem()->makePath(m_cacheDir);
+    if (!ret) {
+        return ret;
+    }
+
+    //! NOTE Write aside and move over, so that a cache mapped by another instance is never truncated
+    io::path_t path = cacheFilePath(fontName);
+    io::path_t tmpPath = path + ".tmp";
+
+    ret = fileSystem()->writeFile(tmpPath, out);
+    if (!ret) {
+        return ret;
+    }
+
+    return fileSystem()->move(tmpPath, path, true);
+}
+
+io::path_t EngravingFontMetricsCache::cacheFilePath(const std::string& fontName) const
+{
+    std::string name = fontName;
+    for (char& ch : name) {
+        if (!std::isalnum(static_cast<unsigned char>(ch))) {
+            ch = '_';
+        }
+    }
+
+    return m_cacheDir + "/" + name + ".metricscache";
+}
@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_ENGRAVINGFONTMETRICSCACHE_H
+#define MU_ENGRAVING_ENGRAVINGFONTMETRICSCACHE_H
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "modularity/ioc.h"
+#include "global/icryptographichash.h"
+#include "io/ifilesystem.h"
+#include "io/path.h"
+#include "types/bytearray.h"
+#include "types/ret.h"
+
+#include "draw/types/geometry.h"
+
+#include "style/styledef.h"
+#include "types/symid.h"
+
+namespace mu::engraving {
+//! NOTE Binary cache of the symbol metrics of an engraving font
+//! Computing them means asking the font engine about every SymId and parsing metadata.json,
+//! the cache lets the next start skip both. There is one file per font in the cache dir,
+//! it's keyed by a hash of everything the metrics are computed from
+//! and is simply rewritten when the key doesn't match anymore.
+//! The key is stored along with a stamp of the files, so they are only hashed when they look changed
+class EngravingFontMetricsCache
+{
+    muse::GlobalInject<muse::io::IFileSystem> fileSystem;
+    muse::GlobalInject<muse::ICryptographicHash> cryptographicHash;
+
+public:
+    struct SymMetrics {
+        char32_t code = 0;
+        muse::RectF bbox;
+        double advance = 0.0;
+        std::map<SmuflAnchorId, muse::PointF> smuflAnchors;
+    };
+
+    struct Metrics {
+        //! NOTE Indexed by SymId
+        std::vector<SymMetrics> symbols;
+
+        //! NOTE Only the real and bool values are cached
+        std::unordered_map<Sid, PropertyValue> engravingDefaults;
+        double textEnclosureThickness = 0.0;
+    };
+
+    EngravingFontMetricsCache(const muse::io::path_t& cacheDir);
+
+    //! NOTE Size and modification time of the font file and its metadata, and a hash of the SymId to code table.
+    //! Returns an empty stamp if the files don't exist
+    muse::ByteArray fileStamp(const muse::io::path_t& fontPath, const muse::io::path_t& metadataPath) const;
+
+    //! NOTE Hash of the font file, its metadata and the SymId to code table.
+    //! Returns an empty key if the files can't be read
+    muse::ByteArray contentKey(const muse::io::path_t& fontPath, const muse::io::path_t& metadataPath) const;
+
+    //! NOTE The key stored along with the given stamp, an empty one if the stamp doesn't match
+    muse::ByteArray storedKey(const std::string& fontName, const muse::ByteArray& stamp) const;
+
+    bool load(const std::string& fontName, const muse::ByteArray& key, Metrics& metrics) const;
+    muse::Ret store(const std::string& fontName, const muse::ByteArray& stamp, const muse::ByteArray& key, const Metrics& metrics) const;
+
+    muse::io::path_t cacheFilePath(const std::string& fontName) const;
+
+private:
+    muse::io::path_t m_cacheDir;
+};
+}
+
+#endif // MU_ENGRAVING_ENGRAVINGFONTMETRICSCACHE_H
@@ -37,7 +37,10 @@ EngravingFontsProvider::EngravingFontsProvider(const muse::modularity::ContextPt
 void EngravingFontsProvider::addFont(const std::string& name, const std::string& family, const muse::io::path_t& filePath)
 {
     std::shared_ptr<EngravingFont> f = std::make_shared<EngravingFont>(name, family, filePath, iocContext());
+    f->setMetricsCacheDir(m_metricsCacheDir);
     m_symbolFonts.push_back(f);
+
+    std::lock_guard lock(m_fallbackMutex);
     m_fallback.font = nullptr;
 }
 
@@ -74,12 +77,14 @@ std::vector<IEngravingFontPtr> EngravingFontsProvider::fonts() const
 
 void EngravingFontsProvider::setFallbackFont(const std::string& name)
 {
+    std::lock_guard lock(m_fallbackMutex);
     m_fallback.name = name;
     m_fallback.font = nullptr;
 }
 
 std::shared_ptr<EngravingFont> EngravingFontsProvider::doFallbackFont() const
 {
+    std::lock_guard lock(m_fallbackMutex);
     if (!m_fallback.font) {
         m_fallback.font = doFontByName(m_fallback.name);
         IF_ASSERT_FAILED(m_fallback.font) {
@@ -108,3 +113,12 @@ void EngravingFontsProvider::loadAllFonts()
         f->ensureLoad();
     }
 }
+
+void EngravingFontsProvider::setMetricsCacheDir(const muse::io::path_t& dir)
+{
+    m_metricsCacheDir = dir;
+
+    for (std::shared_ptr<EngravingFont>& f : m_symbolFonts) {
+        f->setMetricsCacheDir(dir);
+    }
+}
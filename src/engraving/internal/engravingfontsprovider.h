@@ -23,6 +23,7 @@
 #ifndef MU_ENGRAVING_ENGRAVINGFONTSPROVIDER_H
 #define MU_ENGRAVING_ENGRAVINGFONTSPROVIDER_H
 
+#include <mutex>
 #include <vector>
 
 #include "iengravingfontsprovider.h"
@@ -48,6 +49,9 @@ public:
 
     void loadAllFonts() override;
 
+    //! NOTE The symbol metrics of the fonts are cached there, see EngravingFontMetricsCache
+    void setMetricsCacheDir(const muse::io::path_t& dir);
+
 private:
 
     std::shared_ptr<EngravingFont> doFontByName(const std::string& name) const;
@@ -58,8 +62,10 @@ private:
         std::shared_ptr<EngravingFont> font;
     };
 
+    mutable std::mutex m_fallbackMutex;
     mutable Fallback m_fallback;
     std::vector<std::shared_ptr<EngravingFont> > m_symbolFonts;
+    muse::io::path_t m_metricsCacheDir;
 };
 }
 
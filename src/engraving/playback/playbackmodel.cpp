@@ -49,6 +49,22 @@ static const String CHORD_SYMBOLS_INSTRUMENT_ID(u"chord_symbols");
 
 const InstrumentTrackId PlaybackModel::METRONOME_TRACK_ID = { 999, METRONOME_INSTRUMENT_ID };
 
+static PlaybackEventsMap eventsWithinRanges(const PlaybackEventsMap& events, const TimestampRangeList& ranges)
+{
+    PlaybackEventsMap result;
+
+    for (const TimestampRange& range : ranges) {
+        auto it = events.lower_bound(range.from);
+        auto end = events.upper_bound(range.to);
+
+        for (; it != end; ++it) {
+            result.insert(result.end(), *it);
+        }
+    }
+
+    return result;
+}
+
 static const Harmony* findChordSymbol(const EngravingItem* item)
 {
     if (item->isHarmony()) {
@@ -528,6 +544,11 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
             m_renderer.renderMetronome(m_score, measureStartTick, measureEndTick, tickPositionOffset,
                                        m_playbackDataMap[METRONOME_TRACK_ID].originEvents);
             collectChangesTracks(METRONOME_TRACK_ID, trackChanges);
+
+            if (trackChanges) {
+                addChangedRange(timestampFromTicks(m_score, measureStartTick + tickPositionOffset),
+                                timestampFromTicks(m_score, measureEndTick + tickPositionOffset));
+            }
         }
     }
 }
@@ -700,6 +721,9 @@ void PlaybackModel::clearExpiredEvents(const int tickFrom, const int tickTo, con
 {
     TRACEFUNC;
 
+    m_changedRanges.clear();
+    m_allEventsChanged = true;
+
     if (!m_score) {
         return;
     }
@@ -730,7 +754,10 @@ void PlaybackModel::clearExpiredEvents(const int tickFrom, const int tickTo, con
         timestamp_t removeEventsTo = timestampFromTicks(m_score, removeEventsToTick + tickPositionOffset);
 
         removeEventsFromRange(trackFrom, trackTo, removeEventsFrom, removeEventsTo);
+        addChangedRange(removeEventsFrom, removeEventsTo);
     }
+
+    m_allEventsChanged = false;
 }
 
 void PlaybackModel::collectChangesTracks(const InstrumentTrackId& trackId, ChangedTrackIdSet* result)
@@ -751,9 +778,19 @@ void PlaybackModel::notifyAboutChanges(const InstrumentTrackIdSet& oldTracks, co
             continue;
         }
 
-        search->second.mainStream.send(search->second.originEvents, search->second.dynamics, search->second.params);
+        const PlaybackData& trackData = search->second;
+
+        if (m_allEventsChanged) {
+            trackData.mainStream.send(trackData.originEvents, trackData.dynamics, trackData.params);
+        } else {
+            trackData.mainStreamRanges.send(m_changedRanges, eventsWithinRanges(trackData.originEvents, m_changedRanges),
+                                            trackData.dynamics, trackData.params);
+        }
     }
 
+    m_changedRanges.clear();
+    m_allEventsChanged = false;
+
     for (auto it = m_playbackDataMap.cbegin(); it != m_playbackDataMap.cend(); ++it) {
         if (!muse::contains(oldTracks, it->first)) {
             m_trackAdded.send(it->first);
@@ -802,6 +839,25 @@ void PlaybackModel::removeTrackEvents(const InstrumentTrackId& trackId, const mu
     }
 }
 
+void PlaybackModel::addChangedRange(timestamp_t timestampFrom, const timestamp_t timestampTo)
+{
+    if (timestampFrom == 0) {
+        //!Note See removeTrackEvents: the events started right before the start of the track are removed as well
+        timestampFrom = std::numeric_limits<timestamp_t>::min();
+    }
+
+    if (!m_changedRanges.empty()) {
+        TimestampRange& last = m_changedRanges.back();
+
+        if (timestampFrom >= last.from && timestampFrom <= last.to) {
+            last.to = std::max(last.to, timestampTo);
+            return;
+        }
+    }
+
+    m_changedRanges.push_back({ timestampFrom, timestampTo });
+}
+
 PlaybackModel::TrackBoundaries PlaybackModel::trackBoundaries(const ScoreChangesRange& changesRange) const
 {
     TrackBoundaries result;
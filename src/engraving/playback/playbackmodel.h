@@ -131,6 +131,7 @@ private:
                                const muse::mpe::timestamp_t timestampTo = -1);
     void removeTrackEvents(const InstrumentTrackId& trackId, const muse::mpe::timestamp_t timestampFrom = -1,
                            const muse::mpe::timestamp_t timestampTo = -1);
+    void addChangedRange(muse::mpe::timestamp_t timestampFrom, const muse::mpe::timestamp_t timestampTo);
 
     TrackBoundaries trackBoundaries(const ScoreChangesRange& changesRange) const;
     TickBoundaries tickBoundaries(const ScoreChangesRange& changesRange) const;
@@ -151,6 +152,11 @@ private:
     std::unordered_map<InstrumentTrackId, PlaybackContext> m_playbackCtxMap;
     std::unordered_map<InstrumentTrackId, muse::mpe::PlaybackData> m_playbackDataMap;
 
+    //! NOTE: The timestamp ranges touched by the current change,
+    //! only the events within them are sent to the audio engine
+    muse::mpe::TimestampRangeList m_changedRanges;
+    bool m_allEventsChanged = false;
+
     muse::async::Notification m_dataChanged;
     muse::async::Channel<InstrumentTrackId> m_trackAdded;
     muse::async::Channel<InstrumentTrackId> m_trackRemoved;
@@ -88,8 +88,13 @@ void AccidentalsLayout::layoutAccidentals(const std::vector<Chord*>& chords, Lay
     }
 
     for (Accidental* acc : allAccidentals) {
+        const double mag = acc->mag();
         acc->setPos(0.0, 0.0);
         acc->computeMag();
+        if (!muse::RealIsEqual(acc->mag(), mag)) {
+            //! NOTE The accidental may have been laid out by the independent items pass with the previous mag
+            acc->mutldata()->reset();
+        }
         TLayout::layoutAccidental(acc, acc->mutldata(), ctx.conf());
     }
 
@@ -1180,7 +1180,12 @@ void ChordLayout::layoutStem(Chord* item, const LayoutContext& ctx)
     // Stem needs to know hook's bbox and SMuFL anchors.
     // This is done before calcDefaultStemLength because the presence or absence of a hook affects stem length
     if (item->hook()) {
+        const SymId hookSym = item->hook()->sym();
         item->hook()->setHookType(item->up() ? item->durationType().hooks() : -item->durationType().hooks());
+        if (item->hook()->sym() != hookSym) {
+            //! NOTE The hook may have been laid out by the independent items pass with the previous direction
+            item->hook()->mutldata()->reset();
+        }
         TLayout::layoutHook(item->hook(), item->hook()->mutldata());
     }
 
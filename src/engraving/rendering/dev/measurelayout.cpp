@@ -377,6 +377,7 @@ void MeasureLayout::createMMRest(LayoutContext& ctx, Measure* firstMeasure, Meas
                     mmrTimeSig->setSig(underlyingTimeSig->sig(), underlyingTimeSig->timeSigType());
                     mmrTimeSig->setNumeratorString(underlyingTimeSig->numeratorString());
                     mmrTimeSig->setDenominatorString(underlyingTimeSig->denominatorString());
+                    mmrTimeSig->mutldata()->reset();
                     TLayout::layoutTimeSig(mmrTimeSig, mmrTimeSig->mutldata(), ctx);
                 }
             }
@@ -406,6 +407,7 @@ void MeasureLayout::createMMRest(LayoutContext& ctx, Measure* firstMeasure, Meas
                     ctx.mutDom().doUndoAddElement(mmrAmbitus);
                 } else {
                     mmrAmbitus->initFrom(underlyingAmbitus);
+                    mmrAmbitus->mutldata()->reset();
                     TLayout::layoutAmbitus(mmrAmbitus, mmrAmbitus->mutldata(), ctx);
                 }
             }
@@ -1839,6 +1841,7 @@ void MeasureLayout::addSystemTrailer(Measure* m, Measure* nm, LayoutContext& ctx
                         s->setTrailer(true);
                     }
                     ts->setFrom(nts);
+                    ts->mutldata()->reset();
                     TLayout::layoutTimeSig(ts, ts->mutldata(), ctx);
                     //s->createShape(track / VOICES);
                 }
@@ -1906,8 +1909,9 @@ void MeasureLayout::addSystemTrailer(Measure* m, Measure* nm, LayoutContext& ctx
         }
         if (clefSegment) {
             Clef* clef = toClef(clefSegment->element(track));
-            if (clef) {
+            if (clef && !clef->isSmall()) {
                 clef->setSmall(true);
+                clef->mutldata()->reset();
             }
         }
     }
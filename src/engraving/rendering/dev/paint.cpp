@@ -138,8 +138,10 @@ void Paint::paintScore(Painter* painter, Score* score, const IScoreRenderer::Pai
                 disableClipping = true;
             }
 
-            std::vector<EngravingItem*> elements = page->items(drawRect.translated(-pagePos));
-            paintItems(*painter, elements);
+            //! NOTE The page keeps its items sorted in paint order until the next layout,
+            //! so repainting (scrolling, zooming) doesn't need to sort them again
+            const std::vector<EngravingItem*>& elements = page->paintItems(drawRect.translated(-pagePos));
+            paintSortedItems(*painter, elements);
             //DebugPaint::paintPageTree(*painter, page);
 
             if (disableClipping) {
@@ -230,7 +232,13 @@ void Paint::paintItems(Painter& painter, const std::vector<EngravingItem*>& item
 
     std::sort(sortedItems.begin(), sortedItems.end(), mu::engraving::elementLessThan);
 
-    for (const EngravingItem* item : sortedItems) {
+    paintSortedItems(painter, sortedItems);
+}
+
+void Paint::paintSortedItems(Painter& painter, const std::vector<EngravingItem*>& items)
+{
+    TRACEFUNC;
+    for (const EngravingItem* item : items) {
         if (!item->isInteractionAvailable()) {
             continue;
         }
@@ -41,6 +41,7 @@ public:
     static void paintScore(muse::draw::Painter* painter, Score* score, const IScoreRenderer::PaintOptions& opt);
     static void paintItem(muse::draw::Painter& painter, const EngravingItem* item);
     static void paintItems(muse::draw::Painter& painter, const std::vector<EngravingItem*>& items);
+    static void paintSortedItems(muse::draw::Painter& painter, const std::vector<EngravingItem*>& items);
 
     static SizeF pageSizeInch(const Score* score);
     static SizeF pageSizeInch(const Score* score, const IScoreRenderer::PaintOptions& opt);
@@ -21,20 +21,51 @@
  */
 #include "passlayoutindependentitems.h"
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+
+#include "concurrency/taskscheduler.h"
+
+#include "dom/note.h"
 #include "dom/score.h"
+#include "dom/staff.h"
+#include "dom/symbol.h"
 
 #include "tlayout.h"
 
 using namespace mu::engraving;
 using namespace mu::engraving::rendering::dev;
 
+//! NOTE Below this number of items the dispatch costs more than it saves
+static constexpr size_t MIN_CONCURRENT_ITEMS_COUNT = 1000;
+
+static std::atomic<size_t> s_minConcurrentItemsCount = MIN_CONCURRENT_ITEMS_COUNT;
+
+void PassLayoutIndependentItems::setMinConcurrentItemsCount(size_t count)
+{
+    s_minConcurrentItemsCount = count;
+}
+
+size_t PassLayoutIndependentItems::minConcurrentItemsCount()
+{
+    return s_minConcurrentItemsCount;
+}
+
 void PassLayoutIndependentItems::doRun(Score* score, LayoutContext& ctx)
 {
+    //! NOTE The items ask for the configuration while laid out, resolve it before the workers do
+    score->configuration();
+
+    StaffItems staffItems(score->nstaves());
+
     RootItem* rootItem = score->rootItem();
-    scan(rootItem, ctx);
+    scan(rootItem, ctx, staffItems);
+
+    layoutStaves(staffItems, ctx);
 }
 
-void PassLayoutIndependentItems::scan(EngravingItem* item, LayoutContext& ctx)
+void PassLayoutIndependentItems::scan(EngravingItem* item, LayoutContext& ctx, StaffItems& staffItems)
 {
     //! NOTE These items are independent
     switch (item->type()) {
@@ -58,8 +89,14 @@ void PassLayoutIndependentItems::scan(EngravingItem* item, LayoutContext& ctx)
     case ElementType::FSYMBOL:
     case ElementType::SYSTEM_DIVIDER:
     case ElementType::TIMESIG:
-    case ElementType::TREMOLOBAR:
-        TLayout::layoutItem(item, ctx);
+    case ElementType::TREMOLOBAR: {
+        const staff_idx_t staffIdx = item->staffIdx();
+        if (staffIdx < staffItems.size() && isStaffLocal(item)) {
+            staffItems[staffIdx].push_back(item);
+        } else {
+            TLayout::layoutItem(item, ctx);
+        }
+    } break;
     default:
         break;
     }
@@ -68,6 +105,105 @@ void PassLayoutIndependentItems::scan(EngravingItem* item, LayoutContext& ctx)
         if (ch->isType(ElementType::DUMMY)) {
             continue;
         }
-        scan(ch, ctx);
+        scan(ch, ctx, staffItems);
+    }
+}
+
+//! NOTE Whether the layout of the item only reads and writes the items of its own staff
+//! and the symbol metrics of the score font. The font loads its metrics and builds the cutout shapes lazily,
+//! under its own locks. Such items are laid out concurrently, staff by staff, the rest is laid out while scanning
+bool PassLayoutIndependentItems::isStaffLocal(const EngravingItem* item)
+{
+    switch (item->type()) {
+    case ElementType::ACCIDENTAL:
+    case ElementType::AMBITUS:
+    case ElementType::BREATH:
+    case ElementType::CLEF:
+    case ElementType::DEAD_SLAPPED:
+    case ElementType::HOOK:
+    case ElementType::KEYSIG:
+    case ElementType::NOTEDOT:
+    case ElementType::STEM:
+    case ElementType::TIMESIG:
+        return true;
+    case ElementType::NOTE: {
+        //! NOTE On tablature the note adds or removes its parentheses, that goes through the undo stack
+        const Note* note = toNote(item);
+        return !(note->staff() && note->staff()->isTabStaff(note->chord()->tick()));
+    }
+    case ElementType::SYMBOL: {
+        //! NOTE Another score font may be loaded on the first use
+        const Symbol* symbol = toSymbol(item);
+        return !symbol->scoreFont() && symbol->leafs().empty();
+    }
+    default:
+        //! NOTE The text based items use the text fonts, they are not thread-safe
+        return false;
+    }
+}
+
+void PassLayoutIndependentItems::layoutStaves(const StaffItems& staffItems, LayoutContext& ctx)
+{
+    auto layoutRange = [&staffItems, &ctx](size_t begin, size_t end) {
+        for (size_t staffIdx = begin; staffIdx < end; ++staffIdx) {
+            for (EngravingItem* item : staffItems[staffIdx]) {
+                TLayout::layoutItem(item, ctx);
+            }
+        }
+    };
+
+    size_t itemsCount = 0;
+    for (const std::vector<EngravingItem*>& items : staffItems) {
+        itemsCount += items.size();
+    }
+
+    muse::TaskScheduler* scheduler = muse::TaskScheduler::workerPool();
+    const size_t threadCount = scheduler->threadPoolSize();
+
+#ifdef MUE_ENABLE_ENGRAVING_RENDER_DEBUG
+    //! NOTE The call tracing is not thread-safe
+    const bool concurrent = false;
+    UNUSED(threadCount);
+#else
+    const bool concurrent = threadCount > 1 && staffItems.size() > 1 && itemsCount >= s_minConcurrentItemsCount;
+#endif
+
+    if (!concurrent) {
+        layoutRange(0, staffItems.size());
+        return;
+    }
+
+    //! NOTE Contiguous ranges of staves with about the same number of items,
+    //! the calling thread takes the last one
+    const size_t rangeCount = std::min(threadCount + 1, staffItems.size());
+    const size_t rangeItemsCount = (itemsCount + rangeCount - 1) / rangeCount;
+
+    std::vector<std::future<void> > results;
+    size_t begin = 0;
+    size_t count = 0;
+    for (size_t staffIdx = 0; staffIdx + 1 < staffItems.size(); ++staffIdx) {
+        count += staffItems[staffIdx].size();
+        if (count < rangeItemsCount) {
+            continue;
+        }
+
+        const size_t end = staffIdx + 1;
+        results.push_back(scheduler->submit([&layoutRange, begin, end]() {
+            layoutRange(begin, end);
+        }));
+
+        begin = end;
+        count = 0;
+    }
+
+    layoutRange(begin, staffItems.size());
+
+    //! NOTE The tasks refer to this frame, so all of them must finish before anything is rethrown
+    for (std::future<void>& result : results) {
+        result.wait();
+    }
+
+    for (std::future<void>& result : results) {
+        result.get();
     }
 }
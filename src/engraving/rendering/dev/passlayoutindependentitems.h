@@ -22,6 +22,8 @@
 #ifndef MU_ENGRAVING_PASSLAYOUTINDEPENDEDITEMS_DEV_H
 #define MU_ENGRAVING_PASSLAYOUTINDEPENDEDITEMS_DEV_H
 
+#include <vector>
+
 #include "passbase.h"
 
 namespace mu::engraving {
@@ -33,11 +35,21 @@ class PassLayoutIndependentItems : public PassBase
 {
 public:
 
+    //! NOTE Below this number of items the staves are laid out on the calling thread
+    static void setMinConcurrentItemsCount(size_t count);
+    static size_t minConcurrentItemsCount();
+
 private:
 
+    //! NOTE The items to lay out, by staff
+    using StaffItems = std::vector<std::vector<EngravingItem*> >;
+
     void doRun(Score* score, LayoutContext& ctx) override;
 
-    void scan(EngravingItem* item, LayoutContext& ctx);
+    void scan(EngravingItem* item, LayoutContext& ctx, StaffItems& staffItems);
+
+    static bool isStaffLocal(const EngravingItem* item);
+    static void layoutStaves(const StaffItems& staffItems, LayoutContext& ctx);
 };
 }
 
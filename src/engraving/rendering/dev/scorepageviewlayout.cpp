@@ -181,12 +181,10 @@ void ScorePageViewLayout::layoutPageView(Score* score, LayoutContext& ctx, const
     resetPass.run(score, ctx);
 //#endif
 
-#ifdef MUE_ENABLE_ENGRAVING_LD_PASSES
     if (ctx.state().isLayoutAll()) {
         PassLayoutIndependentItems independentPass;
         independentPass.run(score, ctx);
     }
-#endif
 
     doLayout(ctx);
 
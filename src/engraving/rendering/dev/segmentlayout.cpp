@@ -41,7 +41,10 @@ void SegmentLayout::layoutMeasureIndependentElements(const Segment& segment, tra
     } else if (segment.isJustType(SegmentType::Clef)) {
         Clef* cl = item_cast<Clef*>(segment.element(track));
         if (cl) {
-            cl->setSmall(true);
+            if (!cl->isSmall()) {
+                cl->setSmall(true);
+                cl->mutldata()->reset();
+            }
             TLayout::layoutClef(cl, cl->mutldata(), ctx.conf());         // LD_INDEPENDENT
         }
     } else if (segment.isType(SegmentType::HeaderClef)) {
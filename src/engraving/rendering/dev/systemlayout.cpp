@@ -2723,11 +2723,7 @@ void SystemLayout::updateSkylineForElement(EngravingItem* element, const System*
 {
     Skyline& skyline = system->staff(element->staffIdx())->skyline();
     SkylineLine& skylineLine = element->placeAbove() ? skyline.north() : skyline.south();
-    for (ShapeElement& shapeEl : skylineLine.elements()) {
-        if (shapeEl.item() == element) {
-            shapeEl.translate(0.0, yMove);
-        }
-    }
+    skylineLine.translateY(element, yMove);
 }
 
 void SystemLayout::centerElementsBetweenStaves(const System* system)
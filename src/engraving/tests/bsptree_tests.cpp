@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #include "dom/bsp.h"
 #include "dom/page.h"
 
@@ -86,3 +88,61 @@ TEST_F(Engraving_BspTreeTests, NearestNeighbor)
         EXPECT_EQ(nn, singleNote);
     }
 }
+
+/**
+ * @brief Engraving_BspTreeTests_PaintItems
+ * @details Check that the page display list returns the same items as the BspTree, in paint order,
+ *          also after the selection has changed without a relayout
+ */
+TEST_F(Engraving_BspTreeTests, PaintItems)
+{
+    Score* score = ScoreRW::readScore(BSPTREE_DATA_DIR + u"nearest_neighbor.mscx");
+    EXPECT_TRUE(score);
+
+    Page* page = score->pages().at(0);
+    EXPECT_TRUE(page);
+
+    const RectF pageRect = page->pageBoundingRect();
+    std::vector<RectF> rects { pageRect };
+    for (int i = 0; i < 8; ++i) {
+        rects.push_back(RectF(pageRect.x() + pageRect.width() * i / 8, pageRect.y(), pageRect.width() / 4, pageRect.height() / 3));
+        rects.push_back(RectF(pageRect.x(), pageRect.y() + pageRect.height() * i / 8, pageRect.width(), pageRect.height() / 8));
+    }
+
+    auto checkPaintItems = [page](const RectF& rect) {
+        std::vector<EngravingItem*> expected = page->items(rect);
+        std::vector<EngravingItem*> actual = page->paintItems(rect);
+
+        // [THEN] Items are in paint order
+        EXPECT_TRUE(std::is_sorted(actual.begin(), actual.end(), elementLessThan));
+
+        // [THEN] Items are the same as found by the BspTree
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        EXPECT_EQ(actual, expected);
+    };
+
+    // [WHEN] Requesting the items of different regions of the page, twice, to also hit the cached result
+    for (const RectF& rect : rects) {
+        checkPaintItems(rect);
+        checkPaintItems(rect);
+    }
+
+    // [GIVEN] A note becomes selected, the paint order depends on the selection
+    EngravingItem* note = nullptr;
+    for (EngravingItem* elem : page->elements()) {
+        if (elem->isNote()) {
+            note = elem;
+            break;
+        }
+    }
+    EXPECT_TRUE(note);
+    score->select(note);
+
+    // [WHEN] Requesting the items again, without a relayout
+    for (const RectF& rect : rects) {
+        checkPaintItems(rect);
+    }
+
+    delete score;
+}
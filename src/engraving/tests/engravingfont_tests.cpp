@@ -0,0 +1,134 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "modularity/ioc.h"
+
+#include "iengravingfontsprovider.h"
+#include "internal/engravingfont.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static constexpr int THREADS = 8;
+static constexpr int REPEATS = 3;
+
+class Engraving_EngravingFontTests : public ::testing::Test
+{
+public:
+    static std::shared_ptr<IEngravingFontsProvider> engravingFonts()
+    {
+        return muse::modularity::globalIoc()->resolve<IEngravingFontsProvider>("utests");
+    }
+
+    static void addRect(std::vector<double>& values, const RectF& r)
+    {
+        values.push_back(r.x());
+        values.push_back(r.y());
+        values.push_back(r.width());
+        values.push_back(r.height());
+    }
+
+    static std::vector<double> measure(EngravingFont& font, SymId id)
+    {
+        std::vector<double> values;
+
+        values.push_back(static_cast<double>(font.symCode(id)));
+        values.push_back(font.isValid(id) ? 1.0 : 0.0);
+        addRect(values, font.bbox(id, 1.5));
+        values.push_back(font.advance(id, 1.5));
+        values.push_back(font.width(id, 1.5));
+
+        PointF stem = font.smuflAnchor(id, SmuflAnchorId::stemUpSE, 1.5);
+        values.push_back(stem.x());
+        values.push_back(stem.y());
+
+        Shape shape = font.shapeWithCutouts(id, 1.5);
+        values.push_back(static_cast<double>(shape.size()));
+        addRect(values, shape.bbox());
+
+        return values;
+    }
+};
+
+/**
+ * @brief Engraving_EngravingFontTests_ConcurrentMetrics
+ * @details Check that the metrics of an engraving font are the same when it's loaded and read from many threads at once
+ */
+TEST_F(Engraving_EngravingFontTests, ConcurrentMetrics)
+{
+    // [GIVEN] The metrics of a loaded font, read on a single thread
+    std::shared_ptr<EngravingFont> loaded = std::dynamic_pointer_cast<EngravingFont>(engravingFonts()->fontByName("Leland"));
+    ASSERT_TRUE(loaded);
+
+    const size_t symCount = static_cast<size_t>(SymId::lastSym);
+
+    std::vector<std::vector<double> > expected;
+    expected.reserve(symCount);
+    for (size_t i = 0; i < symCount; ++i) {
+        expected.push_back(measure(*loaded, static_cast<SymId>(i)));
+    }
+
+    // [WHEN] A new instance of the font is loaded and read from many threads at once
+    std::shared_ptr<EngravingFont> font = std::make_shared<EngravingFont>("Leland", "Leland", ":/fonts/leland/Leland.otf",
+                                                                          loaded->iocContext());
+
+    std::atomic<bool> start = false;
+    std::atomic<int> mismatches = 0;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+
+            font->ensureLoad();
+
+            for (int r = 0; r < REPEATS; ++r) {
+                for (size_t i = 0; i < symCount; ++i) {
+                    //! NOTE Each thread walks the symbols in its own order
+                    size_t idx = (i + static_cast<size_t>(t) * symCount / THREADS) % symCount;
+                    if (measure(*font, static_cast<SymId>(idx)) != expected.at(idx)) {
+                        ++mismatches;
+                    }
+                }
+
+                if (!engravingFonts()->fontByName("Bravura") || !engravingFonts()->fallbackFont()) {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+
+    start = true;
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // [THEN] All the threads got the same metrics
+    EXPECT_EQ(mismatches.load(), 0);
+}
@@ -0,0 +1,232 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "internal/engravingfontmetricscache.h"
+
+#include "io/ifilesystem.h"
+
+using namespace mu;
+using namespace muse;
+using namespace mu::engraving;
+
+static const io::path_t CACHE_DIR("fontmetricscache_test");
+static const std::string FONT_NAME("Test Font");
+
+class Engraving_EngravingFontMetricsCacheTests : public ::testing::Test
+{
+public:
+    GlobalInject<io::IFileSystem> fileSystem;
+
+    void SetUp() override
+    {
+        fileSystem()->remove(CACHE_DIR);
+    }
+
+    void TearDown() override
+    {
+        fileSystem()->remove(CACHE_DIR);
+    }
+
+    static EngravingFontMetricsCache::Metrics makeMetrics()
+    {
+        EngravingFontMetricsCache::Metrics metrics;
+        metrics.symbols.resize(static_cast<size_t>(SymId::lastSym) + 1);
+
+        EngravingFontMetricsCache::SymMetrics& notehead = metrics.symbols[static_cast<size_t>(SymId::noteheadBlack)];
+        notehead.code = 0xE0A4;
+        notehead.bbox = RectF(0.0, -13.8, 29.5, 27.6);
+        notehead.advance = 29.5;
+        notehead.smuflAnchors[SmuflAnchorId::stemUpSE] = PointF(29.5, -4.2);
+        notehead.smuflAnchors[SmuflAnchorId::stemDownNW] = PointF(0.0, 4.2);
+
+        EngravingFontMetricsCache::SymMetrics& clef = metrics.symbols[static_cast<size_t>(SymId::gClef)];
+        clef.code = 0xE050;
+        clef.bbox = RectF(0.5, -110.0, 67.2, 183.3);
+        clef.advance = 68.0;
+
+        //! NOTE A symbol that isn't in the font, but has anchors in the metadata
+        EngravingFontMetricsCache::SymMetrics& flag = metrics.symbols[static_cast<size_t>(SymId::flag8thUp)];
+        flag.smuflAnchors[SmuflAnchorId::stemUpNW] = PointF(0.0, -1.0);
+
+        metrics.engravingDefaults.insert({ Sid::staffLineWidth, 0.11 });
+        metrics.engravingDefaults.insert({ Sid::useWideBeams, true });
+        metrics.engravingDefaults.insert({ Sid::MusicalTextFont, String(u"Test Font Text") });
+        metrics.textEnclosureThickness = 0.16;
+
+        return metrics;
+    }
+
+    static ByteArray makeKey(uint8_t seed)
+    {
+        ByteArray key(48);
+        for (size_t i = 0; i < key.size(); ++i) {
+            key[i] = static_cast<uint8_t>(seed + i);
+        }
+
+        return key;
+    }
+
+    static void checkSym(const EngravingFontMetricsCache::SymMetrics& actual, const EngravingFontMetricsCache::SymMetrics& expected)
+    {
+        EXPECT_EQ(actual.code, expected.code);
+        EXPECT_EQ(actual.bbox.x(), expected.bbox.x());
+        EXPECT_EQ(actual.bbox.y(), expected.bbox.y());
+        EXPECT_EQ(actual.bbox.width(), expected.bbox.width());
+        EXPECT_EQ(actual.bbox.height(), expected.bbox.height());
+        EXPECT_EQ(actual.advance, expected.advance);
+        EXPECT_EQ(actual.smuflAnchors, expected.smuflAnchors);
+    }
+};
+
+/**
+ * @brief Engraving_EngravingFontMetricsCacheTests_StoreLoad
+ * @details Check that the stored metrics are loaded back as they were
+ */
+TEST_F(Engraving_EngravingFontMetricsCacheTests, StoreLoad)
+{
+    // [GIVEN] Metrics of a font
+    EngravingFontMetricsCache cache(CACHE_DIR);
+    EngravingFontMetricsCache::Metrics expected = makeMetrics();
+    ByteArray key = makeKey(1);
+
+    // [WHEN] Store and load them with the same key
+    EXPECT_TRUE(cache.store(FONT_NAME, makeKey(100), key, expected));
+
+    EngravingFontMetricsCache::Metrics actual;
+    EXPECT_TRUE(cache.load(FONT_NAME, key, actual));
+
+    // [THEN] All the symbols are restored
+    ASSERT_EQ(actual.symbols.size(), expected.symbols.size());
+    for (size_t i = 0; i < expected.symbols.size(); ++i) {
+        checkSym(actual.symbols.at(i), expected.symbols.at(i));
+    }
+
+    // [THEN] The real and bool engraving defaults are restored, the rest isn't cached
+    EXPECT_EQ(actual.engravingDefaults.size(), 2);
+    EXPECT_EQ(actual.engravingDefaults.at(Sid::staffLineWidth).toReal(), 0.11);
+    EXPECT_TRUE(actual.engravingDefaults.at(Sid::useWideBeams).toBool());
+    EXPECT_EQ(actual.textEnclosureThickness, 0.16);
+}
+
+/**
+ * @brief Engraving_EngravingFontMetricsCacheTests_Invalidation
+ * @details Check that the cache isn't used when the key doesn't match or the file is broken
+ */
+TEST_F(Engraving_EngravingFontMetricsCacheTests, Invalidation)
+{
+    // [GIVEN] Stored metrics
+    EngravingFontMetricsCache cache(CACHE_DIR);
+    EXPECT_TRUE(cache.store(FONT_NAME, makeKey(100), makeKey(1), makeMetrics()));
+
+    EngravingFontMetricsCache::Metrics actual;
+
+    // [THEN] Nothing is loaded for another key, e.g. when the font has changed
+    EXPECT_FALSE(cache.load(FONT_NAME, makeKey(2), actual));
+
+    // [THEN] Nothing is loaded for another font
+    EXPECT_FALSE(cache.load("Other Font", makeKey(1), actual));
+
+    // [WHEN] The file is truncated
+    io::path_t path = cache.cacheFilePath(FONT_NAME);
+    ByteArray data = fileSystem()->readFile(path).val;
+    ASSERT_FALSE(data.empty());
+    EXPECT_TRUE(fileSystem()->writeFile(path, data.left(data.size() - 4)));
+
+    // [THEN] It's not loaded
+    EXPECT_FALSE(cache.load(FONT_NAME, makeKey(1), actual));
+    EXPECT_TRUE(actual.symbols.empty());
+
+    // [WHEN] The metrics are stored again
+    EXPECT_TRUE(cache.store(FONT_NAME, makeKey(100), makeKey(2), makeMetrics()));
+
+    // [THEN] They are loaded for the new key only
+    EXPECT_FALSE(cache.load(FONT_NAME, makeKey(1), actual));
+    EXPECT_TRUE(cache.load(FONT_NAME, makeKey(2), actual));
+}
+
+/**
+ * @brief Engraving_EngravingFontMetricsCacheTests_StoredKey
+ * @details Check that the key is given back only for the stamp it was stored with
+ */
+TEST_F(Engraving_EngravingFontMetricsCacheTests, StoredKey)
+{
+    // [GIVEN] Metrics stored with a stamp of the font files
+    EngravingFontMetricsCache cache(CACHE_DIR);
+    EXPECT_TRUE(cache.storedKey(FONT_NAME, makeKey(100)).empty());
+    EXPECT_TRUE(cache.store(FONT_NAME, makeKey(100), makeKey(1), makeMetrics()));
+
+    // [THEN] The key is given back for the same stamp, so the files don't need to be hashed
+    EXPECT_EQ(cache.storedKey(FONT_NAME, makeKey(100)), makeKey(1));
+
+    // [THEN] There is no key for another stamp, e.g. when the font file was touched
+    EXPECT_TRUE(cache.storedKey(FONT_NAME, makeKey(101)).empty());
+    EXPECT_TRUE(cache.storedKey(FONT_NAME, ByteArray()).empty());
+    EXPECT_TRUE(cache.storedKey("Other Font", makeKey(100)).empty());
+}
+
+/**
+ * @brief Engraving_EngravingFontMetricsCacheTests_ContentKey
+ * @details Check that the key changes with the content of the font and its metadata
+ */
+TEST_F(Engraving_EngravingFontMetricsCacheTests, ContentKey)
+{
+    // [GIVEN] A font file and its metadata
+    EngravingFontMetricsCache cache(CACHE_DIR);
+    fileSystem()->makePath(CACHE_DIR);
+
+    io::path_t fontPath = CACHE_DIR + "/font.otf";
+    io::path_t metadataPath = CACHE_DIR + "/metadata.json";
+    EXPECT_TRUE(fileSystem()->writeFile(fontPath, ByteArray("font data")));
+    EXPECT_TRUE(fileSystem()->writeFile(metadataPath, ByteArray("{}")));
+
+    // [WHEN] Get the key and the stamp twice
+    ByteArray key = cache.contentKey(fontPath, metadataPath);
+    ByteArray stamp = cache.fileStamp(fontPath, metadataPath);
+
+    // [THEN] They are the same
+    EXPECT_FALSE(stamp.empty());
+    EXPECT_EQ(cache.fileStamp(fontPath, metadataPath), stamp);
+
+    // [THEN] It's the same
+    EXPECT_FALSE(key.empty());
+    EXPECT_EQ(cache.contentKey(fontPath, metadataPath), key);
+
+    // [WHEN] The font changes
+    EXPECT_TRUE(fileSystem()->writeFile(fontPath, ByteArray("new font data")));
+    ByteArray fontChangedKey = cache.contentKey(fontPath, metadataPath);
+
+    // [THEN] The key and the stamp change
+    EXPECT_NE(fontChangedKey, key);
+    EXPECT_NE(cache.fileStamp(fontPath, metadataPath), stamp);
+
+    // [WHEN] The metadata changes
+    EXPECT_TRUE(fileSystem()->writeFile(metadataPath, ByteArray("{ \"engravingDefaults\": {} }")));
+
+    // [THEN] The key changes
+    EXPECT_NE(cache.contentKey(fontPath, metadataPath), fontChangedKey);
+
+    // [THEN] There is no key or stamp without the metadata
+    EXPECT_TRUE(cache.contentKey(fontPath, CACHE_DIR + "/none.json").empty());
+    EXPECT_TRUE(cache.fileStamp(fontPath, CACHE_DIR + "/none.json").empty());
+}
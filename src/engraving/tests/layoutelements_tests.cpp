@@ -31,6 +31,8 @@
 #include "dom/tuplet.h"
 #include "dom/note.h"
 
+#include "rendering/dev/passlayoutindependentitems.h"
+
 #include "utils/scorerw.h"
 
 #include "log.h"
@@ -156,3 +158,48 @@ TEST_F(Engraving_LayoutElementsTests, tstLayoutCrossStaffArp)
 
     delete score;
 }
+
+//---------------------------------------------------------
+//   tstLayoutIndependentItemsConcurrently
+//    the items laid out concurrently by the independent
+//    items pass end up where the sequential layout puts them
+//---------------------------------------------------------
+
+static std::vector<std::pair<RectF, PointF> > itemsGeometry(Score* score)
+{
+    std::vector<std::pair<RectF, PointF> > geometry;
+    score->scanElements(&geometry, [](void* data, EngravingItem* e) {
+        auto items = static_cast<std::vector<std::pair<RectF, PointF> >*>(data);
+        items->push_back({ e->ldata()->bbox(), e->pagePos() });
+    }, /* all */ true);
+
+    return geometry;
+}
+
+TEST_F(Engraving_LayoutElementsTests, tstLayoutIndependentItemsConcurrently)
+{
+    using namespace mu::engraving::rendering::dev;
+
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    const size_t defaultCount = PassLayoutIndependentItems::minConcurrentItemsCount();
+
+    // [GIVEN] The score laid out with the staves laid out one after another
+    PassLayoutIndependentItems::setMinConcurrentItemsCount(std::numeric_limits<size_t>::max());
+    score->doLayout();
+    const std::vector<std::pair<RectF, PointF> > sequential = itemsGeometry(score);
+
+    // [WHEN] The staves are laid out concurrently
+    PassLayoutIndependentItems::setMinConcurrentItemsCount(0);
+    score->doLayout();
+    const std::vector<std::pair<RectF, PointF> > concurrent = itemsGeometry(score);
+
+    PassLayoutIndependentItems::setMinConcurrentItemsCount(defaultCount);
+
+    // [THEN] Every item has the same geometry
+    EXPECT_FALSE(sequential.empty());
+    EXPECT_EQ(sequential, concurrent);
+
+    delete score;
+}
@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 #include "dom/engravingitem.h"
 #include "dom/masterscore.h"
 #include "dom/measure.h"
@@ -33,6 +35,8 @@
 #include "utils/scorerw.h"
 #include "utils/scorecomp.h"
 
+#include "log.h"
+
 using namespace mu;
 using namespace mu::engraving;
 
@@ -40,6 +44,37 @@ static const String MEASURE_DATA_DIR("measure_data/");
 
 class Engraving_MeasureTests : public ::testing::Test
 {
+public:
+    //! NOTE: The lookup as it was done before the tick index
+    static Measure* tick2measureLinear(const Score* score, const Fraction& tick, bool mm)
+    {
+        Measure* lm = nullptr;
+        Measure* m = mm ? score->firstMeasureMM() : score->firstMeasure();
+        while (m) {
+            if (tick < m->tick()) {
+                return lm;
+            }
+            lm = m;
+            m = mm ? m->nextMeasureMM() : m->nextMeasure();
+        }
+        if (lm && tick <= lm->endTick()) {
+            return lm;
+        }
+        return nullptr;
+    }
+
+    static void checkTick2Measure(const Score* score)
+    {
+        for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            for (const Fraction& tick : { m->tick(), m->tick() + m->ticks() / 2, m->endTick() }) {
+                EXPECT_EQ(score->tick2measure(tick), tick2measureLinear(score, tick, false));
+                EXPECT_EQ(score->tick2measureMM(tick), tick2measureLinear(score, tick, true));
+                EXPECT_EQ(score->tick2measureBase(tick), tick == score->endTick() ? nullptr : score->tick2measure(tick));
+            }
+        }
+
+        EXPECT_EQ(score->tick2measure(score->endTick() + Fraction(1, 4)), nullptr);
+    }
 };
 
 TEST_F(Engraving_MeasureTests, DISABLED_insertMeasureMiddle) //TODO: verify program change, 72 is wrong surely?
@@ -567,3 +602,92 @@ TEST_F(Engraving_MeasureTests, measureNumbers)
 
     delete score;
 }
+
+//---------------------------------------------------------
+///   tick2measure
+///    the tick index is kept in sync with the measures
+//---------------------------------------------------------
+
+TEST_F(Engraving_MeasureTests, tick2measure)
+{
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"mmrest.mscx");
+    EXPECT_TRUE(score);
+    checkTick2Measure(score);
+
+    // insert a measure in the middle
+    Measure* m = score->firstMeasure()->nextMeasure()->nextMeasure();
+    score->startCmd();
+    score->insertMeasure(m);
+    score->endCmd();
+    checkTick2Measure(score);
+    EXPECT_EQ(score->tick2measure(m->tick()), m);
+
+    // undo the insertion
+    score->undoRedo(true, 0);
+    checkTick2Measure(score);
+
+    // create mm rests
+    score->startCmd();
+    score->undoChangeStyleVal(Sid::createMultiMeasureRests, true);
+    score->setLayoutAll();
+    score->endCmd();
+    checkTick2Measure(score);
+
+    bool hasMMRest = false;
+    for (Measure* mm = score->firstMeasureMM(); mm; mm = mm->nextMeasureMM()) {
+        hasMMRest |= mm->isMMRest();
+        EXPECT_EQ(score->tick2measureMM(mm->tick()), mm);
+    }
+    EXPECT_TRUE(hasMMRest);
+
+    // delete the last measure
+    score->select(score->lastMeasure());
+    score->startCmd();
+    score->cmdTimeDelete();
+    score->endCmd();
+    checkTick2Measure(score);
+
+    delete score;
+}
+
+//! NOTE: Run with --gtest_also_run_disabled_tests
+TEST_F(Engraving_MeasureTests, DISABLED_tick2measureBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int LOOKUP_REPEATS = 20;
+
+    MasterScore* score = ScoreRW::readScore(u"concertpitch_data/concertpitchbenchmark.mscx");
+    ASSERT_TRUE(score);
+
+    std::vector<Fraction> ticks;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        ticks.push_back(m->tick() + m->ticks() / 2);
+    }
+
+    // [WHEN] Look up the measures of all the ticks with a linear walk
+    size_t found = 0;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < LOOKUP_REPEATS; ++i) {
+        for (const Fraction& tick : ticks) {
+            found += tick2measureLinear(score, tick, false) ? 1 : 0;
+        }
+    }
+    double linearMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // [WHEN] Look up them with the tick index
+    start = Clock::now();
+    for (int i = 0; i < LOOKUP_REPEATS; ++i) {
+        for (const Fraction& tick : ticks) {
+            found -= score->tick2measure(tick) ? 1 : 0;
+        }
+    }
+    double indexMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // [THEN] Both of them find all the measures
+    EXPECT_EQ(found, 0);
+
+    LOGI() << ticks.size() << " measures, " << ticks.size() * LOOKUP_REPEATS << " lookups, "
+           << "linear: " << linearMs << " ms, index: " << indexMs << " ms";
+
+    delete score;
+}
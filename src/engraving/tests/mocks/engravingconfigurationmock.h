@@ -77,6 +77,12 @@ public:
 
     MOCK_METHOD(bool, isAccessibleEnabled, (), (const, override));
 
+    MOCK_METHOD(int, undoHistoryMemoryLimitMb, (), (const, override));
+    MOCK_METHOD(void, setUndoHistoryMemoryLimitMb, (int), (override));
+
+    MOCK_METHOD(bool, isParallelPartsLayoutEnabled, (), (const, override));
+    MOCK_METHOD(void, setParallelPartsLayoutEnabled, (bool), (override));
+
     MOCK_METHOD(bool, guitarProImportExperimental, (), (const, override));
     MOCK_METHOD(bool, negativeFretsAllowed, (), (const, override));
     MOCK_METHOD(bool, crossNoteHeadAlwaysBlack, (), (const, override));
@@ -21,6 +21,8 @@
  */
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include <QByteArray>
 
 #include "io/buffer.h"
@@ -88,3 +90,60 @@ TEST_F(Engraving_MsczFileTests, MsczFile_WriteRead)
         EXPECT_EQ(imageData, originImageData);
     }
 }
+
+TEST_F(Engraving_MsczFileTests, MsczFile_DeferredWriteRead)
+{
+    //! CASE Collecting the datas in memory and writing them on another thread
+
+    //! GIVEN Some datas, collected by a deferred writer
+    const ByteArray originScoreData("score");
+    const ByteArray originImageData("image");
+
+    MscWriter::Params deferredParams;
+    deferredParams.deferred = true;
+    deferredParams.filePath = "simple1.mscz";
+
+    MscWriter deferredWriter(deferredParams);
+    deferredWriter.open();
+    deferredWriter.writeScoreFile(originScoreData);
+    deferredWriter.addImageFile(u"image1.png", originImageData);
+    deferredWriter.close();
+
+    //! DO Write them to a zip on another thread
+    ByteArray msczData;
+    Ret ret;
+    std::thread writeThread([&]() {
+        Buffer buf(&msczData);
+        MscWriter::Params params;
+        params.device = &buf;
+        params.filePath = "simple1.mscz";
+        params.mode = MscIoMode::Zip;
+
+        MscWriter writer(params);
+        writer.open();
+        ret = deferredWriter.writeTo(writer);
+    });
+    writeThread.join();
+
+    EXPECT_TRUE(ret);
+
+    //! CHECK Read and compare with origin
+    {
+        Buffer buf(&msczData);
+        MscReader::Params params;
+        params.device = &buf;
+        params.filePath = "simple1.mscz";
+        params.mode = MscIoMode::Zip;
+
+        MscReader reader(params);
+        reader.open();
+
+        ByteArray scoreData = reader.readScoreFile();
+        EXPECT_EQ(scoreData, originScoreData);
+
+        std::vector<String> images = reader.imageFileNames();
+        ByteArray imageData = reader.readImageFile(u"image1.png");
+        EXPECT_EQ(images.size(), 1);
+        EXPECT_EQ(imageData, originImageData);
+    }
+}
@@ -38,6 +38,9 @@
 #include "dom/part.h"
 #include "dom/segment.h"
 #include "dom/spanner.h"
+#include "dom/undo.h"
+
+#include "mocks/engravingconfigurationmock.h"
 
 #include "utils/scorerw.h"
 #include "utils/scorecomp.h"
@@ -66,8 +69,32 @@ public:
     MasterScore* doRemoveMeasureRepeat();
     MasterScore* doAddImage();
     MasterScore* doRemoveImage();
+
+    static void setParallelPartsLayoutEnabled(bool enabled);
+    static std::vector<RectF> measureRects(MasterScore* score);
 };
 
+void Engraving_PartsTests::setParallelPartsLayoutEnabled(bool enabled)
+{
+    std::shared_ptr<EngravingConfigurationMock> configuration = std::dynamic_pointer_cast<EngravingConfigurationMock>(
+        muse::modularity::globalIoc()->resolve<IEngravingConfiguration>("utests"));
+    ASSERT_TRUE(configuration);
+
+    ON_CALL(*configuration, isParallelPartsLayoutEnabled()).WillByDefault(::testing::Return(enabled));
+}
+
+std::vector<RectF> Engraving_PartsTests::measureRects(MasterScore* masterScore)
+{
+    std::vector<RectF> rects;
+    for (Score* score : masterScore->scoreList()) {
+        for (Measure* m = score->firstMeasureMM(); m; m = m->nextMeasureMM()) {
+            rects.push_back(m->canvasBoundingRect());
+        }
+    }
+
+    return rects;
+}
+
 Score* Engraving_PartsTests::createPart(MasterScore* masterScore)
 {
     std::vector<Part*> parts;
@@ -274,6 +301,104 @@ TEST_F(Engraving_PartsTests, insertMeasure)
     delete score;
 }
 
+//---------------------------------------------------------
+//   parallelLayout
+//    the parts are laid out concurrently the same way as one after another
+//---------------------------------------------------------
+
+TEST_F(Engraving_PartsTests, parallelLayout)
+{
+    std::vector<RectF> rects[2];
+    std::vector<RectF> undoRects[2];
+
+    for (bool parallel : { false, true }) {
+        setParallelPartsLayoutEnabled(parallel);
+
+        MasterScore* score = ScoreRW::readScore(PARTS_DATA_DIR + u"part-all.mscx");
+        ASSERT_TRUE(score);
+
+        createParts(score);
+
+        score->startCmd();
+        Measure* m = score->firstMeasure();
+        score->insertMeasure(m);
+        score->endCmd(false, /*layoutAllParts*/ true);
+
+        rects[parallel] = measureRects(score);
+        EXPECT_TRUE(ScoreRW::saveScore(score, parallel ? u"part-all-parallel.mscx" : u"part-all-sequential.mscx"));
+
+        score->undoRedo(true, 0);
+
+        undoRects[parallel] = measureRects(score);
+        EXPECT_TRUE(ScoreRW::saveScore(score, parallel ? u"part-all-uparallel.mscx" : u"part-all-usequential.mscx"));
+        delete score;
+    }
+
+    setParallelPartsLayoutEnabled(false);
+
+    EXPECT_TRUE(ScoreComp::compareFiles(u"part-all-sequential.mscx", u"part-all-parallel.mscx"));
+    EXPECT_TRUE(ScoreComp::compareFiles(u"part-all-usequential.mscx", u"part-all-uparallel.mscx"));
+
+    EXPECT_FALSE(rects[0].empty());
+    EXPECT_EQ(rects[0], rects[1]);
+    EXPECT_EQ(undoRects[0], undoRects[1]);
+}
+
+//---------------------------------------------------------
+//   crossScoreChanges
+//    while a part is laid out concurrently, its changes
+//    of the other scores wait until they are replayed
+//---------------------------------------------------------
+
+TEST_F(Engraving_PartsTests, crossScoreChanges)
+{
+    MasterScore* score = ScoreRW::readScore(PARTS_DATA_DIR + u"part-all.mscx");
+    ASSERT_TRUE(score);
+
+    createParts(score);
+
+    ChordRest* masterCr = toChordRest(score->firstMeasure()->first(SegmentType::ChordRest)->element(0));
+    ASSERT_TRUE(masterCr);
+
+    ChordRest* partCr = nullptr;
+    for (EngravingObject* linked : masterCr->linkList()) {
+        if (linked->score() != score) {
+            partCr = toChordRest(linked);
+            break;
+        }
+    }
+    ASSERT_TRUE(partCr);
+
+    score->startCmd();
+
+    {
+        CrossScoreChanges changes(partCr->score());
+        {
+            CrossScoreChanges::Scope scope(&changes);
+            partCr->score()->undo(new ChangeProperty(partCr, Pid::VISIBLE, false));
+            score->undo(new ChangeProperty(masterCr, Pid::VISIBLE, false));
+        }
+
+        EXPECT_FALSE(partCr->visible());
+        EXPECT_TRUE(masterCr->visible());
+        EXPECT_EQ(changes.changedScores(), std::set<Score*>({ score }));
+
+        changes.replay(score->undoStack());
+    }
+
+    EXPECT_FALSE(masterCr->visible());
+    EXPECT_EQ(score->undoStack()->current()->childCount(), 2);
+
+    score->endCmd();
+
+    score->undoRedo(true, 0);
+
+    EXPECT_TRUE(partCr->visible());
+    EXPECT_TRUE(masterCr->visible());
+
+    delete score;
+}
+
 //---------------------------------------------------------
 //   styleScore
 //---------------------------------------------------------
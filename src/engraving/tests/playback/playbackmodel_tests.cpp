@@ -816,7 +816,7 @@ TEST_F(Engraving_PlaybackModelTests, Multi_Measure_Repeat)
  *          Additionally, there is a simple repeat from measure 2 up to measure 3. In total, we'll be playing 6 measures overall
  *
  *          When the model will be loaded we'll emulate a change notification on the 2-nd measure, so that there will be updated events
- *          on the main stream channel
+ *          on the range changes channel. Only the events within the changed ranges are sent
  */
 TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
 {
@@ -833,8 +833,8 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
     // [GIVEN] The articulation profiles repository will be returning profiles for StringsArticulation family
     ON_CALL(*m_repositoryMock, defaultProfile(ArticulationFamily::Strings)).WillByDefault(Return(m_defaultProfile));
 
-    // [GIVEN] Expected amount of changed events
-    int expectedChangedEventsCount = 24;
+    // [GIVEN] Expected amount of events after the change
+    size_t expectedEventsCount = 24;
 
     // [GIVEN] The playback model requested to be loaded
     PlaybackModel model;
@@ -843,10 +843,21 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
 
     PlaybackData result = model.resolveTrackPlaybackData(part->id(), part->instrumentId());
 
-    // [THEN] Updated events map will match our expectations
-    result.mainStream.onReceive(this, [expectedChangedEventsCount](const PlaybackEventsMap& updatedEvents, const DynamicLevelLayers&,
-                                                                   const PlaybackParamLayers&) {
-        EXPECT_EQ(updatedEvents.size(), expectedChangedEventsCount);
+    // [GIVEN] The receiver side keeps its own copy of the events
+    PlaybackEventsMap receivedEvents = result.originEvents;
+    size_t sentEventsCount = 0;
+    bool fullEventsReceived = false;
+
+    result.mainStream.onReceive(this, [&fullEventsReceived](const PlaybackEventsMap&, const DynamicLevelLayers&,
+                                                            const PlaybackParamLayers&) {
+        fullEventsReceived = true;
+    });
+
+    result.mainStreamRanges.onReceive(this, [&receivedEvents, &sentEventsCount](const TimestampRangeList& ranges,
+                                                                                const PlaybackEventsMap& updatedEvents,
+                                                                                const DynamicLevelLayers&, const PlaybackParamLayers&) {
+        sentEventsCount += updatedEvents.size();
+        applyRangeChanges(receivedEvents, ranges, updatedEvents);
     });
 
     // [WHEN] Notation has been changed
@@ -858,6 +869,16 @@ TEST_F(Engraving_PlaybackModelTests, SimpleRepeat_Changes_Notification)
     range.changedTypes = { ElementType::NOTE };
 
     score->changesChannel().send(range);
+
+    // [THEN] Only a part of the events has been sent
+    EXPECT_FALSE(fullEventsReceived);
+    EXPECT_GT(sentEventsCount, 0);
+    EXPECT_LT(sentEventsCount, expectedEventsCount);
+
+    // [THEN] The receiver side ends up with the same events as the model
+    const PlaybackEventsMap& modelEvents = model.resolveTrackPlaybackData(part->id(), part->instrumentId()).originEvents;
+    EXPECT_EQ(modelEvents.size(), expectedEventsCount);
+    EXPECT_EQ(receivedEvents, modelEvents);
 }
 
 /**
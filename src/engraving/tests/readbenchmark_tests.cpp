@@ -0,0 +1,157 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "io/file.h"
+#include "rw/xmlreader.h"
+#include "dom/masterscore.h"
+#include "dom/measure.h"
+#include "dom/segment.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const std::vector<String> LARGE_SCORES = {
+    u"concertpitch_data/concertpitchbenchmark.mscx",
+    u"all_elements_data/moonlight.mscx",
+};
+
+static constexpr int XML_READ_REPEATS = 20;
+static constexpr int SCORE_READ_REPEATS = 3;
+static constexpr int PASTE_REPEATS = 3;
+static constexpr int LAYOUT_REPEATS = 3;
+
+class Engraving_ReadBenchmarkTests : public ::testing::Test
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static double elapsedMs(const Clock::time_point& start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+};
+
+//! NOTE: Run with --gtest_also_run_disabled_tests
+TEST_F(Engraving_ReadBenchmarkTests, DISABLED_ReadLargeScores)
+{
+    for (const String& fileName : LARGE_SCORES) {
+        muse::ByteArray data;
+        ASSERT_TRUE(muse::io::File::readFile(ScoreRW::rootPath() + u"/" + fileName, data));
+
+        // [GIVEN] The raw xml of a large score
+        // [WHEN] Read all the tokens
+        size_t tokens = 0;
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < XML_READ_REPEATS; ++i) {
+            XmlReader xml(data);
+            while (xml.readNext() != muse::XmlStreamReader::Invalid) {
+                ++tokens;
+            }
+
+            // [THEN] The document is well-formed
+            EXPECT_FALSE(xml.isError());
+        }
+        double xmlMs = elapsedMs(start) / XML_READ_REPEATS;
+
+        // [WHEN] Read the score
+        start = Clock::now();
+        for (int i = 0; i < SCORE_READ_REPEATS; ++i) {
+            MasterScore* score = ScoreRW::readScore(fileName);
+            EXPECT_TRUE(score);
+            delete score;
+        }
+        double scoreMs = elapsedMs(start) / SCORE_READ_REPEATS;
+
+        LOGI() << fileName << ": " << data.size() << " bytes, " << tokens / XML_READ_REPEATS << " tokens, "
+               << "xml: " << xmlMs << " ms, score: " << scoreMs << " ms";
+    }
+}
+
+TEST_F(Engraving_ReadBenchmarkTests, PasteLargeScores)
+{
+    for (const String& fileName : LARGE_SCORES) {
+        MasterScore* score = ScoreRW::readScore(fileName);
+        ASSERT_TRUE(score);
+
+        const int measures = score->nmeasures();
+
+        // [GIVEN] The whole score copied
+        score->select(score->firstMeasure(), SelectType::RANGE, 0);
+        score->select(score->lastMeasure(), SelectType::RANGE, score->nstaves() - 1);
+        ASSERT_TRUE(score->selection().canCopy());
+
+        muse::ByteArray data = score->selection().mimeData();
+
+        // [WHEN] Paste it over itself
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < PASTE_REPEATS; ++i) {
+            Segment* dst = score->firstMeasure()->first(SegmentType::ChordRest);
+            ASSERT_TRUE(dst);
+
+            XmlReader xml(data);
+            score->startCmd();
+            EXPECT_TRUE(score->pasteStaff(xml, dst, 0));
+            score->endCmd();
+        }
+        double pasteMs = elapsedMs(start) / PASTE_REPEATS;
+
+        // [THEN] The score keeps its length
+        EXPECT_EQ(score->nmeasures(), measures);
+
+        LOGI() << fileName << ": " << data.size() << " bytes, paste: " << pasteMs << " ms";
+
+        delete score;
+    }
+}
+
+//! NOTE: Run with --gtest_also_run_disabled_tests
+TEST_F(Engraving_ReadBenchmarkTests, DISABLED_LayoutLargeScores)
+{
+    for (const String& fileName : LARGE_SCORES) {
+        // [GIVEN] A large score
+        MasterScore* score = ScoreRW::readScore(fileName);
+        ASSERT_TRUE(score);
+
+        // [WHEN] Lay it out from scratch
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < LAYOUT_REPEATS; ++i) {
+            score->doLayout();
+        }
+        double layoutMs = elapsedMs(start) / LAYOUT_REPEATS;
+
+        // [THEN] It has pages
+        EXPECT_FALSE(score->pages().empty());
+
+        LOGI() << fileName << ": " << score->nstaves() << " staves, " << score->nmeasures() << " measures, "
+               << "layout: " << layoutMs << " ms";
+
+        delete score;
+    }
+}
@@ -0,0 +1,169 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <random>
+
+#include "infrastructure/shape.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const std::vector<double> CLEARANCES = { -1.0, 0.0, 0.3, 2.0 };
+
+static constexpr int BENCHMARK_ELEMENTS = 24;
+static constexpr int BENCHMARK_REPEATS = 200000;
+
+class Engraving_ShapeTests : public ::testing::Test
+{
+public:
+    //! NOTE Also flat, zero and negative width rects, and negative zero heights
+    static Shape randomShape(std::mt19937& gen, int count)
+    {
+        std::uniform_int_distribution<int> x(0, 20);
+        std::uniform_int_distribution<int> w(-1, 8);
+        std::uniform_real_distribution<double> y(-5.0, 5.0);
+        std::uniform_int_distribution<int> h(-1, 5);
+
+        Shape shape;
+        for (int i = 0; i < count; ++i) {
+            double height = h(gen);
+            shape.add(RectF(x(gen) / 2.0, y(gen), w(gen) / 2.0, height == 0.0 && i % 2 ? -0.0 : height));
+        }
+
+        return shape;
+    }
+
+    //! NOTE Plain nested loops over the elements, the queries must give exactly the same results
+    static double referenceMinVerticalDistance(const Shape& above, const Shape& below, double clearance)
+    {
+        if (above.empty() || below.empty()) {
+            return 0.0;
+        }
+
+        double dist = -DBL_MAX;
+        for (const RectF& r2 : below.elements()) {
+            if (r2.height() <= 0.0) {
+                continue;
+            }
+            for (const RectF& r1 : above.elements()) {
+                if (r1.height() <= 0.0) {
+                    continue;
+                }
+                if (intersects(r1.left(), r1.right(), r2.left(), r2.right(), clearance)) {
+                    dist = std::max(dist, r1.bottom() - r2.top());
+                }
+            }
+        }
+        return dist;
+    }
+
+    static double referenceVerticalClearance(const Shape& above, const Shape& below, double clearance)
+    {
+        if (above.empty() || below.empty()) {
+            return 0.0;
+        }
+
+        double dist = DBL_MAX;
+        for (const RectF& r2 : below.elements()) {
+            if (r2.height() <= 0.0) {
+                continue;
+            }
+            for (const RectF& r1 : above.elements()) {
+                if (r1.height() <= 0.0) {
+                    continue;
+                }
+                if (intersects(r1.left(), r1.right(), r2.left(), r2.right(), clearance)) {
+                    dist = std::min(dist, r2.top() - r1.bottom());
+                }
+            }
+        }
+        return dist;
+    }
+
+    static bool bitEqual(double d1, double d2)
+    {
+        return std::memcmp(&d1, &d2, sizeof(double)) == 0;
+    }
+};
+
+/**
+ * @brief Engraving_ShapeTests_VerticalDistancesMatchReference
+ * @details Check that the vertical distances between shapes are exactly the ones of the reference loops,
+ *          for shapes both smaller and larger than the packed geometry's inline storage
+ */
+TEST_F(Engraving_ShapeTests, VerticalDistancesMatchReference)
+{
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> count(0, 40);
+
+    for (int i = 0; i < 5000; ++i) {
+        // [GIVEN] Two random shapes
+        Shape above = randomShape(gen, count(gen));
+        Shape below = randomShape(gen, count(gen));
+
+        for (double clearance : CLEARANCES) {
+            // [THEN] The distances are the same, bit for bit
+            EXPECT_TRUE(bitEqual(above.minVerticalDistance(below, clearance),
+                                 referenceMinVerticalDistance(above, below, clearance)));
+            EXPECT_TRUE(bitEqual(above.verticalClearance(below, clearance),
+                                 referenceVerticalClearance(above, below, clearance)));
+        }
+    }
+}
+
+//! NOTE: Run with --gtest_also_run_disabled_tests
+TEST_F(Engraving_ShapeTests, DISABLED_VerticalDistanceBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // [GIVEN] Two shapes of the size of a segment's staff shape
+    std::mt19937 gen(1);
+    Shape above = randomShape(gen, BENCHMARK_ELEMENTS);
+    Shape below = randomShape(gen, BENCHMARK_ELEMENTS);
+
+    // [WHEN] Measure the distance between them
+    double referenceDistance = 0.0;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < BENCHMARK_REPEATS; ++i) {
+        referenceDistance += referenceMinVerticalDistance(above, below, 0.3);
+    }
+    double referenceMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    double shapeDistance = 0.0;
+    start = Clock::now();
+    for (int i = 0; i < BENCHMARK_REPEATS; ++i) {
+        shapeDistance += above.minVerticalDistance(below, 0.3);
+    }
+    double shapeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // [THEN] The results are the same
+    EXPECT_EQ(shapeDistance, referenceDistance);
+
+    LOGI() << BENCHMARK_REPEATS << " queries of " << BENCHMARK_ELEMENTS << " elements, "
+           << "reference: " << referenceMs << " ms, shape: " << shapeMs << " ms";
+}
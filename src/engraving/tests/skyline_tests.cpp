@@ -0,0 +1,311 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+
+#include "dom/masterscore.h"
+#include "dom/segment.h"
+
+#include "infrastructure/shape.h"
+#include "infrastructure/skyline.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const std::vector<double> CLEARANCES = { 0.0, 0.25, 1.0, 3.0 };
+
+static const String SKYLINE_DATA_DIR(u"measure_data/");
+
+static constexpr int BENCHMARK_ELEMENTS = 5000;
+static constexpr int BENCHMARK_REPEATS = 20;
+
+class Engraving_SkylineTests : public ::testing::Test
+{
+public:
+    //! NOTE Rects on a coarse grid, so that the edges often coincide,
+    //! including flat and zero width ones
+    static Shape randomShape(std::mt19937& gen, int count, double width)
+    {
+        std::uniform_int_distribution<int> x(0, static_cast<int>(width * 2));
+        std::uniform_int_distribution<int> w(0, 10);
+        std::uniform_int_distribution<int> y(-10, 10);
+        std::uniform_int_distribution<int> h(-1, 8);
+
+        Shape shape;
+        for (int i = 0; i < count; ++i) {
+            shape.add(RectF(x(gen) / 2.0, y(gen), w(gen) / 2.0, h(gen)));
+        }
+
+        return shape;
+    }
+
+    //! NOTE The lines only compare the items, any items of a score will do
+    static std::vector<const EngravingItem*> segmentsOf(const MasterScore* score)
+    {
+        std::vector<const EngravingItem*> items;
+        for (const Segment* s = score->firstSegment(SegmentType::All); s; s = s->next1()) {
+            items.push_back(s);
+        }
+
+        return items;
+    }
+
+    static Shape withItems(const Shape& shape, const std::vector<const EngravingItem*>& items)
+    {
+        Shape result;
+        for (size_t i = 0; i < shape.elements().size(); ++i) {
+            result.add(shape.elements().at(i), items.at(i % items.size()));
+        }
+
+        return result;
+    }
+
+    static void translateItem(Shape& shape, const EngravingItem* item, double y)
+    {
+        for (ShapeElement& r : shape.elements()) {
+            if (r.item() == item) {
+                r.translate(0.0, y);
+            }
+        }
+    }
+
+    static void checkDistances(const Shape& above, const Shape& below, const SkylineLine& south, const SkylineLine& north)
+    {
+        for (double clearance : CLEARANCES) {
+            double expected = above.minVerticalDistance(below, clearance);
+            EXPECT_EQ(south.minDistance(north, clearance), expected);
+            EXPECT_EQ(south.minDistanceToShapeBelow(below, clearance), expected);
+            EXPECT_EQ(north.minDistanceToShapeAbove(above, clearance), expected);
+        }
+
+        EXPECT_EQ(south.verticalClaranceBelow(below), above.verticalClearance(below));
+        EXPECT_EQ(north.verticalClearanceAbove(above), above.verticalClearance(below));
+    }
+};
+
+/**
+ * @brief Engraving_SkylineTests_MinDistanceMatchesShape
+ * @details Check that the distances between skyline lines are the same as the ones between their shapes
+ */
+TEST_F(Engraving_SkylineTests, MinDistanceMatchesShape)
+{
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<int> count(0, 16);
+
+    for (int i = 0; i < 2000; ++i) {
+        // [GIVEN] Two random shapes, one above the other, and the skyline lines of them
+        Shape above = randomShape(gen, count(gen), 20.0);
+        Shape below = randomShape(gen, count(gen), 20.0);
+
+        SkylineLine south(false);
+        south.add(above);
+        SkylineLine north(true);
+        north.add(below);
+
+        // [THEN] The skyline lines give the same distances as the shapes
+        checkDistances(above, below, south, north);
+
+        // [WHEN] Move the lower line down
+        below.translateY(2.5);
+        north.translateY(2.5);
+
+        // [THEN] The distances follow
+        checkDistances(above, below, south, north);
+
+        // [WHEN] Remove the wide elements
+        auto isWide = [](const ShapeElement& r) { return r.width() > 3.0; };
+        above.remove_if(isWide);
+        south.remove_if(isWide);
+
+        // [THEN] The distances follow
+        checkDistances(above, below, south, north);
+    }
+}
+
+/**
+ * @brief Engraving_SkylineTests_TranslateItems
+ * @details Check that the distances follow the elements of the items moved one by one
+ */
+TEST_F(Engraving_SkylineTests, TranslateItems)
+{
+    MasterScore* score = ScoreRW::readScore(SKYLINE_DATA_DIR + u"measure-4.mscx");
+    ASSERT_TRUE(score);
+
+    const std::vector<const EngravingItem*> items = segmentsOf(score);
+    ASSERT_GE(items.size(), 4);
+
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<int> shift(-6, 6);
+
+    for (int i = 0; i < 200; ++i) {
+        // [GIVEN] Two random shapes of the items, one above the other, and the skyline lines of them
+        Shape above = withItems(randomShape(gen, 32, 20.0), items);
+        Shape below = withItems(randomShape(gen, 32, 20.0), items);
+
+        SkylineLine south(false);
+        south.add(above);
+        SkylineLine north(true);
+        north.add(below);
+
+        // [WHEN] Move the items one by one, in both lines
+        for (const EngravingItem* item : items) {
+            double y = shift(gen) / 2.0;
+            translateItem(below, item, y);
+            north.translateY(item, y);
+
+            translateItem(above, item, -y);
+            south.translateY(item, -y);
+        }
+
+        // [THEN] The distances follow
+        checkDistances(above, below, south, north);
+
+        // [WHEN] Move one more and add an element
+        translateItem(below, items.front(), 1.5);
+        north.translateY(items.front(), 1.5);
+        below.add(RectF(3.0, -20.0, 2.0, 4.0));
+        north.add(RectF(3.0, -20.0, 2.0, 4.0), nullptr);
+
+        // [THEN] The distances follow
+        checkDistances(above, below, south, north);
+    }
+
+    delete score;
+}
+
+/**
+ * @brief Engraving_SkylineTests_MinDistanceOfEmptyLine
+ * @details Check the distances when one of the lines has no elements or no element in reach
+ */
+TEST_F(Engraving_SkylineTests, MinDistanceOfEmptyLine)
+{
+    // [GIVEN] A line with one element and an empty line
+    SkylineLine south(false);
+    south.add(RectF(0.0, 0.0, 10.0, 4.0), nullptr);
+    SkylineLine north(true);
+
+    // [THEN] The distance is zero
+    EXPECT_EQ(south.minDistance(north), 0.0);
+    EXPECT_EQ(north.minDistance(south), 0.0);
+
+    // [WHEN] Add an element far to the right
+    north.add(RectF(20.0, 6.0, 10.0, 4.0), nullptr);
+
+    // [THEN] Nothing collides
+    EXPECT_EQ(south.minDistance(north), -DBL_MAX);
+    EXPECT_EQ(south.verticalClaranceBelow(Shape(RectF(20.0, 6.0, 10.0, 4.0))), DBL_MAX);
+
+    // [THEN] Unless it's within the clearance
+    EXPECT_EQ(south.minDistance(north, 10.5), -2.0);
+
+    // [WHEN] Clear the line
+    south.clear();
+
+    // [THEN] The distance is zero again
+    EXPECT_EQ(south.minDistance(north, 10.5), 0.0);
+}
+
+//! NOTE: Run with --gtest_also_run_disabled_tests
+TEST_F(Engraving_SkylineTests, DISABLED_MinDistanceBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // [GIVEN] Two long lines, like the ones of the staves of a wide system
+    std::mt19937 gen(1);
+    Shape above = randomShape(gen, BENCHMARK_ELEMENTS, BENCHMARK_ELEMENTS);
+    Shape below = randomShape(gen, BENCHMARK_ELEMENTS, BENCHMARK_ELEMENTS);
+
+    Clock::time_point start = Clock::now();
+    SkylineLine south(false);
+    south.add(above);
+    SkylineLine north(true);
+    north.add(below);
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // [WHEN] Measure the distance between them
+    double shapeDistance = 0.0;
+    start = Clock::now();
+    for (int i = 0; i < BENCHMARK_REPEATS; ++i) {
+        shapeDistance = above.minVerticalDistance(below, 1.0);
+    }
+    double shapeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / BENCHMARK_REPEATS;
+
+    double skylineDistance = 0.0;
+    start = Clock::now();
+    for (int i = 0; i < BENCHMARK_REPEATS; ++i) {
+        skylineDistance = south.minDistance(north, 1.0);
+    }
+    double skylineMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / BENCHMARK_REPEATS;
+
+    // [THEN] The results are the same
+    EXPECT_EQ(skylineDistance, shapeDistance);
+
+    LOGI() << BENCHMARK_ELEMENTS << " elements, build: " << buildMs << " ms, "
+           << "shape: " << shapeMs << " ms, skyline: " << skylineMs << " ms";
+}
+
+//! NOTE: Run with --gtest_also_run_disabled_tests
+TEST_F(Engraving_SkylineTests, DISABLED_TranslateItemsBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // [GIVEN] Two long lines of the elements of many items, like the ones of a wide system
+    MasterScore* score = ScoreRW::readScore(SKYLINE_DATA_DIR + u"measure-4.mscx");
+    ASSERT_TRUE(score);
+
+    const std::vector<const EngravingItem*> items = segmentsOf(score);
+
+    std::mt19937 gen(1);
+    Shape above = withItems(randomShape(gen, BENCHMARK_ELEMENTS, BENCHMARK_ELEMENTS), items);
+    Shape below = withItems(randomShape(gen, BENCHMARK_ELEMENTS, BENCHMARK_ELEMENTS), items);
+
+    SkylineLine south(false);
+    south.add(above);
+    SkylineLine north(true);
+    north.add(below);
+
+    // [WHEN] Move every item and then measure the distance, as when the items of a row are aligned
+    double distance = 0.0;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < BENCHMARK_REPEATS; ++i) {
+        for (const EngravingItem* item : items) {
+            north.translateY(item, (i % 2) ? 0.5 : -0.5);
+        }
+        distance = south.minDistance(north, 1.0);
+    }
+    double translateMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / BENCHMARK_REPEATS;
+
+    // [THEN] The result is the one of the shapes, which are back where they were
+    EXPECT_EQ(distance, above.minVerticalDistance(below, 1.0));
+
+    LOGI() << BENCHMARK_ELEMENTS << " elements, " << items.size() << " items, "
+           << "translate all and measure: " << translateMs << " ms";
+
+    delete score;
+}
@@ -0,0 +1,181 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "dom/chord.h"
+#include "dom/masterscore.h"
+#include "dom/measure.h"
+#include "dom/segment.h"
+#include "dom/undo.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String UNDO_DATA_DIR(u"box_data/");
+static const String MEASURE_DATA_DIR(u"measure_data/");
+
+class Engraving_UndoTests : public ::testing::Test
+{
+public:
+    static void pushStretchMacro(MasterScore* score, double stretch)
+    {
+        UndoStack* undoStack = score->undoStack();
+        undoStack->beginMacro(score);
+        undoStack->push(new ChangeProperty(score->firstMeasure(), Pid::USER_STRETCH, stretch), nullptr);
+        undoStack->endMacro(false);
+    }
+
+    static void pushRemoveMacro(MasterScore* score, EngravingItem* item)
+    {
+        UndoStack* undoStack = score->undoStack();
+        undoStack->beginMacro(score);
+        undoStack->push(new RemoveElement(item), nullptr);
+        undoStack->endMacro(false);
+    }
+};
+
+TEST_F(Engraving_UndoTests, MergeRepeatedPropertyChanges)
+{
+    //! [GIVEN] A score
+    MasterScore* score = ScoreRW::readScore(UNDO_DATA_DIR + u"undoRemoveVBox.mscx");
+    ASSERT_TRUE(score);
+
+    Measure* measure = score->firstMeasure();
+    ASSERT_TRUE(measure);
+
+    const double initialStretch = measure->userStretch();
+    UndoStack* undoStack = score->undoStack();
+
+    //! [WHEN] The same property is changed several times in one macro
+    undoStack->beginMacro(score);
+    undoStack->push(new ChangeProperty(measure, Pid::USER_STRETCH, 1.5), nullptr);
+    undoStack->push(new ChangeProperty(measure, Pid::USER_STRETCH, 2.0), nullptr);
+    undoStack->push(new ChangeProperty(measure, Pid::USER_STRETCH, 2.5), nullptr);
+
+    //! [THEN] Only the first command is kept
+    EXPECT_EQ(undoStack->current()->childCount(), 1);
+
+    undoStack->endMacro(false);
+    EXPECT_DOUBLE_EQ(measure->userStretch(), 2.5);
+
+    //! [THEN] Undo restores the value from before the macro, redo the last one
+    undoStack->undo(nullptr);
+    EXPECT_DOUBLE_EQ(measure->userStretch(), initialStretch);
+
+    undoStack->redo(nullptr);
+    EXPECT_DOUBLE_EQ(measure->userStretch(), 2.5);
+
+    delete score;
+}
+
+TEST_F(Engraving_UndoTests, DropOldestMacrosOverMemoryLimit)
+{
+    //! [GIVEN] A score
+    MasterScore* score = ScoreRW::readScore(UNDO_DATA_DIR + u"undoRemoveVBox.mscx");
+    ASSERT_TRUE(score);
+
+    UndoStack* undoStack = score->undoStack();
+
+    //! [WHEN] Macros are pushed without a memory limit
+    pushStretchMacro(score, 1.5);
+    const size_t oneMacroUsage = undoStack->memoryUsage();
+    pushStretchMacro(score, 2.0);
+
+    //! [THEN] All of them are kept and counted
+    EXPECT_EQ(undoStack->macroCount(), 2);
+    EXPECT_GT(oneMacroUsage, 0);
+    EXPECT_GT(undoStack->memoryUsage(), oneMacroUsage);
+
+    //! [WHEN] The limit is lower than a single macro
+    undoStack->setMemoryLimit(1);
+    pushStretchMacro(score, 2.5);
+    pushStretchMacro(score, 3.0);
+
+    //! [THEN] Only the last macro is kept, the indices still count the dropped ones
+    EXPECT_EQ(undoStack->macroCount(), 1);
+    EXPECT_EQ(undoStack->getCurIdx(), 4);
+    EXPECT_LT(undoStack->memoryUsage(), 2 * oneMacroUsage);
+
+    //! [THEN] The last edit can still be undone
+    ASSERT_TRUE(undoStack->canUndo());
+    undoStack->undo(nullptr);
+    EXPECT_DOUBLE_EQ(score->firstMeasure()->userStretch(), 2.5);
+    EXPECT_FALSE(undoStack->canUndo());
+    EXPECT_EQ(undoStack->getCurIdx(), 3);
+
+    delete score;
+}
+
+TEST_F(Engraving_UndoTests, DropOldestRemoveElementMacrosOverMemoryLimit)
+{
+    //! [GIVEN] A score with chords
+    MasterScore* score = ScoreRW::readScore(MEASURE_DATA_DIR + u"measure-4.mscx");
+    ASSERT_TRUE(score);
+
+    std::vector<Chord*> chords;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        EngravingItem* item = s->element(0);
+        if (item && item->isChord()) {
+            chords.push_back(toChord(item));
+        }
+    }
+    ASSERT_GE(chords.size(), 8);
+
+    UndoStack* undoStack = score->undoStack();
+
+    //! [WHEN] The chords are removed one by one without a memory limit
+    for (Chord* chord : chords) {
+        pushRemoveMacro(score, chord);
+    }
+
+    //! [THEN] The removed chords and their notes are counted, not only the commands
+    const size_t removedUsage = undoStack->memoryUsage();
+    EXPECT_EQ(undoStack->macroCount(), chords.size());
+    EXPECT_GT(removedUsage, chords.size() * 2 * sizeof(EngravingItem));
+
+    //! [WHEN] The limit is half of that and one more edit is made
+    undoStack->setMemoryLimit(removedUsage / 2);
+    pushStretchMacro(score, 1.5);
+
+    //! [THEN] The oldest removals are dropped to stay within the limit, the indices still count them
+    EXPECT_LE(undoStack->memoryUsage(), undoStack->memoryLimit());
+    EXPECT_LT(undoStack->macroCount(), chords.size());
+    EXPECT_GT(undoStack->macroCount(), 1);
+    EXPECT_EQ(undoStack->getCurIdx(), chords.size() + 1);
+
+    //! [THEN] The kept edits can still be undone, the last removed chord is back
+    const size_t keptCount = undoStack->macroCount();
+    for (size_t i = 0; i < keptCount; ++i) {
+        ASSERT_TRUE(undoStack->canUndo());
+        undoStack->undo(nullptr);
+    }
+
+    EXPECT_FALSE(undoStack->canUndo());
+
+    Chord* lastChord = chords.back();
+    EXPECT_EQ(lastChord->segment()->element(lastChord->track()), lastChord);
+
+    delete score;
+}
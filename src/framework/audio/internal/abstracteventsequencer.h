@@ -23,13 +23,13 @@
 #ifndef MUSE_AUDIO_ABSTRACTEVENTSEQUENCER_H
 #define MUSE_AUDIO_ABSTRACTEVENTSEQUENCER_H
 
-#include <map>
-#include <set>
+#include <vector>
 
 #include "global/async/asyncable.h"
 #include "mpe/events.h"
 
 #include "audiosanitizer.h"
+#include "eventtimeline.h"
 #include "../audiotypes.h"
 
 namespace muse::audio {
@@ -38,15 +38,13 @@ class AbstractEventSequencer : public async::Asyncable
 {
 public:
     using EventType = std::variant<Types...>;
-    using EventSequence = std::set<EventType>;
-    using EventSequenceMap = std::map<msecs_t, EventSequence>;
-
-    typedef typename EventSequenceMap::const_iterator SequenceIterator;
-    typedef typename EventSequence::const_iterator EventIterator;
+    using EventSequence = std::vector<EventType>;
+    using EventTimeline = audio::EventTimeline<EventType>;
 
     virtual ~AbstractEventSequencer()
     {
         m_mainStreamChanges.resetOnReceive(this);
+        m_mainStreamRangeChanges.resetOnReceive(this);
         m_offStreamChanges.resetOnReceive(this);
     }
 
@@ -55,6 +53,7 @@ public:
         ONLY_AUDIO_WORKER_THREAD;
 
         m_mainStreamChanges = data.mainStream;
+        m_mainStreamRangeChanges = data.mainStreamRanges;
         m_offStreamChanges = data.offStream;
 
         m_mainStreamChanges.onReceive(this,
@@ -63,6 +62,11 @@ public:
             updateMainStreamEvents(events, dynamics, params);
         });
 
+        m_mainStreamRangeChanges.onReceive(this, [this](const mpe::TimestampRangeList& ranges, const mpe::PlaybackEventsMap& events,
+                                                        const mpe::DynamicLevelLayers& dynamics, const mpe::PlaybackParamLayers& params) {
+            updateMainStreamEvents(ranges, events, dynamics, params);
+        });
+
         m_offStreamChanges.onReceive(this, [this](const mpe::PlaybackEventsMap& events, const mpe::PlaybackParamList& params) {
             updateOffStreamEvents(events, params);
         });
@@ -74,6 +78,10 @@ public:
     virtual void updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
                                         const mpe::PlaybackParamLayers& params) = 0;
 
+    //! NOTE: Replaces the events within the given ranges, the events outside of them stay as they are
+    virtual void updateMainStreamEvents(const mpe::TimestampRangeList& ranges, const mpe::PlaybackEventsMap& events,
+                                        const mpe::DynamicLevelLayers& dynamics, const mpe::PlaybackParamLayers& params) = 0;
+
     void setActive(const bool active)
     {
         m_isActive = active;
@@ -128,108 +136,111 @@ public:
         return mpe::dynamicLevelFromType(muse::mpe::DynamicType::Natural);
     }
 
-    EventSequence eventsToBePlayed(const msecs_t nextMsecs)
+    //! NOTE: The returned sequence is reused by the next call
+    const EventSequence& eventsToBePlayed(const msecs_t nextMsecs)
     {
         ONLY_AUDIO_WORKER_THREAD;
 
-        EventSequence result;
+        m_eventsToBePlayed.clear();
 
         if (!m_isActive) {
-            handleOffStream(result, nextMsecs);
-            return result;
+            handleOffStream(nextMsecs);
+            return m_eventsToBePlayed;
         }
 
-        if (m_currentMainSequenceIt == m_mainStreamEvents.cend()) {
-            return result;
+        if (m_currentMainSequenceIdx >= m_mainStreamEvents.size()) {
+            return m_eventsToBePlayed;
         }
 
         m_playbackPosition += nextMsecs;
 
-        handleMainStream(result);
-        handleDynamicChanges(result);
+        handleMainStream();
+        handleDynamicChanges();
 
-        return result;
+        return m_eventsToBePlayed;
     }
 
 protected:
     void resetAllIterators()
     {
+        //! NOTE: The off stream is relative to the moment it was received,
+        //! so it doesn't depend on the playback position
         updateMainSequenceIterator();
-        updateOffSequenceIterator();
         updateDynamicChangesIterator();
     }
 
     void updateMainSequenceIterator()
     {
-        m_currentMainSequenceIt = m_mainStreamEvents.lower_bound(m_playbackPosition);
+        m_currentMainSequenceIdx = m_mainStreamEvents.lowerBound(m_playbackPosition);
+        reserveEventsToBePlayed();
     }
 
     void updateOffSequenceIterator()
     {
-        m_currentOffSequenceIt = m_offStreamEvents.cbegin();
+        m_currentOffSequenceIdx = 0;
+        m_offStreamPosition = 0;
+        reserveEventsToBePlayed();
     }
 
     void updateDynamicChangesIterator()
     {
-        m_currentDynamicsIt = m_dynamicEvents.lower_bound(m_playbackPosition);
+        m_currentDynamicsIdx = m_dynamicEvents.lowerBound(m_playbackPosition);
+        reserveEventsToBePlayed();
     }
 
-    void handleOffStream(EventSequence& result, const msecs_t nextMsecs)
+    //! NOTE: Keeps eventsToBePlayed() allocation free in the usual case, when a single call collects one timestamp
+    void reserveEventsToBePlayed()
     {
-        if (m_offStreamEvents.empty() || m_currentOffSequenceIt == m_offStreamEvents.cend()) {
-            return;
-        }
+        size_t maxEventsCount = std::max(m_mainStreamEvents.maxEventsPerTime() + m_dynamicEvents.maxEventsPerTime(),
+                                         m_offStreamEvents.maxEventsPerTime());
 
-        if (m_currentOffSequenceIt->first <= nextMsecs) {
-            result = m_currentOffSequenceIt->second;
-            m_currentOffSequenceIt = m_offStreamEvents.erase(m_currentOffSequenceIt);
-        } else {
-            auto node = m_offStreamEvents.extract(m_currentOffSequenceIt);
-            node.key() -= nextMsecs;
-            m_offStreamEvents.insert(std::move(node));
-            updateOffSequenceIterator();
-        }
+        m_eventsToBePlayed.reserve(maxEventsCount);
     }
 
-    void handleMainStream(EventSequence& result)
+    void appendEvents(const EventTimeline& events, size_t& idx, const msecs_t position)
     {
-        if (m_currentMainSequenceIt->first <= m_playbackPosition) {
-            result.insert(m_currentMainSequenceIt->second.cbegin(),
-                          m_currentMainSequenceIt->second.cend());
-
-            m_currentMainSequenceIt = std::next(m_currentMainSequenceIt);
+        while (idx < events.size() && events.time(idx) <= position) {
+            m_eventsToBePlayed.insert(m_eventsToBePlayed.end(), events.eventsBegin(idx), events.eventsEnd(idx));
+            ++idx;
         }
     }
 
-    void handleDynamicChanges(EventSequence& result)
+    void handleOffStream(const msecs_t nextMsecs)
     {
-        if (m_dynamicEvents.empty() || m_currentDynamicsIt == m_dynamicEvents.cend()) {
-            return;
-        }
+        appendEvents(m_offStreamEvents, m_currentOffSequenceIdx, m_offStreamPosition + nextMsecs);
+        m_offStreamPosition += nextMsecs;
+    }
 
-        if (m_currentDynamicsIt->first <= m_playbackPosition) {
-            result.insert(m_currentDynamicsIt->second.cbegin(),
-                          m_currentDynamicsIt->second.cend());
+    void handleMainStream()
+    {
+        appendEvents(m_mainStreamEvents, m_currentMainSequenceIdx, m_playbackPosition);
+    }
 
-            m_currentDynamicsIt = std::next(m_currentDynamicsIt);
-        }
+    void handleDynamicChanges()
+    {
+        appendEvents(m_dynamicEvents, m_currentDynamicsIdx, m_playbackPosition);
     }
 
     mutable msecs_t m_playbackPosition = 0;
 
-    SequenceIterator m_currentMainSequenceIt;
-    SequenceIterator m_currentOffSequenceIt;
-    SequenceIterator m_currentDynamicsIt;
+    size_t m_currentMainSequenceIdx = 0;
+    size_t m_currentOffSequenceIdx = 0;
+    size_t m_currentDynamicsIdx = 0;
+
+    msecs_t m_offStreamPosition = 0;
+
+    EventTimeline m_mainStreamEvents;
+    EventTimeline m_offStreamEvents;
+    EventTimeline m_dynamicEvents;
 
-    EventSequenceMap m_mainStreamEvents;
-    EventSequenceMap m_offStreamEvents;
-    EventSequenceMap m_dynamicEvents;
+    EventSequence m_eventsToBePlayed;
 
     mpe::DynamicLevelLayers m_dynamicLevelLayers;
 
     bool m_isActive = false;
 
     mpe::MainStreamChanges m_mainStreamChanges;
+    mpe::MainStreamRangeChanges m_mainStreamRangeChanges;
     mpe::OffStreamChanges m_offStreamChanges;
 
     OnFlushedCallback m_onOffStreamFlushed;
@@ -43,7 +43,9 @@ public:
         closeDestination();
     }
 
-    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
+    //! NOTE totalSamplesNumber is the expected number of samples per channel of the whole track,
+    //! the samples themselves are passed by chunks, one encode call per chunk
+    virtual bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t /*totalSamplesNumber*/)
     {
         if (!format.isValid()) {
             return false;
@@ -55,8 +57,6 @@ public:
             return false;
         }
 
-        prepareOutputBuffer(totalSamplesNumber);
-
         return true;
     }
 
@@ -65,8 +65,11 @@ public:
         return m_format;
     }
 
-    virtual size_t encode(samples_t samplesPerChannel, const float* input) = 0;
-    virtual size_t flush() = 0;
+    //! NOTE Returns the number of samples per channel which were encoded, 0 on failure
+    virtual samples_t encode(samples_t samplesPerChannel, const float* input) = 0;
+
+    //! NOTE Encodes the buffered samples and finalizes the track
+    virtual bool flush() = 0;
 
     Progress progress()
     {
@@ -74,7 +77,7 @@ public:
     }
 
 protected:
-    virtual size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const = 0;
+    virtual size_t requiredOutputBufferSize(samples_t samplesPerChannel) const = 0;
 
     virtual void prepareWriting()
     {
@@ -105,9 +108,12 @@ protected:
         return true;
     }
 
-    virtual void prepareOutputBuffer(const samples_t totalSamplesNumber)
+    virtual void prepareOutputBuffer(const samples_t samplesPerChannel)
     {
-        m_outputBuffer.resize(requiredOutputBufferSize(totalSamplesNumber));
+        size_t requiredSize = requiredOutputBufferSize(samplesPerChannel);
+        if (m_outputBuffer.size() < requiredSize) {
+            m_outputBuffer.resize(requiredSize);
+        }
     }
 
     virtual void closeDestination()
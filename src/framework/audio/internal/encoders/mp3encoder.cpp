@@ -80,35 +80,46 @@ bool Mp3Encoder::init(const io::path_t& path, const SoundTrackFormat& format, co
     return true;
 }
 
-size_t Mp3Encoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t Mp3Encoder::requiredOutputBufferSize(samples_t samplesPerChannel) const
 {
     //!Note See thirdparty/lame/API
+    //!     mp3buf_size in bytes = 1.25*num_samples + 7200
 
-    return totalSamplesNumber;
+    return samplesPerChannel + samplesPerChannel / 4 + 7200;
 }
 
-size_t Mp3Encoder::encode(samples_t samplesPerChannel, const float* input)
+samples_t Mp3Encoder::encode(samples_t samplesPerChannel, const float* input)
 {
-    m_progress.progressChanged.send(0, 100, "");
+    prepareOutputBuffer(samplesPerChannel);
 
     int encodedBytes = lame_encode_buffer_interleaved_ieee_float(m_handler->flags, input, samplesPerChannel,
                                                                  m_outputBuffer.data(),
                                                                  static_cast<int>(m_outputBuffer.size()));
+    if (encodedBytes < 0) {
+        LOGE() << "failed to encode, error: " << encodedBytes;
+        return 0;
+    }
 
-    m_progress.progressChanged.send(50, 100, "");
-    size_t result = std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
-    m_progress.progressChanged.send(100, 100, "");
+    if (std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream) != static_cast<size_t>(encodedBytes)) {
+        return 0;
+    }
 
-    return result;
+    return samplesPerChannel;
 }
 
-size_t Mp3Encoder::flush()
+bool Mp3Encoder::flush()
 {
+    prepareOutputBuffer(0);
+
     int encodedBytes = lame_encode_flush(m_handler->flags,
                                          m_outputBuffer.data(),
                                          static_cast<int>(m_outputBuffer.size()));
+    if (encodedBytes < 0) {
+        LOGE() << "failed to flush, error: " << encodedBytes;
+        return false;
+    }
 
-    return std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream);
+    return std::fwrite(m_outputBuffer.data(), sizeof(unsigned char), encodedBytes, m_fileStream) == static_cast<size_t>(encodedBytes);
 }
 
 void Mp3Encoder::closeDestination()
@@ -33,11 +33,11 @@ class Mp3Encoder : public AbstractAudioEncoder
 public:
     bool init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber) override;
 
-    size_t encode(samples_t samplesPerChannel, const float* input) override;
-    size_t flush() override;
+    samples_t encode(samples_t samplesPerChannel, const float* input) override;
+    bool flush() override;
 
 private:
-    size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const override;
+    size_t requiredOutputBufferSize(samples_t samplesPerChannel) const override;
     void closeDestination() override;
 
     LameHandler* m_handler = nullptr;
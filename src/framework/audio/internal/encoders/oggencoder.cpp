@@ -33,18 +33,23 @@
 using namespace muse::audio;
 using namespace muse::audio::encode;
 
-size_t OggEncoder::encode(samples_t samplesPerChannel, const float* input)
+samples_t OggEncoder::encode(samples_t samplesPerChannel, const float* input)
 {
-    m_progress.progressChanged.send(0, 100, "");
-    int code = ope_encoder_write_float(m_opusEncoder, input, samplesPerChannel + m_format.sampleRate * 2);
-    m_progress.progressChanged.send(100, 100, "");
+    int code = ope_encoder_write_float(m_opusEncoder, input, samplesPerChannel);
 
     return code == OPE_OK ? samplesPerChannel : 0;
 }
 
-size_t OggEncoder::flush()
+bool OggEncoder::flush()
 {
-    return ope_encoder_flush_header(m_opusEncoder);
+    //! NOTE Encodes the buffered samples and finalizes the stream
+    int code = ope_encoder_drain(m_opusEncoder);
+    if (code != OPE_OK) {
+        LOGE() << "failed to drain the encoder, error: " << code;
+        return false;
+    }
+
+    return true;
 }
 
 size_t OggEncoder::requiredOutputBufferSize(samples_t /*totalSamplesNumber*/) const
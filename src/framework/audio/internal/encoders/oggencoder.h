@@ -31,8 +31,8 @@ namespace muse::audio::encode {
 class OggEncoder : public AbstractAudioEncoder
 {
 public:
-    size_t encode(samples_t samplesPerChannel, const float* input) override;
-    size_t flush() override;
+    samples_t encode(samples_t samplesPerChannel, const float* input) override;
+    bool flush() override;
 
 protected:
     size_t requiredOutputBufferSize(samples_t) const override;
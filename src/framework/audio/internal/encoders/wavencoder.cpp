@@ -81,49 +81,58 @@ private:
     }
 };
 
-size_t WavEncoder::encode(samples_t samplesPerChannel, const float* input)
+samples_t WavEncoder::encode(samples_t samplesPerChannel, const float* input)
 {
     if (!m_fileStream.is_open()) {
         return 0;
     }
 
-    WavHeader header;
-    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
-    header.bitsPerSample = 32;
-    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
-    header.audioChannelsNumber = m_format.audioChannelsNumber;
-    header.sampleRate = m_format.sampleRate;
-    header.samplesPerChannel = samplesPerChannel;
+    //! NOTE The final length is not known until flush,
+    //! so the header is written now and rewritten there
+    if (!m_headerWritten) {
+        writeHeader();
+        m_headerWritten = true;
+    }
 
-    header.write(m_fileStream);
+    size_t samplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
 
-    int total = header.samplesPerChannel;
-    int progressStep = (total * 5) / 100; // every 5%
-    QVector<samples_t> progressValues;
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel;) {
-        progressValues << sampleIdx;
-        sampleIdx += progressStep;
+    // the input is already interleaved 32 bit float, the same as the data chunk
+    m_fileStream.write(reinterpret_cast<const char*>(input), samplesNumber * sizeof(float));
+    if (!m_fileStream) {
+        return 0;
     }
 
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel; ++sampleIdx) {
-        for (audioch_t audioChNum = 0; audioChNum < m_format.audioChannelsNumber; ++audioChNum) {
-            int idx = sampleIdx * m_format.audioChannelsNumber + audioChNum;
-            m_fileStream.write(reinterpret_cast<const char*>(input + idx), 4);
-        }
+    m_samplesPerChannelWritten += samplesPerChannel;
 
-        if (progressValues.contains(sampleIdx)) {
-            m_progress.progressChanged.send(sampleIdx, total, "");
-        }
+    return samplesPerChannel;
+}
+
+bool WavEncoder::flush()
+{
+    if (!m_fileStream.is_open()) {
+        return false;
     }
 
-    return samplesPerChannel * m_format.audioChannelsNumber;
+    std::streampos endPos = m_fileStream.tellp();
+    m_fileStream.seekp(0);
+    writeHeader();
+    m_fileStream.seekp(endPos);
+    m_fileStream.flush();
+
+    return static_cast<bool>(m_fileStream);
 }
 
-size_t WavEncoder::flush()
+void WavEncoder::writeHeader()
 {
-    NOT_SUPPORTED;
+    WavHeader header;
+    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
+    header.bitsPerSample = 32;
+    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
+    header.audioChannelsNumber = m_format.audioChannelsNumber;
+    header.sampleRate = m_format.sampleRate;
+    header.samplesPerChannel = static_cast<uint32_t>(m_samplesPerChannelWritten);
 
-    return 0;
+    header.write(m_fileStream);
 }
 
 size_t WavEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
@@ -31,8 +31,8 @@ namespace muse::audio::encode {
 class WavEncoder : public AbstractAudioEncoder
 {
 public:
-    size_t encode(samples_t samplesPerChannel, const float* input) override;
-    size_t flush() override;
+    samples_t encode(samples_t samplesPerChannel, const float* input) override;
+    bool flush() override;
 
 protected:
     size_t requiredOutputBufferSize(samples_t) const override;
@@ -40,7 +40,11 @@ protected:
     void closeDestination() override;
 
 private:
+    void writeHeader();
+
     std::ofstream m_fileStream;
+    bool m_headerWritten = false;
+    samples_t m_samplesPerChannelWritten = 0;
 };
 }
 
@@ -0,0 +1,265 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_EVENTTIMELINE_H
+#define MUSE_AUDIO_EVENTTIMELINE_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "../audiotypes.h"
+
+namespace muse::audio {
+//! NOTE: Flat, time-sorted storage of sequencer events
+//! Events are collected with add() on the worker thread and laid out by finalize()
+//! into contiguous arrays: the unique timestamps, the offsets of their events
+//! and the events themselves. Seeking is a binary search over the timestamps,
+//! iterating doesn't allocate or touch any tree nodes.
+//! The arrays are the only copy of the events: replace() takes the events out of them
+//! and lays them out again
+template<class EventType, class Compare = std::less<EventType> >
+class EventTimeline
+{
+public:
+    using EventIterator = typename std::vector<EventType>::const_iterator;
+
+    void clear()
+    {
+        m_pending.clear();
+        m_times.clear();
+        m_offsets.clear();
+        m_events.clear();
+        m_origins.clear();
+        m_duplicates.clear();
+        m_maxEventsPerTime = 0;
+    }
+
+    //! NOTE: The origin is the timestamp of the source event which the added one is derived from,
+    //! see replace()
+    void add(const msecs_t time, const EventType& event, const msecs_t origin = 0)
+    {
+        m_pending.push_back({ time, origin, event });
+    }
+
+    void add(const msecs_t time, EventType&& event, const msecs_t origin = 0)
+    {
+        m_pending.push_back({ time, origin, std::move(event) });
+    }
+
+    //! NOTE: Sorts the added events by time, drops equivalent events at the same time
+    //! (the same way std::set did) and lays them out. Replaces the previous content
+    void finalize()
+    {
+        sortPending();
+
+        std::vector<Entry> entries = std::move(m_pending);
+        m_pending = std::vector<Entry>();
+
+        layout(std::move(entries));
+    }
+
+    //! NOTE: Drops the events whose origin matches the predicate and merges the added events in.
+    //! Unlike a clear() and a full refill, only the added events are sorted,
+    //! the rest is a linear pass over the flat arrays
+    template<class OriginPredicate>
+    void replace(OriginPredicate isReplacedOrigin)
+    {
+        sortPending();
+
+        std::vector<Entry> entries = takeEntries();
+
+        auto removedBegin = std::remove_if(entries.begin(), entries.end(), [&isReplacedOrigin](const Entry& entry) {
+            return isReplacedOrigin(entry.origin);
+        });
+
+        entries.erase(removedBegin, entries.end());
+
+        if (!m_pending.empty()) {
+            std::vector<Entry> merged;
+            merged.reserve(entries.size() + m_pending.size());
+
+            std::merge(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()),
+                       std::make_move_iterator(m_pending.begin()), std::make_move_iterator(m_pending.end()),
+                       std::back_inserter(merged), EntryLess());
+
+            entries = std::move(merged);
+            m_pending = std::vector<Entry>();
+        }
+
+        layout(std::move(entries));
+    }
+
+    bool empty() const
+    {
+        return m_times.empty();
+    }
+
+    //! NOTE: The number of unique timestamps
+    size_t size() const
+    {
+        return m_times.size();
+    }
+
+    size_t eventCount() const
+    {
+        return m_events.size();
+    }
+
+    size_t maxEventsPerTime() const
+    {
+        return m_maxEventsPerTime;
+    }
+
+    msecs_t time(const size_t idx) const
+    {
+        return m_times[idx];
+    }
+
+    EventIterator eventsBegin(const size_t idx) const
+    {
+        return m_events.cbegin() + m_offsets[idx];
+    }
+
+    EventIterator eventsEnd(const size_t idx) const
+    {
+        return m_events.cbegin() + m_offsets[idx + 1];
+    }
+
+    //! NOTE: Index of the first timestamp which is not less than the given one
+    size_t lowerBound(const msecs_t time) const
+    {
+        return std::lower_bound(m_times.cbegin(), m_times.cend(), time) - m_times.cbegin();
+    }
+
+    //! NOTE: Index of the first timestamp which is greater than the given one
+    size_t upperBound(const msecs_t time) const
+    {
+        return std::upper_bound(m_times.cbegin(), m_times.cend(), time) - m_times.cbegin();
+    }
+
+private:
+    struct Entry {
+        msecs_t time = 0;
+        msecs_t origin = 0;
+        EventType event;
+    };
+
+    struct EntryLess {
+        bool operator()(const Entry& e1, const Entry& e2) const
+        {
+            if (e1.time != e2.time) {
+                return e1.time < e2.time;
+            }
+
+            return Compare()(e1.event, e2.event);
+        }
+    };
+
+    void sortPending()
+    {
+        std::stable_sort(m_pending.begin(), m_pending.end(), EntryLess());
+    }
+
+    //! NOTE: Moves the events out of the arrays, in the order they were laid out from,
+    //! the dropped equivalent events follow the kept ones
+    std::vector<Entry> takeEntries()
+    {
+        std::vector<Entry> entries;
+        entries.reserve(m_events.size());
+
+        for (size_t idx = 0; idx < m_times.size(); ++idx) {
+            for (size_t eventIdx = m_offsets[idx]; eventIdx < m_offsets[idx + 1]; ++eventIdx) {
+                entries.push_back({ m_times[idx], m_origins[eventIdx], std::move(m_events[eventIdx]) });
+            }
+        }
+
+        if (!m_duplicates.empty()) {
+            std::vector<Entry> merged;
+            merged.reserve(entries.size() + m_duplicates.size());
+
+            std::merge(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()),
+                       std::make_move_iterator(m_duplicates.begin()), std::make_move_iterator(m_duplicates.end()),
+                       std::back_inserter(merged), EntryLess());
+
+            entries = std::move(merged);
+        }
+
+        return entries;
+    }
+
+    void layout(std::vector<Entry>&& entries)
+    {
+        Compare less;
+
+        m_times.clear();
+        m_offsets.clear();
+        m_events.clear();
+        m_origins.clear();
+        m_duplicates.clear();
+        m_maxEventsPerTime = 0;
+
+        m_times.reserve(entries.size());
+        m_offsets.reserve(entries.size() + 1);
+        m_events.reserve(entries.size());
+        m_origins.reserve(entries.size());
+
+        for (Entry& entry : entries) {
+            if (m_times.empty() || m_times.back() != entry.time) {
+                m_times.push_back(entry.time);
+                m_offsets.push_back(m_events.size());
+            } else if (!less(m_events.back(), entry.event) && !less(entry.event, m_events.back())) {
+                //! NOTE: Dropped like std::set did, but kept aside: it reappears if the kept one is replaced
+                m_duplicates.push_back(std::move(entry));
+                continue;
+            }
+
+            m_events.push_back(std::move(entry.event));
+            m_origins.push_back(entry.origin);
+        }
+
+        m_offsets.push_back(m_events.size());
+
+        for (size_t idx = 0; idx < m_times.size(); ++idx) {
+            m_maxEventsPerTime = std::max(m_maxEventsPerTime, m_offsets[idx + 1] - m_offsets[idx]);
+        }
+    }
+
+    std::vector<Entry> m_pending;
+
+    std::vector<msecs_t> m_times;
+    std::vector<size_t> m_offsets;
+    std::vector<EventType> m_events;
+
+    //! NOTE: The origin of each event, see replace()
+    std::vector<msecs_t> m_origins;
+
+    //! NOTE: The equivalent events dropped at the same timestamps, usually none
+    std::vector<Entry> m_duplicates;
+
+    size_t m_maxEventsPerTime = 0;
+};
+}
+
+#endif // MUSE_AUDIO_EVENTTIMELINE_H
@@ -23,6 +23,7 @@
 #include "soundtrackwriter.h"
 
 #include "global/defer.h"
+#include "global/runtime.h"
 
 #include "internal/worker/audioengine.h"
 #include "internal/encoders/mp3encoder.h"
@@ -38,8 +39,11 @@ using namespace muse;
 using namespace muse::audio;
 using namespace muse::audio::soundtrack;
 
-static constexpr int PREPARE_STEP = 0;
-static constexpr int ENCODE_STEP = 1;
+//! NOTE The render step is small (see IAudioConfiguration::renderStep),
+//! offline there is no latency constraint, so a block of several steps is rendered at once:
+//! the mixer renders the tracks of the block in parallel and then mixes it step by step
+static constexpr size_t RENDER_STEPS_PER_BLOCK = 32;
+static constexpr size_t BLOCKS_COUNT = 4;
 
 SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format,
                                    const msecs_t totalDuration, IAudioSourcePtr source,
@@ -50,9 +54,14 @@ SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTra
         return;
     }
 
-    samples_t totalSamplesNumber = (totalDuration / 1000000.f) * sizeof(float) * format.sampleRate;
-    m_inputBuffer.resize(totalSamplesNumber);
-    m_intermBuffer.resize(config()->renderStep() * config()->audioChannelsCount());
+    m_totalSamplesPerChannel = (totalDuration / 1000000.f) * format.sampleRate;
+    m_renderStep = config()->renderStep();
+    m_audioChannelsCount = config()->audioChannelsCount();
+
+    m_blocks.resize(BLOCKS_COUNT);
+    for (Block& block : m_blocks) {
+        block.data.resize(m_renderStep * m_audioChannelsCount * RENDER_STEPS_PER_BLOCK);
+    }
 
     m_encoderPtr = createEncoder(format.type);
 
@@ -60,10 +69,18 @@ SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTra
         return;
     }
 
-    m_encoderPtr->init(destination, format, totalSamplesNumber);
-    m_encoderPtr->progress().progressChanged.onReceive(this, [this](int64_t current, int64_t total, std::string) {
-        sendStepProgress(ENCODE_STEP, current, total);
-    });
+    if (!m_encoderPtr->init(destination, format, m_totalSamplesPerChannel)) {
+        LOGE() << "failed to init encoder, destination: " << destination;
+        m_encoderPtr = nullptr;
+    }
+}
+
+SoundTrackWriter::~SoundTrackWriter()
+{
+    if (m_encoderThread.joinable()) {
+        abort();
+        m_encoderThread.join();
+    }
 }
 
 Ret SoundTrackWriter::write()
@@ -80,8 +97,6 @@ Ret SoundTrackWriter::write()
     m_source->setIsActive(true);
 
     DEFER {
-        m_encoderPtr->flush();
-
         AudioEngine::instance()->setMode(RenderMode::IdleMode);
 
         m_source->setSampleRate(AudioEngine::instance()->sampleRate());
@@ -91,17 +106,20 @@ Ret SoundTrackWriter::write()
     };
 
     Ret ret = generateAudioData();
+
+    //! NOTE The encoder thread is finished here, so the encoder is only used by this thread
+    bool flushed = m_encoderPtr->flush();
+
     if (!ret) {
         return ret;
     }
 
-    size_t bytes = m_encoderPtr->encode(m_inputBuffer.size() / sizeof(float), m_inputBuffer.data());
-
     if (m_isAborted) {
         return make_ret(Ret::Code::Cancel);
     }
 
-    if (bytes == 0) {
+    //! NOTE The encoders report the encoded samples per channel, a failed chunk counts as none
+    if (!flushed || m_encodedSamplesPerChannel != m_totalSamplesPerChannel) {
         return make_ret(Err::ErrorEncode);
     }
 
@@ -110,7 +128,12 @@ Ret SoundTrackWriter::write()
 
 void SoundTrackWriter::abort()
 {
-    m_isAborted = true;
+    {
+        std::lock_guard lock(m_blocksMutex);
+        m_isAborted = true;
+    }
+
+    m_blocksChanged.notify_all();
 }
 
 Progress SoundTrackWriter::progress()
@@ -136,42 +159,129 @@ Ret SoundTrackWriter::generateAudioData()
 {
     TRACEFUNC;
 
-    size_t inputBufferOffset = 0;
-    size_t inputBufferMaxOffset = m_inputBuffer.size();
-
-    sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+    if (m_totalSamplesPerChannel == 0) {
+        LOGI() << "No audio to export";
+        return make_ret(Err::NoAudioToExport);
+    }
 
-    samples_t renderStep = config()->renderStep();
+    startEncoding();
 
-    while (inputBufferOffset < inputBufferMaxOffset && !m_isAborted) {
-        m_source->process(m_intermBuffer.data(), renderStep);
+    samples_t renderedSamples = 0;
+    sendProgress(0, m_totalSamplesPerChannel);
 
-        size_t samplesToCopy = std::min(m_intermBuffer.size(), inputBufferMaxOffset - inputBufferOffset);
+    while (renderedSamples < m_totalSamplesPerChannel && !m_isAborted) {
+        Block* block = takeFreeBlock();
+        if (!block) {
+            break;
+        }
 
-        std::copy(m_intermBuffer.begin(),
-                  m_intermBuffer.begin() + samplesToCopy,
-                  m_inputBuffer.begin() + inputBufferOffset);
+        block->samplesPerChannel = std::min<samples_t>(m_renderStep * RENDER_STEPS_PER_BLOCK,
+                                                       m_totalSamplesPerChannel - renderedSamples);
+        m_source->process(block->data.data(), block->samplesPerChannel);
+        renderedSamples += block->samplesPerChannel;
 
-        inputBufferOffset += samplesToCopy;
-        sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+        putFilledBlock(block);
+        sendProgress(m_encodedSamplesPerChannel, m_totalSamplesPerChannel);
     }
 
+    finishEncoding();
+    sendProgress(m_encodedSamplesPerChannel, m_totalSamplesPerChannel);
+
     if (m_isAborted) {
         return make_ret(Ret::Code::Cancel);
     }
 
-    if (inputBufferOffset == 0) {
-        LOGI() << "No audio to export";
-        return make_ret(Err::NoAudioToExport);
+    return muse::make_ok();
+}
+
+void SoundTrackWriter::startEncoding()
+{
+    m_freeBlocks.clear();
+    m_filledBlocks.clear();
+    for (Block& block : m_blocks) {
+        m_freeBlocks.push_back(&block);
     }
 
-    return muse::make_ok();
+    m_isRenderFinished = false;
+    m_encodedSamplesPerChannel = 0;
+
+    m_encoderThread = std::thread(&SoundTrackWriter::encodeBlocks, this);
+}
+
+void SoundTrackWriter::finishEncoding()
+{
+    {
+        std::lock_guard lock(m_blocksMutex);
+        m_isRenderFinished = true;
+    }
+
+    m_blocksChanged.notify_all();
+
+    if (m_encoderThread.joinable()) {
+        m_encoderThread.join();
+    }
+}
+
+void SoundTrackWriter::encodeBlocks()
+{
+    runtime::setThreadName("audio_encoder");
+
+    while (true) {
+        Block* block = nullptr;
+
+        {
+            std::unique_lock lock(m_blocksMutex);
+            m_blocksChanged.wait(lock, [this]() {
+                return !m_filledBlocks.empty() || m_isRenderFinished || m_isAborted;
+            });
+
+            if (m_isAborted || m_filledBlocks.empty()) {
+                return;
+            }
+
+            block = m_filledBlocks.front();
+            m_filledBlocks.pop_front();
+        }
+
+        m_encodedSamplesPerChannel += m_encoderPtr->encode(block->samplesPerChannel, block->data.data());
+
+        {
+            std::lock_guard lock(m_blocksMutex);
+            m_freeBlocks.push_back(block);
+        }
+
+        m_blocksChanged.notify_all();
+    }
+}
+
+SoundTrackWriter::Block* SoundTrackWriter::takeFreeBlock()
+{
+    std::unique_lock lock(m_blocksMutex);
+    m_blocksChanged.wait(lock, [this]() {
+        return !m_freeBlocks.empty() || m_isAborted;
+    });
+
+    if (m_isAborted) {
+        return nullptr;
+    }
+
+    Block* block = m_freeBlocks.back();
+    m_freeBlocks.pop_back();
+
+    return block;
+}
+
+void SoundTrackWriter::putFilledBlock(Block* block)
+{
+    {
+        std::lock_guard lock(m_blocksMutex);
+        m_filledBlocks.push_back(block);
+    }
+
+    m_blocksChanged.notify_all();
 }
 
-void SoundTrackWriter::sendStepProgress(int step, int64_t current, int64_t total)
+void SoundTrackWriter::sendProgress(int64_t current, int64_t total)
 {
-    int stepRange = step == PREPARE_STEP ? 80 : 20;
-    int stepProgressStart = step == PREPARE_STEP ? 0 : 80;
-    int stepCurrentProgress = stepProgressStart + ((current * 100 / total) * stepRange) / 100;
-    m_progress.progressChanged.send(stepCurrentProgress, 100, "");
+    m_progress.progressChanged.send(current * 100 / total, 100, "");
 }
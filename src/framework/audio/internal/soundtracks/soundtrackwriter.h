@@ -23,6 +23,11 @@
 #ifndef MUSE_AUDIO_SOUNDTRACKWRITER_H
 #define MUSE_AUDIO_SOUNDTRACKWRITER_H
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "global/async/asyncable.h"
@@ -40,6 +45,7 @@ class SoundTrackWriter : public muse::Injectable, public async::Asyncable
 public:
     SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration, IAudioSourcePtr source,
                      const muse::modularity::ContextPtr& iocCtx);
+    ~SoundTrackWriter() override;
 
     Ret write();
     void abort();
@@ -47,15 +53,39 @@ public:
     Progress progress();
 
 private:
+    //! NOTE Rendered audio is passed to the encoder thread in blocks,
+    //! the number of blocks is fixed, so the memory doesn't depend on the track duration
+    struct Block {
+        std::vector<float> data;
+        samples_t samplesPerChannel = 0;
+    };
+
     encode::AbstractAudioEncoderPtr createEncoder(const SoundTrackType& type) const;
     Ret generateAudioData();
 
-    void sendStepProgress(int step, int64_t current, int64_t total);
+    void startEncoding();
+    void finishEncoding();
+    void encodeBlocks();
+
+    Block* takeFreeBlock();
+    void putFilledBlock(Block* block);
+
+    void sendProgress(int64_t current, int64_t total);
 
     IAudioSourcePtr m_source = nullptr;
+    samples_t m_totalSamplesPerChannel = 0;
+    samples_t m_renderStep = 0;
+    audioch_t m_audioChannelsCount = 0;
+
+    std::vector<Block> m_blocks;
+    std::vector<Block*> m_freeBlocks;
+    std::deque<Block*> m_filledBlocks;
+    std::mutex m_blocksMutex;
+    std::condition_variable m_blocksChanged;
+    bool m_isRenderFinished = false;
 
-    std::vector<float> m_inputBuffer;
-    std::vector<float> m_intermBuffer;
+    std::thread m_encoderThread;
+    std::atomic<samples_t> m_encodedSamplesPerChannel = 0;
 
     encode::AbstractAudioEncoderPtr m_encoderPtr = nullptr;
 
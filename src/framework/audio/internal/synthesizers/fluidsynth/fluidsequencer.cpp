@@ -59,6 +59,7 @@ void FluidSequencer::updateOffStreamEvents(const mpe::PlaybackEventsMap& events,
     }
 
     updatePlaybackEvents(m_offStreamEvents, events);
+    m_offStreamEvents.finalize();
     updateOffSequenceIterator();
 }
 
@@ -75,9 +76,33 @@ void FluidSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& events
     }
 
     updatePlaybackEvents(m_mainStreamEvents, events);
+    m_mainStreamEvents.finalize();
     updateMainSequenceIterator();
 
     updateDynamicEvents(m_dynamicEvents, dynamics);
+    m_dynamicEvents.finalize();
+    updateDynamicChangesIterator();
+}
+
+void FluidSequencer::updateMainStreamEvents(const mpe::TimestampRangeList& ranges, const mpe::PlaybackEventsMap& events,
+                                            const mpe::DynamicLevelLayers& dynamics, const mpe::PlaybackParamLayers&)
+{
+    m_dynamicLevelLayers = dynamics;
+
+    m_dynamicEvents.clear();
+
+    if (m_onMainStreamFlushed) {
+        m_onMainStreamFlushed();
+    }
+
+    updatePlaybackEvents(m_mainStreamEvents, events);
+    m_mainStreamEvents.replace([&ranges](const mpe::timestamp_t origin) {
+        return mpe::containsTimestamp(ranges, origin);
+    });
+    updateMainSequenceIterator();
+
+    updateDynamicEvents(m_dynamicEvents, dynamics);
+    m_dynamicEvents.finalize();
     updateDynamicChangesIterator();
 }
 
@@ -91,7 +116,7 @@ const ChannelMap& FluidSequencer::channels() const
     return m_channels;
 }
 
-void FluidSequencer::updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& changes)
+void FluidSequencer::updatePlaybackEvents(EventTimeline& destination, const mpe::PlaybackEventsMap& changes)
 {
     for (const auto& pair : changes) {
         for (const mpe::PlaybackEvent& event : pair.second) {
@@ -115,22 +140,22 @@ void FluidSequencer::updatePlaybackEvents(EventSequenceMap& destination, const m
             noteOn.setVelocity(velocity);
             noteOn.setPitchNote(noteIdx, tuning);
 
-            destination[timestampFrom].emplace(std::move(noteOn));
+            destination.add(timestampFrom, std::move(noteOn), pair.first);
 
             midi::Event noteOff(Event::Opcode::NoteOff, Event::MessageType::ChannelVoice20);
             noteOff.setChannel(channelIdx);
             noteOff.setNote(noteIdx);
             noteOff.setPitchNote(noteIdx, tuning);
 
-            destination[timestampTo].emplace(std::move(noteOff));
+            destination.add(timestampTo, std::move(noteOff), pair.first);
 
-            appendControlSwitch(destination, noteEvent, PEDAL_CC_SUPPORTED_TYPES, midi::SUSTAIN_PEDAL_CONTROLLER);
-            appendPitchBend(destination, noteEvent, BEND_SUPPORTED_TYPES, channelIdx);
+            appendControlSwitch(destination, noteEvent, pair.first, PEDAL_CC_SUPPORTED_TYPES, midi::SUSTAIN_PEDAL_CONTROLLER);
+            appendPitchBend(destination, noteEvent, pair.first, BEND_SUPPORTED_TYPES, channelIdx);
         }
     }
 }
 
-void FluidSequencer::updateDynamicEvents(EventSequenceMap& destination, const mpe::DynamicLevelLayers& changes)
+void FluidSequencer::updateDynamicEvents(EventTimeline& destination, const mpe::DynamicLevelLayers& changes)
 {
     for (const auto& layer : changes) {
         for (const auto& dynamic : layer.second) {
@@ -138,12 +163,12 @@ void FluidSequencer::updateDynamicEvents(EventSequenceMap& destination, const mp
             event.setIndex(midi::EXPRESSION_CONTROLLER);
             event.setData(expressionLevel(dynamic.second));
 
-            destination[dynamic.first].emplace(std::move(event));
+            destination.add(dynamic.first, std::move(event));
         }
     }
 }
 
-void FluidSequencer::appendControlSwitch(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent,
+void FluidSequencer::appendControlSwitch(EventTimeline& destination, const mpe::NoteEvent& noteEvent, const mpe::timestamp_t origin,
                                          const mpe::ArticulationTypeSet& appliableTypes, const int midiControlIdx)
 {
     mpe::ArticulationType currentType = mpe::ArticulationType::Undefined;
@@ -166,16 +191,16 @@ void FluidSequencer::appendControlSwitch(EventSequenceMap& destination, const mp
     start.setIndex(midiControlIdx);
     start.setData(127);
 
-    destination[noteEvent.arrangementCtx().actualTimestamp].emplace(std::move(start));
+    destination.add(noteEvent.arrangementCtx().actualTimestamp, std::move(start), origin);
 
     midi::Event end(Event::Opcode::ControlChange, Event::MessageType::ChannelVoice10);
     end.setIndex(midiControlIdx);
     end.setData(0);
 
-    destination[articulationMeta.timestamp + articulationMeta.overallDuration].emplace(std::move(end));
+    destination.add(articulationMeta.timestamp + articulationMeta.overallDuration, std::move(end), origin);
 }
 
-void FluidSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent,
+void FluidSequencer::appendPitchBend(EventTimeline& destination, const mpe::NoteEvent& noteEvent, const mpe::timestamp_t origin,
                                      const mpe::ArticulationTypeSet& appliableTypes, const channel_t channelIdx)
 {
     if (noteEvent.pitchCtx().pitchCurve.empty()) {
@@ -202,7 +227,7 @@ void FluidSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::N
     midi::Event event(Event::Opcode::PitchBend, Event::MessageType::ChannelVoice10);
     event.setChannel(channelIdx);
     event.setData(8192);
-    destination[timestampTo].insert(event);
+    destination.add(timestampTo, event, origin);
 
     auto currIt = noteEvent.pitchCtx().pitchCurve.cbegin();
     auto nextIt = std::next(currIt);
@@ -239,7 +264,7 @@ void FluidSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::N
 
             if (time < timestampTo) {
                 event.setData(bendValue);
-                destination[time].insert(event);
+                destination.add(time, event, origin);
             }
         }
     }
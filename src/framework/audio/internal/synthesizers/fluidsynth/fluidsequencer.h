@@ -42,20 +42,22 @@ public:
     void updateOffStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::PlaybackParamList& params) override;
     void updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
                                 const mpe::PlaybackParamLayers& params) override;
+    void updateMainStreamEvents(const mpe::TimestampRangeList& ranges, const mpe::PlaybackEventsMap& events,
+                                const mpe::DynamicLevelLayers& dynamics, const mpe::PlaybackParamLayers& params) override;
 
     async::Channel<midi::channel_t, midi::Program> channelAdded() const;
 
     const ChannelMap& channels() const;
 
 private:
-    void updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& changes);
-    void updateDynamicEvents(EventSequenceMap& destination, const mpe::DynamicLevelLayers& changes);
+    void updatePlaybackEvents(EventTimeline& destination, const mpe::PlaybackEventsMap& changes);
+    void updateDynamicEvents(EventTimeline& destination, const mpe::DynamicLevelLayers& changes);
 
-    void appendControlSwitch(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationTypeSet& appliableTypes,
-                             const int midiControlIdx);
+    void appendControlSwitch(EventTimeline& destination, const mpe::NoteEvent& noteEvent, const mpe::timestamp_t origin,
+                             const mpe::ArticulationTypeSet& appliableTypes, const int midiControlIdx);
 
-    void appendPitchBend(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationTypeSet& appliableTypes,
-                         const midi::channel_t channelIdx);
+    void appendPitchBend(EventTimeline& destination, const mpe::NoteEvent& noteEvent, const mpe::timestamp_t origin,
+                         const mpe::ArticulationTypeSet& appliableTypes, const midi::channel_t channelIdx);
 
     midi::channel_t channel(const mpe::NoteEvent& noteEvent) const;
     midi::note_idx_t noteIndex(const mpe::pitch_level_t pitchLevel) const;
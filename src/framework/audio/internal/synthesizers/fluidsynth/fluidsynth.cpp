@@ -342,7 +342,7 @@ samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
     }
 
     msecs_t nextMsecs = samplesToMsecs(samplesPerChannel, m_sampleRate);
-    FluidSequencer::EventSequence sequence = m_sequencer.eventsToBePlayed(nextMsecs);
+    const FluidSequencer::EventSequence& sequence = m_sequencer.eventsToBePlayed(nextMsecs);
 
     if (!sequence.empty()) {
         m_tuning.reset();
@@ -140,6 +140,7 @@ void AudioEngine::setMode(const RenderMode newMode)
     }
 
     m_currentMode = newMode;
+    m_mixer->setIsOffline(m_currentMode == RenderMode::OfflineMode);
 
     switch (m_currentMode) {
     case RenderMode::RealTimeMode:
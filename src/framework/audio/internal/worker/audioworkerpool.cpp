@@ -0,0 +1,249 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audioworkerpool.h"
+
+#include "internal/audiosanitizer.h"
+
+using namespace muse::audio;
+
+//! NOTE How many times an idle worker checks for new work before parking
+static constexpr int SPIN_COUNT = 4096;
+static constexpr int SPIN_COUNT_BEFORE_YIELD = 64;
+
+static constexpr uint64_t RANGE_MASK = 0xFFFFFFFF;
+
+AudioWorkerPool::AudioWorkerPool(size_t threadCount)
+{
+    if (threadCount == 0) {
+        size_t hardwareConcurrency = std::thread::hardware_concurrency();
+        threadCount = hardwareConcurrency > 2 ? hardwareConcurrency / 2 - 1 : 1;
+    }
+
+    m_slotCount = threadCount + 1;
+    m_slots = std::make_unique<WorkerSlot[]>(m_slotCount);
+
+    m_isActive = true;
+
+    m_threads.reserve(threadCount);
+    for (size_t i = 1; i < m_slotCount; ++i) {
+        m_threads.emplace_back(&AudioWorkerPool::workerLoop, this, i);
+    }
+}
+
+AudioWorkerPool::~AudioWorkerPool()
+{
+    m_isActive = false;
+    m_generation.fetch_add(1);
+
+    {
+        std::lock_guard lock(m_parkMutex);
+        m_parkCv.notify_all();
+    }
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+size_t AudioWorkerPool::concurrency() const
+{
+    return m_slotCount;
+}
+
+void AudioWorkerPool::run(size_t taskCount, TaskFunc func, void* ctx, std::chrono::microseconds deadline)
+{
+    if (taskCount == 0) {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    if (taskCount == 1 || m_slotCount == 1) {
+        for (size_t i = 0; i < taskCount; ++i) {
+            func(ctx, i);
+        }
+    } else {
+        m_func = func;
+        m_ctx = ctx;
+        m_remainingTaskCount.store(taskCount);
+
+        for (size_t i = 0; i < m_slotCount; ++i) {
+            uint64_t begin = taskCount * i / m_slotCount;
+            uint64_t end = taskCount * (i + 1) / m_slotCount;
+            m_slots[i].range.store(packRange(begin, end));
+        }
+
+        m_generation.fetch_add(1);
+
+        if (m_parkedCount.load() > 0) {
+            std::lock_guard lock(m_parkMutex);
+            m_parkCv.notify_all();
+        }
+
+        processTasks(0);
+
+        //! NOTE The remaining tasks are already being executed by the workers, so it won't take long
+        int spins = 0;
+        while (m_remainingTaskCount.load() != 0) {
+            if (++spins > SPIN_COUNT_BEFORE_YIELD) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    updateStats(static_cast<uint64_t>(duration.count()), deadline);
+}
+
+AudioWorkerPool::Stats AudioWorkerPool::stats() const
+{
+    Stats result;
+    result.runCount = m_runCount.load(std::memory_order_relaxed);
+    result.deadlineMissCount = m_deadlineMissCount.load(std::memory_order_relaxed);
+    result.lastRunDurationUs = m_lastRunDurationUs.load(std::memory_order_relaxed);
+    result.maxRunDurationUs = m_maxRunDurationUs.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+void AudioWorkerPool::resetStats()
+{
+    m_runCount = 0;
+    m_deadlineMissCount = 0;
+    m_lastRunDurationUs = 0;
+    m_maxRunDurationUs = 0;
+}
+
+uint64_t AudioWorkerPool::packRange(uint64_t begin, uint64_t end)
+{
+    return (begin << 32) | (end & RANGE_MASK);
+}
+
+void AudioWorkerPool::workerLoop(size_t slotIdx)
+{
+    AudioSanitizer::setupWorkerPoolThread();
+
+    uint64_t seenGeneration = 0;
+
+    while (waitForWork(seenGeneration)) {
+        processTasks(slotIdx);
+    }
+}
+
+bool AudioWorkerPool::waitForWork(uint64_t& seenGeneration)
+{
+    for (int i = 0; i < SPIN_COUNT; ++i) {
+        uint64_t generation = m_generation.load();
+        if (generation != seenGeneration) {
+            seenGeneration = generation;
+            return m_isActive;
+        }
+
+        if (i > SPIN_COUNT_BEFORE_YIELD) {
+            std::this_thread::yield();
+        }
+    }
+
+    //! NOTE Nothing to do for a while (e.g. playback stopped), so park until the next run
+    m_parkedCount.fetch_add(1);
+
+    {
+        std::unique_lock lock(m_parkMutex);
+        m_parkCv.wait(lock, [this, seenGeneration]() {
+            return m_generation.load() != seenGeneration;
+        });
+    }
+
+    m_parkedCount.fetch_sub(1);
+
+    seenGeneration = m_generation.load();
+    return m_isActive;
+}
+
+void AudioWorkerPool::processTasks(size_t slotIdx)
+{
+    size_t taskIdx = 0;
+
+    while (takeOwnTask(slotIdx, taskIdx) || stealTask(slotIdx, taskIdx)) {
+        m_func(m_ctx, taskIdx);
+        m_remainingTaskCount.fetch_sub(1);
+    }
+}
+
+bool AudioWorkerPool::takeOwnTask(size_t slotIdx, size_t& taskIdx)
+{
+    std::atomic<uint64_t>& range = m_slots[slotIdx].range;
+    uint64_t current = range.load();
+
+    while (true) {
+        uint64_t begin = current >> 32;
+        uint64_t end = current & RANGE_MASK;
+
+        if (begin >= end) {
+            return false;
+        }
+
+        if (range.compare_exchange_weak(current, packRange(begin + 1, end))) {
+            taskIdx = static_cast<size_t>(begin);
+            return true;
+        }
+    }
+}
+
+bool AudioWorkerPool::stealTask(size_t thiefIdx, size_t& taskIdx)
+{
+    for (size_t i = 1; i < m_slotCount; ++i) {
+        std::atomic<uint64_t>& range = m_slots[(thiefIdx + i) % m_slotCount].range;
+        uint64_t current = range.load();
+
+        while (true) {
+            uint64_t begin = current >> 32;
+            uint64_t end = current & RANGE_MASK;
+
+            if (begin >= end) {
+                break;
+            }
+
+            //! NOTE Thieves take from the back, the owner from the front
+            if (range.compare_exchange_weak(current, packRange(begin, end - 1))) {
+                taskIdx = static_cast<size_t>(end - 1);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void AudioWorkerPool::updateStats(uint64_t durationUs, std::chrono::microseconds deadline)
+{
+    m_runCount.fetch_add(1, std::memory_order_relaxed);
+    m_lastRunDurationUs.store(durationUs, std::memory_order_relaxed);
+
+    if (durationUs > m_maxRunDurationUs.load(std::memory_order_relaxed)) {
+        m_maxRunDurationUs.store(durationUs, std::memory_order_relaxed);
+    }
+
+    if (deadline.count() > 0 && durationUs > static_cast<uint64_t>(deadline.count())) {
+        m_deadlineMissCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_AUDIO_AUDIOWORKERPOOL_H
+#define MUSE_AUDIO_AUDIOWORKERPOOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace muse::audio {
+//! NOTE Fixed-size pool for fanning out work inside an audio callback.
+//! Nothing is allocated or locked per run: tasks are indices into the caller's own data,
+//! each worker owns a preallocated range of them and steals from the others when its range is empty.
+//! Idle workers spin for a while before parking, so back-to-back callbacks don't pay a wake-up.
+class AudioWorkerPool
+{
+public:
+    using TaskFunc = void (*)(void* ctx, size_t taskIdx);
+
+    struct Stats {
+        uint64_t runCount = 0;
+        uint64_t deadlineMissCount = 0;
+        uint64_t lastRunDurationUs = 0;
+        uint64_t maxRunDurationUs = 0;
+    };
+
+    //! threadCount - number of worker threads, excluding the calling thread (0 - pick automatically)
+    explicit AudioWorkerPool(size_t threadCount = 0);
+    ~AudioWorkerPool();
+
+    //! total number of threads executing the tasks, including the calling thread
+    size_t concurrency() const;
+
+    //! Executes func(ctx, i) for every i in [0, taskCount) and returns when all of them are done.
+    //! The calling thread takes part in the work. Runs longer than deadline are counted as misses.
+    void run(size_t taskCount, TaskFunc func, void* ctx, std::chrono::microseconds deadline = std::chrono::microseconds::zero());
+
+    Stats stats() const;
+    void resetStats();
+
+private:
+    struct alignas(64) WorkerSlot {
+        //! NOTE [begin, end) packed into one word, so owner and thieves agree on it with a single CAS
+        std::atomic<uint64_t> range = 0;
+    };
+
+    static uint64_t packRange(uint64_t begin, uint64_t end);
+
+    void workerLoop(size_t slotIdx);
+    bool waitForWork(uint64_t& seenGeneration);
+
+    void processTasks(size_t slotIdx);
+    bool takeOwnTask(size_t slotIdx, size_t& taskIdx);
+    bool stealTask(size_t thiefIdx, size_t& taskIdx);
+
+    void updateStats(uint64_t durationUs, std::chrono::microseconds deadline);
+
+    std::vector<std::thread> m_threads;
+    std::unique_ptr<WorkerSlot[]> m_slots;
+    size_t m_slotCount = 0;
+
+    TaskFunc m_func = nullptr;
+    void* m_ctx = nullptr;
+
+    std::atomic<bool> m_isActive = false;
+    std::atomic<uint64_t> m_generation = 0;
+    std::atomic<size_t> m_remainingTaskCount = 0;
+
+    std::atomic<size_t> m_parkedCount = 0;
+    std::mutex m_parkMutex;
+    std::condition_variable m_parkCv;
+
+    std::atomic<uint64_t> m_runCount = 0;
+    std::atomic<uint64_t> m_deadlineMissCount = 0;
+    std::atomic<uint64_t> m_lastRunDurationUs = 0;
+    std::atomic<uint64_t> m_maxRunDurationUs = 0;
+};
+
+using AudioWorkerPoolPtr = std::unique_ptr<AudioWorkerPool>;
+}
+
+#endif // MUSE_AUDIO_AUDIOWORKERPOOL_H
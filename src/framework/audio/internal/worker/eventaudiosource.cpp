@@ -47,12 +47,20 @@ EventAudioSource::EventAudioSource(const TrackId trackId, const mpe::PlaybackDat
         m_playbackData.dynamics = dynamics;
         m_playbackData.params = params;
     });
+
+    m_playbackData.mainStreamRanges.onReceive(this, [this](const TimestampRangeList& ranges, const PlaybackEventsMap& events,
+                                                           const DynamicLevelLayers& dynamics, const PlaybackParamLayers& params) {
+        applyRangeChanges(m_playbackData.originEvents, ranges, events);
+        m_playbackData.dynamics = dynamics;
+        m_playbackData.params = params;
+    });
 }
 
 EventAudioSource::~EventAudioSource()
 {
     m_playbackData.offStream.resetOnReceive(this);
     m_playbackData.mainStream.resetOnReceive(this);
+    m_playbackData.mainStreamRanges.resetOnReceive(this);
 }
 
 bool EventAudioSource::isActive() const
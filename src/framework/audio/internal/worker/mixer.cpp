@@ -21,8 +21,6 @@
  */
 #include "mixer.h"
 
-#include "concurrency/taskscheduler.h"
-
 #include "internal/audiosanitizer.h"
 #include "internal/dsp/audiomathutils.h"
 #include "audioerrors.h"
@@ -35,11 +33,17 @@ using namespace muse::async;
 
 static constexpr size_t DEFAULT_AUX_BUFFER_SIZE = 1024;
 
+//! NOTE Each track buffer starts on its own cache line, so channels processed in parallel don't share lines
+static constexpr size_t CACHE_LINE_SIZE = 64;
+static constexpr size_t CACHE_LINE_FLOATS = CACHE_LINE_SIZE / sizeof(float);
+
 Mixer::Mixer()
 {
     ONLY_AUDIO_WORKER_THREAD;
 
     m_minTrackCountForMultithreading = configuration()->minTrackCountForMultithreading();
+    m_renderStep = configuration()->renderStep();
+    m_workerPool = std::make_unique<AudioWorkerPool>();
 }
 
 Mixer::~Mixer()
@@ -92,6 +96,7 @@ RetVal<MixerChannelPtr> Mixer::addChannel(const TrackId trackId, ITrackAudioInpu
     });
 
     m_trackChannels.emplace(trackId, channel);
+    updateTrackChannelInfoList();
 
     result.val = m_trackChannels[trackId];
     result.ret = make_ret(Ret::Code::Ok);
@@ -130,6 +135,7 @@ Ret Mixer::removeChannel(const TrackId trackId)
         }
 
         m_trackChannels.erase(trackId);
+        updateTrackChannelInfoList();
         return make_ret(Ret::Code::Ok);
     }
 
@@ -187,18 +193,43 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
         return 0;
     }
 
-    TracksData tracksData;
-    processTrackChannels(outBufferSize, samplesPerChannel, tracksData);
+    //! NOTE Synthesizers handle events at the start of a process call,
+    //! so a bigger offline block is still rendered by render steps
+    samples_t stepSize = samplesPerChannel;
+    if (m_isOffline && m_renderStep > 0) {
+        stepSize = std::min(m_renderStep, samplesPerChannel);
+    }
+
+    prepareTrackBuffers(outBufferSize);
+    processTrackChannels(samplesPerChannel, stepSize);
+
+    samples_t processedSamples = 0;
 
-    prepareAuxBuffers(outBufferSize);
+    for (samples_t offset = 0; offset < samplesPerChannel; offset += stepSize) {
+        samples_t samplesToMix = std::min(stepSize, samplesPerChannel - offset);
+        size_t bufferOffset = offset * m_audioChannelsCount;
+
+        processedSamples += mixTrackChannels(outBuffer + bufferOffset, bufferOffset, samplesToMix);
+    }
+
+    return processedSamples;
+}
+
+samples_t Mixer::mixTrackChannels(float* outBuffer, size_t trackBufferOffset, samples_t samplesPerChannel)
+{
+    prepareAuxBuffers(samplesPerChannel * m_audioChannelsCount);
 
     samples_t masterChannelSampleCount = 0;
 
-    for (auto& pair : tracksData) {
-        const std::vector<float>& trackBuffer = pair.second;
+    for (const TrackChannelInfo& info : m_trackChannelInfoList) {
+        if (!info.hasOutput) {
+            continue;
+        }
+
+        const float* buffer = trackBuffer(info) + trackBufferOffset;
 
         bool outBufferIsSilent = false;
-        mixOutputFromChannel(outBuffer, trackBuffer.data(), samplesPerChannel, outBufferIsSilent);
+        mixOutputFromChannel(outBuffer, buffer, samplesPerChannel, outBufferIsSilent);
         masterChannelSampleCount = std::max(samplesPerChannel, masterChannelSampleCount);
 
         if (!outBufferIsSilent) {
@@ -207,8 +238,8 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
             continue;
         }
 
-        const AuxSendsParams& auxSends = m_trackChannels.at(pair.first)->outputParams().auxSends;
-        writeTrackToAuxBuffers(trackBuffer.data(), auxSends, samplesPerChannel);
+        const AuxSendsParams& auxSends = info.channel->outputParams().auxSends;
+        writeTrackToAuxBuffers(buffer, auxSends, samplesPerChannel);
     }
 
     if (m_masterParams.muted || masterChannelSampleCount == 0 || m_isSilence) {
@@ -228,61 +259,122 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
     return masterChannelSampleCount;
 }
 
-void Mixer::processTrackChannels(size_t outBufferSize, size_t samplesPerChannel, TracksData& outTracksData)
+void Mixer::updateTrackChannelInfoList()
 {
-    auto processChannel = [outBufferSize, samplesPerChannel](MixerChannelPtr channel) -> std::vector<float> {
-        thread_local std::vector<float> buffer(outBufferSize, 0.f);
-        thread_local std::vector<float> silent_buffer(outBufferSize, 0.f);
+    m_trackChannelInfoList.clear();
+    m_trackChannelInfoList.reserve(m_trackChannels.size());
 
-        buffer = silent_buffer;
+    m_trackChannelsToProcess.clear();
+    m_trackChannelsToProcess.reserve(m_trackChannels.size());
 
-        if (channel) {
-            channel->process(buffer.data(), samplesPerChannel);
-        }
+    for (const auto& pair : m_trackChannels) {
+        TrackChannelInfo info;
+        info.channel = pair.second;
+        m_trackChannelInfoList.push_back(std::move(info));
+    }
 
-        return buffer;
-    };
+    //! NOTE Force the pool to be reallocated for the new track count on the next callback
+    m_trackBufferStride = 0;
+}
 
-    bool filterTracks = m_isIdle && !m_tracksToProcessWhenIdle.empty();
+void Mixer::prepareTrackBuffers(size_t outBufferSize)
+{
+    size_t stride = ((outBufferSize + CACHE_LINE_FLOATS - 1) / CACHE_LINE_FLOATS) * CACHE_LINE_FLOATS;
+    if (stride == m_trackBufferStride) {
+        return;
+    }
 
-    if (useMultithreading()) {
-        std::map<TrackId, std::future<std::vector<float> > > futures;
+    //! NOTE Only happens when the tracks or the buffer size change, never in the steady state
+    m_trackBufferStride = stride;
+    m_trackBuffers.assign(m_trackChannelInfoList.size() * stride + CACHE_LINE_FLOATS, 0.f);
 
-        for (const auto& pair : m_trackChannels) {
-            if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
-                continue;
-            }
+    void* base = m_trackBuffers.data();
+    size_t space = m_trackBuffers.size() * sizeof(float);
+    std::align(CACHE_LINE_SIZE, sizeof(float), base, space);
+    size_t alignedStart = static_cast<float*>(base) - m_trackBuffers.data();
 
-            if (pair.second->muted()) {
-                pair.second->notifyNoAudioSignal();
-                continue;
-            }
+    for (size_t i = 0; i < m_trackChannelInfoList.size(); ++i) {
+        m_trackChannelInfoList[i].bufferOffset = alignedStart + i * stride;
+    }
+}
+
+float* Mixer::trackBuffer(const TrackChannelInfo& info)
+{
+    return m_trackBuffers.data() + info.bufferOffset;
+}
+
+void Mixer::processTrackChannel(TrackChannelInfo& info, samples_t samplesPerChannel, samples_t stepSize)
+{
+    float* buffer = trackBuffer(info);
+    std::fill(buffer, buffer + m_trackBufferStride, 0.f);
 
-            std::future<std::vector<float> > future = TaskScheduler::instance()->submit(processChannel, pair.second);
-            futures.emplace(pair.first, std::move(future));
+    for (samples_t offset = 0; offset < samplesPerChannel; offset += stepSize) {
+        info.channel->process(buffer + offset * m_audioChannelsCount, std::min(stepSize, samplesPerChannel - offset));
+    }
+}
+
+void Mixer::processTrackChannels(samples_t samplesPerChannel, samples_t stepSize)
+{
+    bool filterTracks = m_isIdle && !m_tracksToProcessWhenIdle.empty();
+
+    for (TrackChannelInfo& info : m_trackChannelInfoList) {
+        info.hasOutput = false;
+
+        if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, info.channel->trackId())) {
+            continue;
         }
 
-        for (auto& pair : futures) {
-            outTracksData.emplace(pair.first, pair.second.get());
+        if (info.channel->muted()) {
+            info.channel->notifyNoAudioSignal();
+            continue;
         }
-    } else {
-        for (const auto& pair : m_trackChannels) {
-            if (filterTracks && !muse::contains(m_tracksToProcessWhenIdle, pair.second->trackId())) {
-                continue;
-            }
 
-            if (pair.second->muted()) {
-                pair.second->notifyNoAudioSignal();
-                continue;
+        info.hasOutput = true;
+    }
+
+    if (!useMultithreading()) {
+        for (TrackChannelInfo& info : m_trackChannelInfoList) {
+            if (info.hasOutput) {
+                processTrackChannel(info, samplesPerChannel, stepSize);
             }
+        }
+
+        return;
+    }
 
-            outTracksData.emplace(pair.first, processChannel(pair.second));
+    //! NOTE The capacity is reserved in updateTrackChannelInfoList, so this doesn't allocate
+    m_trackChannelsToProcess.clear();
+    for (TrackChannelInfo& info : m_trackChannelInfoList) {
+        if (info.hasOutput) {
+            m_trackChannelsToProcess.push_back(&info);
         }
     }
+
+    m_samplesPerChannelToProcess = samplesPerChannel;
+    m_stepSizeToProcess = stepSize;
+
+    //! NOTE Offline rendering has no latency constraint
+    std::chrono::microseconds deadline(0);
+    if (!m_isOffline && m_sampleRate != 0) {
+        deadline = std::chrono::microseconds((samplesPerChannel * 1000000) / m_sampleRate);
+    }
+    m_workerPool->run(m_trackChannelsToProcess.size(), &Mixer::processTrackChannelTask, this, deadline);
+}
+
+void Mixer::processTrackChannelTask(void* mixer, size_t taskIdx)
+{
+    Mixer* self = static_cast<Mixer*>(mixer);
+    self->processTrackChannel(*self->m_trackChannelsToProcess[taskIdx], self->m_samplesPerChannelToProcess,
+                              self->m_stepSizeToProcess);
 }
 
 bool Mixer::useMultithreading() const
 {
+    //! NOTE Offline blocks are big enough to be worth splitting even between a few tracks
+    if (m_isOffline) {
+        return m_nonMutedTrackCount > 1;
+    }
+
     if (m_nonMutedTrackCount < m_minTrackCountForMultithreading) {
         return false;
     }
@@ -391,6 +483,11 @@ async::Channel<audioch_t, AudioSignalVal> Mixer::masterAudioSignalChanges() cons
     return m_audioSignalNotifier.audioSignalChanges;
 }
 
+AudioWorkerPool::Stats Mixer::workerPoolStats() const
+{
+    return m_workerPool->stats();
+}
+
 void Mixer::setIsIdle(bool idle)
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -403,6 +500,13 @@ void Mixer::setIsIdle(bool idle)
     m_tracksToProcessWhenIdle.clear();
 }
 
+void Mixer::setIsOffline(bool offline)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    m_isOffline = offline;
+}
+
 void Mixer::setTracksToProcessWhenIdle(std::unordered_set<TrackId>&& trackIds)
 {
     ONLY_AUDIO_WORKER_THREAD;
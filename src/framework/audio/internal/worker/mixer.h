@@ -31,6 +31,7 @@
 
 #include "abstractaudiosource.h"
 #include "mixerchannel.h"
+#include "audioworkerpool.h"
 #include "internal/dsp/limiter.h"
 #include "ifxresolver.h"
 #include "iaudioconfiguration.h"
@@ -64,9 +65,17 @@ public:
 
     async::Channel<audioch_t, AudioSignalVal> masterAudioSignalChanges() const;
 
+    //! NOTE Deadline misses and timings of the parallel channel processing
+    AudioWorkerPool::Stats workerPoolStats() const;
+
     void setIsIdle(bool idle);
     void setTracksToProcessWhenIdle(std::unordered_set<TrackId>&& trackIds);
 
+    //! NOTE Offline, a process call may ask for a block of several render steps.
+    //! Every track renders the whole block on its own (tracks in parallel),
+    //! then the block is mixed step by step
+    void setIsOffline(bool offline);
+
     // IAudioSource
     void setSampleRate(unsigned int sampleRate) override;
     unsigned int audioChannelsCount() const override;
@@ -74,9 +83,21 @@ public:
     void setIsActive(bool arg) override;
 
 private:
-    using TracksData = std::map<TrackId, std::vector<float> >;
+    //! NOTE Flat, track-index-addressed view of m_trackChannels, used on the audio path
+    struct TrackChannelInfo {
+        MixerChannelPtr channel;
+        size_t bufferOffset = 0;
+        bool hasOutput = false;
+    };
+
+    void updateTrackChannelInfoList();
+    void prepareTrackBuffers(size_t outBufferSize);
+    float* trackBuffer(const TrackChannelInfo& info);
 
-    void processTrackChannels(size_t outBufferSize, size_t samplesPerChannel, TracksData& outTracksData);
+    void processTrackChannels(samples_t samplesPerChannel, samples_t stepSize);
+    void processTrackChannel(TrackChannelInfo& info, samples_t samplesPerChannel, samples_t stepSize);
+    static void processTrackChannelTask(void* mixer, size_t taskIdx);
+    samples_t mixTrackChannels(float* outBuffer, size_t trackBufferOffset, samples_t samplesPerChannel);
     void mixOutputFromChannel(float* outBuffer, const float* inBuffer, unsigned int samplesCount, bool& outBufferIsSilent);
     void prepareAuxBuffers(size_t outBufferSize);
     void writeTrackToAuxBuffers(const float* trackBuffer, const AuxSendsParams& auxSends, samples_t samplesPerChannel);
@@ -91,6 +112,7 @@ private:
     msecs_t currentTime() const;
 
     size_t m_minTrackCountForMultithreading = 0;
+    samples_t m_renderStep = 0;
     size_t m_nonMutedTrackCount = 0;
 
     std::vector<float> m_writeCacheBuff;
@@ -100,6 +122,13 @@ private:
     std::vector<IFxProcessorPtr> m_masterFxProcessors = {};
 
     std::map<TrackId, MixerChannelPtr> m_trackChannels = {};
+    std::vector<TrackChannelInfo> m_trackChannelInfoList;
+    std::vector<float> m_trackBuffers;
+    size_t m_trackBufferStride = 0;
+    std::vector<TrackChannelInfo*> m_trackChannelsToProcess;
+    samples_t m_samplesPerChannelToProcess = 0;
+    samples_t m_stepSizeToProcess = 0;
+    AudioWorkerPoolPtr m_workerPool;
     std::unordered_set<TrackId> m_tracksToProcessWhenIdle;
 
     struct AuxChannelInfo {
@@ -119,6 +148,7 @@ private:
 
     bool m_isSilence = false;
     bool m_isIdle = false;
+    bool m_isOffline = false;
 };
 
 using MixerPtr = std::shared_ptr<Mixer>;
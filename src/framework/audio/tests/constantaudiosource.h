@@ -0,0 +1,61 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUSE_AUDIO_CONSTANTAUDIOSOURCE_H
+#define MUSE_AUDIO_CONSTANTAUDIOSOURCE_H
+
+#include <algorithm>
+
+#include "internal/worker/track.h"
+
+namespace muse::audio {
+static constexpr audioch_t CHANNELS_COUNT = 2;
+
+//! NOTE Produces a constant signal, so the signal notifiers stay quiet after the first block
+class ConstantAudioSource : public ITrackAudioInput
+{
+public:
+    bool isActive() const override { return true; }
+    void setIsActive(bool) override {}
+    void setSampleRate(unsigned int) override {}
+    unsigned int audioChannelsCount() const override { return CHANNELS_COUNT; }
+    async::Channel<unsigned int> audioChannelsCountChanged() const override { return m_channelsCountChanged; }
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        std::fill(buffer, buffer + samplesPerChannel * CHANNELS_COUNT, 0.01f);
+        return samplesPerChannel;
+    }
+
+    void seek(const msecs_t) override {}
+    const AudioInputParams& inputParams() const override { return m_params; }
+    void applyInputParams(const AudioInputParams&) override {}
+    async::Channel<AudioInputParams> inputParamsChanged() const override { return m_paramsChanged; }
+
+private:
+    AudioInputParams m_params;
+    async::Channel<unsigned int> m_channelsCountChanged;
+    async::Channel<AudioInputParams> m_paramsChanged;
+};
+}
+
+#endif // MUSE_AUDIO_CONSTANTAUDIOSOURCE_H
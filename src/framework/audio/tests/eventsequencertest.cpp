@@ -0,0 +1,201 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "internal/abstracteventsequencer.h"
+#include "internal/audiosanitizer.h"
+
+using namespace muse;
+using namespace muse::audio;
+
+namespace muse::audio {
+class TestSequencer : public AbstractEventSequencer<int>
+{
+public:
+    void updateOffStreamEvents(const mpe::PlaybackEventsMap&, const mpe::PlaybackParamList&) override {}
+    void updateMainStreamEvents(const mpe::PlaybackEventsMap&, const mpe::DynamicLevelLayers&,
+                                const mpe::PlaybackParamLayers&) override {}
+    void updateMainStreamEvents(const mpe::TimestampRangeList&, const mpe::PlaybackEventsMap&, const mpe::DynamicLevelLayers&,
+                                const mpe::PlaybackParamLayers&) override {}
+
+    void setMainStream(const std::vector<std::pair<msecs_t, int> >& events)
+    {
+        m_mainStreamEvents.clear();
+
+        for (const auto& pair : events) {
+            m_mainStreamEvents.add(pair.first, pair.second);
+        }
+
+        m_mainStreamEvents.finalize();
+        updateMainSequenceIterator();
+    }
+
+    void setOffStream(const std::vector<std::pair<msecs_t, int> >& events)
+    {
+        m_offStreamEvents.clear();
+
+        for (const auto& pair : events) {
+            m_offStreamEvents.add(pair.first, pair.second);
+        }
+
+        m_offStreamEvents.finalize();
+        updateOffSequenceIterator();
+    }
+};
+}
+
+class Audio_EventSequencerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+    }
+
+    static std::vector<int> values(const TestSequencer::EventSequence& sequence)
+    {
+        std::vector<int> result;
+
+        for (const TestSequencer::EventType& event : sequence) {
+            result.push_back(std::get<int>(event));
+        }
+
+        return result;
+    }
+};
+
+TEST_F(Audio_EventSequencerTest, Timeline_SortsAndMergesEvents)
+{
+    //! [GIVEN] Events added out of order, with a duplicate
+    EventTimeline<int> timeline;
+    timeline.add(20, 3);
+    timeline.add(10, 2);
+    timeline.add(10, 1);
+    timeline.add(20, 3);
+    timeline.add(0, 5);
+
+    //! [WHEN] Finalize the timeline
+    timeline.finalize();
+
+    //! [THEN] The timestamps are unique and sorted, the events are sorted within each timestamp
+    ASSERT_EQ(timeline.size(), 3);
+    EXPECT_EQ(timeline.eventCount(), 4);
+    EXPECT_EQ(timeline.maxEventsPerTime(), 2);
+
+    EXPECT_EQ(timeline.time(0), 0);
+    EXPECT_EQ(timeline.time(1), 10);
+    EXPECT_EQ(timeline.time(2), 20);
+
+    EXPECT_EQ(std::vector<int>(timeline.eventsBegin(1), timeline.eventsEnd(1)), std::vector<int>({ 1, 2 }));
+    EXPECT_EQ(std::vector<int>(timeline.eventsBegin(2), timeline.eventsEnd(2)), std::vector<int>({ 3 }));
+
+    //! [THEN] Seeking finds the right position
+    EXPECT_EQ(timeline.lowerBound(10), 1);
+    EXPECT_EQ(timeline.lowerBound(11), 2);
+    EXPECT_EQ(timeline.upperBound(10), 2);
+    EXPECT_EQ(timeline.lowerBound(100), 3);
+}
+
+TEST_F(Audio_EventSequencerTest, Timeline_ReplacesEventsByOrigin)
+{
+    //! [GIVEN] Events derived from the source events at 0, 10 and 20
+    EventTimeline<int> timeline;
+    timeline.add(0, 1, 0);
+    timeline.add(5, 2, 0);
+    timeline.add(10, 3, 10);
+    timeline.add(25, 4, 10);
+    timeline.add(20, 5, 20);
+    timeline.add(25, 6, 20);
+    timeline.finalize();
+
+    //! [WHEN] The events of the source at 10 are replaced, one of the new events duplicates an event of the source at 0
+    timeline.add(12, 7, 10);
+    timeline.add(5, 2, 10);
+    timeline.replace([](msecs_t origin) {
+        return origin == 10;
+    });
+
+    //! [THEN] Only the events of the replaced source are gone, the new ones are merged in
+    ASSERT_EQ(timeline.size(), 5);
+    EXPECT_EQ(timeline.eventCount(), 5);
+
+    std::vector<std::pair<msecs_t, int> > events;
+    for (size_t idx = 0; idx < timeline.size(); ++idx) {
+        for (auto it = timeline.eventsBegin(idx); it != timeline.eventsEnd(idx); ++it) {
+            events.push_back({ timeline.time(idx), *it });
+        }
+    }
+
+    std::vector<std::pair<msecs_t, int> > expected { { 0, 1 }, { 5, 2 }, { 12, 7 }, { 20, 5 }, { 25, 6 } };
+    EXPECT_EQ(events, expected);
+
+    //! [WHEN] The source event at 0 is removed
+    timeline.replace([](msecs_t origin) {
+        return origin == 0;
+    });
+
+    //! [THEN] The equivalent event from the other source stays
+    EXPECT_EQ(timeline.time(0), 5);
+    EXPECT_EQ(*timeline.eventsBegin(0), 2);
+    EXPECT_EQ(timeline.eventCount(), 4);
+}
+
+TEST_F(Audio_EventSequencerTest, MainStream_PlaysAllDueEventsAndSeeks)
+{
+    //! [GIVEN] Active sequencer with the main stream
+    TestSequencer sequencer;
+    sequencer.setActive(true);
+    sequencer.setMainStream({ { 0, 1 }, { 4, 2 }, { 8, 3 }, { 30, 4 } });
+
+    //! [WHEN] Play the first 10 msecs
+    //! [THEN] Every event up to the new position is returned in time order
+    EXPECT_EQ(values(sequencer.eventsToBePlayed(10)), std::vector<int>({ 1, 2, 3 }));
+
+    //! [THEN] Nothing is due in the next 10 msecs
+    EXPECT_TRUE(sequencer.eventsToBePlayed(10).empty());
+
+    //! [WHEN] Seek back
+    sequencer.setPlaybackPosition(4);
+
+    //! [THEN] Playback restarts from the first event at the position
+    EXPECT_EQ(values(sequencer.eventsToBePlayed(0)), std::vector<int>({ 2 }));
+    EXPECT_EQ(values(sequencer.eventsToBePlayed(30)), std::vector<int>({ 3, 4 }));
+}
+
+TEST_F(Audio_EventSequencerTest, OffStream_IsRelativeToReceiving)
+{
+    //! [GIVEN] Inactive sequencer with the off stream
+    TestSequencer sequencer;
+    sequencer.setActive(false);
+    sequencer.setOffStream({ { 0, 1 }, { 15, 2 } });
+
+    //! [WHEN] Play the first 10 msecs
+    EXPECT_EQ(values(sequencer.eventsToBePlayed(10)), std::vector<int>({ 1 }));
+
+    //! [WHEN] Change the playback position
+    sequencer.setPlaybackPosition(1000);
+
+    //! [THEN] The off stream continues where it was
+    EXPECT_EQ(values(sequencer.eventsToBePlayed(10)), std::vector<int>({ 2 }));
+    EXPECT_TRUE(sequencer.eventsToBePlayed(10).empty());
+}
@@ -0,0 +1,170 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "global/modularity/ioc.h"
+
+#include "internal/audiosanitizer.h"
+#include "internal/worker/mixer.h"
+
+#include "tests/mocks/audioconfigurationmock.h"
+#include "tests/constantaudiosource.h"
+
+using ::testing::Return;
+using ::testing::NiceMock;
+
+using namespace muse;
+using namespace muse::audio;
+
+//! NOTE The global operator new is replaced only in this test binary, that's why it has no other tests.
+//! The allocations are counted only while an AllocationCounter exists, otherwise it just calls malloc
+static std::atomic<bool> s_countAllocations = false;
+static std::atomic<size_t> s_allocationCount = 0;
+
+void* operator new(size_t size)
+{
+    if (s_countAllocations.load(std::memory_order_relaxed)) {
+        s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace muse::audio {
+static constexpr unsigned int SAMPLE_RATE = 48000;
+static constexpr samples_t SAMPLES_PER_CHANNEL = 512;
+static constexpr size_t TRACK_COUNT = 48;
+
+//! NOTE Counts the allocations of all the threads during its lifetime
+class AllocationCounter
+{
+public:
+    AllocationCounter()
+    {
+        s_allocationCount = 0;
+        s_countAllocations = true;
+    }
+
+    ~AllocationCounter()
+    {
+        s_countAllocations = false;
+    }
+
+    size_t count() const
+    {
+        return s_allocationCount;
+    }
+};
+
+class Audio_MixerAllocationsTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+
+        m_configuration = std::make_shared<NiceMock<AudioConfigurationMock> >();
+        modularity::globalIoc()->registerExport<IAudioConfiguration>("utests", m_configuration);
+    }
+
+    void TearDown() override
+    {
+        m_mixer.reset();
+        modularity::globalIoc()->unregister<IAudioConfiguration>("utests");
+    }
+
+    void makeMixer(size_t minTrackCountForMultithreading)
+    {
+        ON_CALL(*m_configuration, minTrackCountForMultithreading())
+        .WillByDefault(Return(minTrackCountForMultithreading));
+
+        m_mixer = std::make_shared<Mixer>();
+        m_mixer->setSampleRate(SAMPLE_RATE);
+        m_mixer->setAudioChannelsCount(CHANNELS_COUNT);
+
+        for (size_t i = 0; i < TRACK_COUNT; ++i) {
+            ASSERT_TRUE(m_mixer->addChannel(static_cast<TrackId>(i), std::make_shared<ConstantAudioSource>()).ret);
+        }
+    }
+
+    size_t countAllocationsInSteadyState()
+    {
+        std::vector<float> buffer(SAMPLES_PER_CHANNEL * CHANNELS_COUNT);
+
+        //! NOTE Warm up: the buffer pool and the signal notifiers are set up during the first blocks
+        for (int i = 0; i < 10; ++i) {
+            m_mixer->process(buffer.data(), SAMPLES_PER_CHANNEL);
+        }
+
+        AllocationCounter counter;
+
+        for (int i = 0; i < 1000; ++i) {
+            m_mixer->process(buffer.data(), SAMPLES_PER_CHANNEL);
+        }
+
+        return counter.count();
+    }
+
+    std::shared_ptr<NiceMock<AudioConfigurationMock> > m_configuration;
+    MixerPtr m_mixer;
+};
+}
+
+TEST_F(Audio_MixerAllocationsTest, Process_SingleThreaded_DoesNotAllocate)
+{
+    //! [GIVEN] A mixer with many tracks, which processes them on the calling thread
+    makeMixer(TRACK_COUNT + 1);
+
+    //! [THEN] There are no allocations in the steady state
+    EXPECT_EQ(countAllocationsInSteadyState(), 0u);
+}
+
+TEST_F(Audio_MixerAllocationsTest, Process_MultiThreaded_DoesNotAllocate)
+{
+    //! [GIVEN] A mixer with many tracks, which fans them out to the worker pool
+    makeMixer(1);
+
+    //! [THEN] There are no allocations in the steady state
+    EXPECT_EQ(countAllocationsInSteadyState(), 0u);
+
+    //! [THEN] Every callback went through the worker pool
+    EXPECT_GE(m_mixer->workerPoolStats().runCount, 1000u);
+}
@@ -0,0 +1,283 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "global/modularity/ioc.h"
+
+#include "internal/audiosanitizer.h"
+#include "internal/worker/mixer.h"
+
+#include "tests/mocks/audioconfigurationmock.h"
+#include "tests/constantaudiosource.h"
+
+using ::testing::Return;
+using ::testing::NiceMock;
+
+using namespace muse;
+using namespace muse::audio;
+
+namespace muse::audio {
+static constexpr unsigned int SAMPLE_RATE = 48000;
+static constexpr samples_t SAMPLES_PER_CHANNEL = 512;
+static constexpr size_t TRACK_COUNT = 48;
+
+//! NOTE Produces a ramp, which continues from call to call, and remembers the biggest requested block
+class RampAudioSource : public ConstantAudioSource
+{
+public:
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        for (samples_t s = 0; s < samplesPerChannel; ++s) {
+            float sample = static_cast<float>((m_position + s) % 100) / 1000.f;
+            std::fill(buffer + s * CHANNELS_COUNT, buffer + (s + 1) * CHANNELS_COUNT, sample);
+        }
+
+        m_position += samplesPerChannel;
+        m_maxSamplesPerChannel = std::max(m_maxSamplesPerChannel, samplesPerChannel);
+
+        return samplesPerChannel;
+    }
+
+    samples_t maxSamplesPerChannel() const { return m_maxSamplesPerChannel; }
+
+private:
+    samples_t m_position = 0;
+    samples_t m_maxSamplesPerChannel = 0;
+};
+
+//! NOTE Fills its track buffer with its own marker and checks, after letting the other workers run,
+//! that nobody has written into it in the meantime
+class MarkerAudioSource : public ConstantAudioSource
+{
+public:
+    MarkerAudioSource(float marker, std::atomic<size_t>& corruptions, std::atomic<size_t>& misalignments)
+        : m_marker(marker), m_corruptions(corruptions), m_misalignments(misalignments) {}
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        if (reinterpret_cast<uintptr_t>(buffer) % 64 != 0) {
+            ++m_misalignments;
+        }
+
+        const size_t size = samplesPerChannel * CHANNELS_COUNT;
+        std::fill(buffer, buffer + size, m_marker);
+
+        std::this_thread::yield();
+
+        if (std::any_of(buffer, buffer + size, [this](float sample) { return sample != m_marker; })) {
+            ++m_corruptions;
+        }
+
+        return samplesPerChannel;
+    }
+
+private:
+    float m_marker = 0.f;
+    std::atomic<size_t>& m_corruptions;
+    std::atomic<size_t>& m_misalignments;
+};
+
+class Audio_MixerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+
+        m_configuration = std::make_shared<NiceMock<AudioConfigurationMock> >();
+        modularity::globalIoc()->registerExport<IAudioConfiguration>("utests", m_configuration);
+    }
+
+    void TearDown() override
+    {
+        m_mixer.reset();
+        modularity::globalIoc()->unregister<IAudioConfiguration>("utests");
+    }
+
+    void makeMixer(size_t minTrackCountForMultithreading)
+    {
+        ON_CALL(*m_configuration, minTrackCountForMultithreading())
+        .WillByDefault(Return(minTrackCountForMultithreading));
+
+        m_mixer = std::make_shared<Mixer>();
+        m_mixer->setSampleRate(SAMPLE_RATE);
+        m_mixer->setAudioChannelsCount(CHANNELS_COUNT);
+
+        for (size_t i = 0; i < TRACK_COUNT; ++i) {
+            ASSERT_TRUE(m_mixer->addChannel(static_cast<TrackId>(i), std::make_shared<ConstantAudioSource>()).ret);
+        }
+    }
+
+    std::vector<std::shared_ptr<RampAudioSource> > makeRampMixer(samples_t renderStep)
+    {
+        ON_CALL(*m_configuration, minTrackCountForMultithreading())
+        .WillByDefault(Return(TRACK_COUNT + 1));
+        ON_CALL(*m_configuration, renderStep())
+        .WillByDefault(Return(renderStep));
+
+        m_mixer = std::make_shared<Mixer>();
+        m_mixer->setSampleRate(SAMPLE_RATE);
+        m_mixer->setAudioChannelsCount(CHANNELS_COUNT);
+
+        std::vector<std::shared_ptr<RampAudioSource> > sources;
+        for (size_t i = 0; i < TRACK_COUNT; ++i) {
+            sources.push_back(std::make_shared<RampAudioSource>());
+            m_mixer->addChannel(static_cast<TrackId>(i), sources.back());
+        }
+
+        return sources;
+    }
+
+    //! NOTE Adds and removes tracks between the blocks and changes the block size,
+    //! so the track buffer pool is reallocated and freed again and again
+    std::vector<float> processWithChangingTracks(size_t minTrackCountForMultithreading, std::atomic<size_t>& corruptions,
+                                                 std::atomic<size_t>& misalignments)
+    {
+        ON_CALL(*m_configuration, minTrackCountForMultithreading())
+        .WillByDefault(Return(minTrackCountForMultithreading));
+
+        m_mixer = std::make_shared<Mixer>();
+        m_mixer->setSampleRate(SAMPLE_RATE);
+        m_mixer->setAudioChannelsCount(CHANNELS_COUNT);
+
+        auto addTrack = [&](size_t idx) {
+            float marker = static_cast<float>(idx + 1) / 1024.f;
+            m_mixer->addChannel(static_cast<TrackId>(idx), std::make_shared<MarkerAudioSource>(marker, corruptions, misalignments));
+        };
+
+        for (size_t i = 0; i < TRACK_COUNT; ++i) {
+            addTrack(i);
+        }
+
+        static const std::vector<samples_t> BLOCK_SIZES = { SAMPLES_PER_CHANNEL, 37, 128, 1, SAMPLES_PER_CHANNEL * 2 };
+
+        std::vector<float> output;
+        for (size_t round = 0; round < 50; ++round) {
+            if (round % 2 == 0) {
+                m_mixer->removeChannel(static_cast<TrackId>((round * 7) % TRACK_COUNT));
+            } else {
+                addTrack(((round - 1) * 7) % TRACK_COUNT);
+            }
+
+            samples_t blockSize = BLOCK_SIZES.at(round % BLOCK_SIZES.size());
+            std::vector<float> buffer(blockSize * CHANNELS_COUNT);
+            m_mixer->process(buffer.data(), blockSize);
+
+            output.insert(output.end(), buffer.begin(), buffer.end());
+        }
+
+        return output;
+    }
+
+    std::shared_ptr<NiceMock<AudioConfigurationMock> > m_configuration;
+    MixerPtr m_mixer;
+};
+}
+
+TEST_F(Audio_MixerTest, Process_MultiThreaded_MatchesSingleThreaded)
+{
+    std::vector<float> expected(SAMPLES_PER_CHANNEL * CHANNELS_COUNT);
+    std::vector<float> actual(SAMPLES_PER_CHANNEL * CHANNELS_COUNT);
+
+    //! [GIVEN] A mixer which processes the tracks on the calling thread
+    makeMixer(TRACK_COUNT + 1);
+
+    //! [WHEN] Process a block
+    EXPECT_EQ(m_mixer->process(expected.data(), SAMPLES_PER_CHANNEL), SAMPLES_PER_CHANNEL);
+
+    //! [GIVEN] The same mixer, which uses the worker pool
+    makeMixer(1);
+
+    //! [WHEN] Process a block
+    EXPECT_EQ(m_mixer->process(actual.data(), SAMPLES_PER_CHANNEL), SAMPLES_PER_CHANNEL);
+
+    //! [THEN] The output is not silent and identical, since the tracks are mixed in the same order
+    EXPECT_NE(expected.front(), 0.f);
+    EXPECT_EQ(expected, actual);
+}
+
+TEST_F(Audio_MixerTest, Process_MultiThreaded_ChangingTracks_NoCrossThreadCorruption)
+{
+    std::atomic<size_t> corruptions = 0;
+    std::atomic<size_t> misalignments = 0;
+
+    //! [GIVEN] A mixer which processes the tracks on the calling thread
+    //! [WHEN] Tracks are added and removed between the blocks
+    std::vector<float> expected = processWithChangingTracks(TRACK_COUNT * 2, corruptions, misalignments);
+
+    //! [GIVEN] The same mixer, which fans the tracks out to the worker pool
+    //! [WHEN] The same tracks are added and removed
+    std::vector<float> actual = processWithChangingTracks(1, corruptions, misalignments);
+
+    //! [THEN] The worker pool was used
+    EXPECT_GE(m_mixer->workerPoolStats().runCount, 50u);
+
+    //! [THEN] No track buffer was written by another track, and each one starts on its own cache line
+    EXPECT_EQ(corruptions.load(), 0u);
+    EXPECT_EQ(misalignments.load(), 0u);
+
+    //! [THEN] The output is not silent and identical
+    ASSERT_EQ(expected.size(), actual.size());
+    EXPECT_NE(*std::max_element(expected.begin(), expected.end()), 0.f);
+    EXPECT_EQ(expected, actual);
+}
+
+TEST_F(Audio_MixerTest, Process_Offline_MatchesRealTimeSteps)
+{
+    constexpr samples_t RENDER_STEP = 128;
+    constexpr size_t STEPS_COUNT = 8;
+
+    std::vector<float> expected(RENDER_STEP * STEPS_COUNT * CHANNELS_COUNT);
+    std::vector<float> actual(RENDER_STEP * STEPS_COUNT * CHANNELS_COUNT);
+
+    //! [GIVEN] A mixer, which is processed by render steps
+    makeRampMixer(RENDER_STEP);
+
+    //! [WHEN] Process several steps one by one
+    for (size_t step = 0; step < STEPS_COUNT; ++step) {
+        m_mixer->process(expected.data() + step * RENDER_STEP * CHANNELS_COUNT, RENDER_STEP);
+    }
+
+    //! [GIVEN] The same mixer offline
+    std::vector<std::shared_ptr<RampAudioSource> > sources = makeRampMixer(RENDER_STEP);
+    m_mixer->setIsOffline(true);
+
+    //! [WHEN] Process all the steps as one block
+    EXPECT_EQ(m_mixer->process(actual.data(), RENDER_STEP * STEPS_COUNT), RENDER_STEP * STEPS_COUNT);
+
+    //! [THEN] The tracks are still rendered by render steps
+    for (const auto& source : sources) {
+        EXPECT_EQ(source->maxSamplesPerChannel(), RENDER_STEP);
+    }
+
+    //! [THEN] The output is the same
+    EXPECT_EQ(expected, actual);
+
+    //! [THEN] The tracks were rendered by the worker pool, once for the whole block
+    EXPECT_EQ(m_mixer->workerPoolStats().runCount, 1u);
+}
@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <QTemporaryDir>
+
+#include "internal/encoders/wavencoder.h"
+
+using namespace muse;
+using namespace muse::audio;
+using namespace muse::audio::encode;
+
+static constexpr size_t WAV_HEADER_SIZE = 46;
+static constexpr size_t WAV_DATA_LENGTH_OFFSET = 42;
+
+class Audio_WavEncoderTest : public ::testing::Test
+{
+public:
+    static std::vector<char> readFile(const io::path_t& path)
+    {
+        std::ifstream stream(path.toStdString(), std::ios_base::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+};
+
+TEST_F(Audio_WavEncoderTest, Encode_ByChunks)
+{
+    QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+
+    io::path_t path = io::path_t(tempDir.path()) + "/chunks.wav";
+
+    SoundTrackFormat format;
+    format.type = SoundTrackType::WAV;
+    format.sampleRate = 48000;
+    format.audioChannelsNumber = 2;
+
+    //! GIVEN An encoder, which doesn't know the exact track length
+    WavEncoder encoder;
+    ASSERT_TRUE(encoder.init(path, format, 0));
+
+    //! DO Encode the track by chunks of different sizes
+    const std::vector<samples_t> chunks = { 512, 512, 100, 4096 };
+    std::vector<float> expectedData;
+
+    for (samples_t samplesPerChannel : chunks) {
+        std::vector<float> chunk(samplesPerChannel * format.audioChannelsNumber);
+        for (size_t i = 0; i < chunk.size(); ++i) {
+            chunk[i] = static_cast<float>(expectedData.size() + i) / 100000.f;
+        }
+
+        EXPECT_EQ(encoder.encode(samplesPerChannel, chunk.data()), samplesPerChannel);
+        expectedData.insert(expectedData.end(), chunk.begin(), chunk.end());
+    }
+
+    EXPECT_TRUE(encoder.flush());
+
+    //! CHECK The header contains the total length and the data follows in order
+    std::vector<char> file = readFile(path);
+    ASSERT_EQ(file.size(), WAV_HEADER_SIZE + expectedData.size() * sizeof(float));
+
+    uint32_t dataLength = 0;
+    std::memcpy(&dataLength, file.data() + WAV_DATA_LENGTH_OFFSET, sizeof(dataLength));
+    EXPECT_EQ(dataLength, expectedData.size() * sizeof(float));
+
+    EXPECT_EQ(std::memcmp(file.data() + WAV_HEADER_SIZE, expectedData.data(), expectedData.size() * sizeof(float)), 0);
+}
@@ -22,6 +22,7 @@
 #include "drawmodule.h"
 
 #include "global/modularity/ioc.h"
+#include "global/iglobalconfiguration.h"
 
 #ifndef DRAW_NO_INTERNAL
 #include "internal/qfontprovider.h"
@@ -64,7 +65,21 @@ void DrawModule::onInit(const IApplication::RunMode&)
 {
 #ifndef DRAW_NO_INTERNAL
 #ifndef MUSE_MODULE_DRAW_USE_QTFONTMETRICS
-    m_fontsEngine->init();
+    io::path_t renderCacheDir;
+    if (auto globalConfiguration = ioc()->resolve<IGlobalConfiguration>(moduleName())) {
+        renderCacheDir = globalConfiguration->userAppDataPath() + "/glyphcache";
+    }
+
+    m_fontsEngine->init(renderCacheDir);
+#endif
+#endif // DRAW_NO_INTERNAL
+}
+
+void DrawModule::onDeinit()
+{
+#ifndef DRAW_NO_INTERNAL
+#ifndef MUSE_MODULE_DRAW_USE_QTFONTMETRICS
+    m_fontsEngine->deinit();
 #endif
 #endif // DRAW_NO_INTERNAL
 }
@@ -33,64 +33,69 @@ struct DummyGlyph {
 #endif
 };
 
-static const DummyGlyph& dummyGlyph()
+static DummyGlyph makeDummyGlyph()
 {
-    static DummyGlyph g;
-    if (g.textAdvance == 0) {
-        g.textBbox = FBBox(0, -8064, 4160, 9728);
-        g.textAdvance = 4160;
-        g.symBbox = FBBox(0, -4011, 2079, 4817);
-        g.symAdvance = 2080;
+    DummyGlyph g;
+    g.textBbox = FBBox(0, -8064, 4160, 9728);
+    g.textAdvance = 4160;
+    g.symBbox = FBBox(0, -4011, 2079, 4817);
+    g.symAdvance = 2080;
 
 #ifndef MUSE_MODULE_DRAW_USE_QTTEXTDRAW
-        using namespace msdfgen;
-
-        g.shape.inverseYAxis = true;
-        g.shape.fillRule = static_cast<msdfgen::FillRule>(msdfgen::FillRule::NonZero);
-
-        Contour c1;
-        {
-            std::vector<Point2> points = {
-                Point2(0, -25), Point2(64, -25),
-                Point2(64, -25), Point2(64, 125),
-                Point2(64, 125), Point2(0, 125),
-                Point2(0, 125), Point2(0, -25)
-            };
-
-            for (size_t i = 0; i < 8;) {
-                EdgeSegment e;
-                e.actualType = EdgeSegment::ActualType::Linear;
-                e.segments.linear.p[0] = points.at(i++);
-                e.segments.linear.p[1] = points.at(i++);
-                c1.edges.push_back(e);
-            }
+    using namespace msdfgen;
+
+    g.shape.inverseYAxis = true;
+    g.shape.fillRule = static_cast<msdfgen::FillRule>(msdfgen::FillRule::NonZero);
+
+    Contour c1;
+    {
+        std::vector<Point2> points = {
+            Point2(0, -25), Point2(64, -25),
+            Point2(64, -25), Point2(64, 125),
+            Point2(64, 125), Point2(0, 125),
+            Point2(0, 125), Point2(0, -25)
+        };
+
+        for (size_t i = 0; i < 8;) {
+            EdgeSegment e;
+            e.actualType = EdgeSegment::ActualType::Linear;
+            e.segments.linear.p[0] = points.at(i++);
+            e.segments.linear.p[1] = points.at(i++);
+            c1.edges.push_back(e);
         }
-        g.shape.contours.push_back(c1);
-
-        Contour c2;
-        {
-            std::vector<Point2> points = {
-                Point2(9, 115), Point2(54, 115),
-                Point2(54, 115), Point2(54, -15),
-                Point2(54, -15), Point2(9, -15),
-                Point2(9, -15), Point2(9, 115)
-            };
-
-            for (size_t i = 0; i < 8;) {
-                EdgeSegment e;
-                e.actualType = EdgeSegment::ActualType::Linear;
-                e.segments.linear.p[0] = points.at(i++);
-                e.segments.linear.p[1] = points.at(i++);
-                c2.edges.push_back(e);
-            }
+    }
+    g.shape.contours.push_back(c1);
+
+    Contour c2;
+    {
+        std::vector<Point2> points = {
+            Point2(9, 115), Point2(54, 115),
+            Point2(54, 115), Point2(54, -15),
+            Point2(54, -15), Point2(9, -15),
+            Point2(9, -15), Point2(9, 115)
+        };
+
+        for (size_t i = 0; i < 8;) {
+            EdgeSegment e;
+            e.actualType = EdgeSegment::ActualType::Linear;
+            e.segments.linear.p[0] = points.at(i++);
+            e.segments.linear.p[1] = points.at(i++);
+            c2.edges.push_back(e);
         }
-        g.shape.contours.push_back(c2);
-#endif
     }
+    g.shape.contours.push_back(c2);
+#endif
 
     return g;
 }
 
+static const DummyGlyph& dummyGlyph()
+{
+    //! NOTE Initialized once, it's thread safe
+    static const DummyGlyph g = makeDummyGlyph();
+    return g;
+}
+
 FontFaceDU::FontFaceDU(IFontFace* origin)
     : m_origin(origin)
 {
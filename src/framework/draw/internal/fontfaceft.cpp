@@ -92,6 +92,7 @@ struct muse::draw::FData
     ByteArray fontData;
     FT_Face face = nullptr;
     hb_font_t* hb_font = nullptr;
+    std::unordered_map<char32_t, glyph_idx_t> glyphIndexes;
     std::unordered_map<glyph_idx_t, GlyphMetrics> glyphsMetrics;
     std::unordered_map<glyph_idx_t, SymbolMetrics> symbolMetrics;
     FT_Size_Metrics metrics;
@@ -198,7 +199,11 @@ std::vector<GlyphPos> FontFaceFT::glyphs(const char32_t* text, int text_length)
         hb_buffer_set_segment_properties(hb_buffer, &props);
         hb_buffer_guess_segment_properties(hb_buffer);
 
-        hb_shape(m_data->hb_font, hb_buffer, &HB_FEATURES[0], HB_FEATURES.size());
+        {
+            std::lock_guard faceLock(m_faceMutex);
+            hb_shape(m_data->hb_font, hb_buffer, &HB_FEATURES[0], HB_FEATURES.size());
+        }
+
         unsigned int len = hb_buffer_get_length(hb_buffer);
         result.reserve(len);
 
@@ -221,12 +226,27 @@ glyph_idx_t FontFaceFT::glyphIndex(char32_t ucs4) const
         return 0;
     }
 
-    FT_UInt index = FT_Get_Char_Index(m_data->face, ucs4);
-    return static_cast<glyph_idx_t>(index);
+    {
+        std::shared_lock lock(m_cacheMutex);
+        auto it = m_data->glyphIndexes.find(ucs4);
+        if (it != m_data->glyphIndexes.end()) {
+            return it->second;
+        }
+    }
+
+    FT_UInt index = 0;
+    {
+        std::lock_guard faceLock(m_faceMutex);
+        index = FT_Get_Char_Index(m_data->face, ucs4);
+    }
+
+    std::unique_lock lock(m_cacheMutex);
+    return m_data->glyphIndexes.emplace(ucs4, static_cast<glyph_idx_t>(index)).first->second;
 }
 
 glyph_idx_t FontFaceFT::glyphIndex(const std::string& glyphName) const
 {
+    std::lock_guard faceLock(m_faceMutex);
     FT_UInt index = FT_Get_Name_Index(m_data->face, glyphName.c_str());
     return static_cast<glyph_idx_t>(index);
 }
@@ -252,7 +272,11 @@ char32_t FontFaceFT::findCharCode(glyph_idx_t idx) const
         return FT_ULong(0);
     };
 
-    char32_t c = findC(idx);
+    char32_t c = 0;
+    {
+        std::lock_guard faceLock(m_faceMutex);
+        c = findC(idx);
+    }
 
     // check
     {
@@ -317,21 +341,30 @@ const msdfgen::Shape& FontFaceFT::glyphShape(glyph_idx_t idx) const
         return null;
     }
 
-    auto it = m_cache.find(idx);
-    if (it != m_cache.end()) {
-        return it->second;
-    }
-
-    if (FT_Load_Glyph(m_data->face, index, FT_LOAD_DEFAULT) != 0) {
-        return null;
+    {
+        std::shared_lock lock(m_cacheMutex);
+        auto it = m_cache.find(idx);
+        if (it != m_cache.end()) {
+            return it->second;
+        }
     }
 
     std::pair<glyph_idx_t, msdfgen::Shape> v;
     v.first = idx;
-    v.second = msdfgen::loadGlyphSlot(m_data->face->glyph, nullptr);
+
+    {
+        std::lock_guard faceLock(m_faceMutex);
+        if (FT_Load_Glyph(m_data->face, index, FT_LOAD_DEFAULT) != 0) {
+            return null;
+        }
+
+        v.second = msdfgen::loadGlyphSlot(m_data->face->glyph, nullptr);
+    }
+
     v.second.normalize();
     v.second.inverseYAxis = true;
 
+    std::unique_lock lock(m_cacheMutex);
     return m_cache.insert(std::move(v)).first->second;
 }
 
@@ -358,10 +391,13 @@ f26dot6_t FontFaceFT::descent() const
 
 f26dot6_t FontFaceFT::xHeight() const
 {
-    TT_OS2* os2 = (TT_OS2*)FT_Get_Sfnt_Table(m_data->face, ft_sfnt_os2);
-    if (os2 && os2->sxHeight) {
-        f26dot6_t result = std::round(os2->sxHeight * m_data->face->size->metrics.y_ppem * 64.0 / (double)m_data->face->units_per_EM);
-        return result;
+    {
+        std::lock_guard faceLock(m_faceMutex);
+        TT_OS2* os2 = (TT_OS2*)FT_Get_Sfnt_Table(m_data->face, ft_sfnt_os2);
+        if (os2 && os2->sxHeight) {
+            f26dot6_t result = std::round(os2->sxHeight * m_data->face->size->metrics.y_ppem * 64.0 / (double)m_data->face->units_per_EM);
+            return result;
+        }
     }
 
     const glyph_idx_t glyph = glyphIndex('x');
@@ -374,8 +410,12 @@ f26dot6_t FontFaceFT::xHeight() const
 
 GlyphMetrics* FontFaceFT::glyphMetrics(glyph_idx_t idx) const
 {
-    if (m_data->glyphsMetrics.find(idx) != m_data->glyphsMetrics.end()) {
-        return &m_data->glyphsMetrics.at(idx);
+    {
+        std::shared_lock lock(m_cacheMutex);
+        auto it = m_data->glyphsMetrics.find(idx);
+        if (it != m_data->glyphsMetrics.end()) {
+            return &it->second;
+        }
     }
 
     FT_UInt index = static_cast<FT_UInt>(idx);
@@ -383,28 +423,37 @@ GlyphMetrics* FontFaceFT::glyphMetrics(glyph_idx_t idx) const
         return nullptr;
     }
 
-    if (FT_Load_Glyph(m_data->face, index, FT_LOAD_DEFAULT) != 0) {
-        return nullptr;
-    }
+    GlyphMetrics gm;
 
-    FT_GlyphSlot slot = m_data->face->glyph;
+    {
+        std::lock_guard faceLock(m_faceMutex);
+        if (FT_Load_Glyph(m_data->face, index, FT_LOAD_DEFAULT) != 0) {
+            return nullptr;
+        }
 
-    GlyphMetrics& gm = m_data->glyphsMetrics[idx];
+        FT_GlyphSlot slot = m_data->face->glyph;
 
-    gm.bbox.setLeft(slot->metrics.horiBearingX);
-    gm.bbox.setTop(-slot->metrics.horiBearingY);
-    gm.bbox.setWidth(slot->metrics.width);
-    gm.bbox.setHeight(slot->metrics.height);
+        gm.bbox.setLeft(slot->metrics.horiBearingX);
+        gm.bbox.setTop(-slot->metrics.horiBearingY);
+        gm.bbox.setWidth(slot->metrics.width);
+        gm.bbox.setHeight(slot->metrics.height);
 
-    gm.linearAdvance = slot->linearHoriAdvance >> 10;
+        gm.linearAdvance = slot->linearHoriAdvance >> 10;
+    }
 
-    return &gm;
+    //! NOTE If another thread has already added it, that one is returned, they are the same
+    std::unique_lock lock(m_cacheMutex);
+    return &m_data->glyphsMetrics.emplace(idx, gm).first->second;
 }
 
 SymbolMetrics* FontFaceFT::symbolMetrics(glyph_idx_t idx) const
 {
-    if (m_data->symbolMetrics.find(idx) != m_data->symbolMetrics.end()) {
-        return &m_data->symbolMetrics.at(idx);
+    {
+        std::shared_lock lock(m_cacheMutex);
+        auto it = m_data->symbolMetrics.find(idx);
+        if (it != m_data->symbolMetrics.end()) {
+            return &it->second;
+        }
     }
 
     FT_UInt index = static_cast<FT_UInt>(idx);
@@ -412,25 +461,30 @@ SymbolMetrics* FontFaceFT::symbolMetrics(glyph_idx_t idx) const
         return nullptr;
     }
 
-    if (FT_Load_Glyph(m_data->face, index, FT_LOAD_DEFAULT) != 0) {
-        return nullptr;
-    }
+    SymbolMetrics sm;
 
-    SymbolMetrics& sm = m_data->symbolMetrics[idx];
+    {
+        std::lock_guard faceLock(m_faceMutex);
+        if (FT_Load_Glyph(m_data->face, index, FT_LOAD_DEFAULT) != 0) {
+            return nullptr;
+        }
 
-    sm.idx = static_cast<glyph_idx_t>(index);
+        sm.idx = static_cast<glyph_idx_t>(index);
 
-    if (FT_Outline_Get_BBox(&m_data->face->glyph->outline, &sm.bbox) != 0) {
-        return nullptr;
-    }
+        if (FT_Outline_Get_BBox(&m_data->face->glyph->outline, &sm.bbox) != 0) {
+            return nullptr;
+        }
 
-    //! NOTE Moved form MUE FontEngineFT::advance
-    //! double advance = linearHoriAdvance * dpi_f / 655360.0;
-    //! -> f26dot6_t advance = linearHoriAdvance * dpi_f * 64.0 / 655360.0;
-    //! -> dpi_f = 5.0 constant
-    //! -> f26dot6_t advance = linearHoriAdvance * 320.0 / 655360.0;
-    //! -> f26dot6_t advance = linearHoriAdvance / 2048;
-    sm.linearAdvance = m_data->face->glyph->linearHoriAdvance / 2048;
+        //! NOTE Moved form MUE FontEngineFT::advance
+        //! double advance = linearHoriAdvance * dpi_f / 655360.0;
+        //! -> f26dot6_t advance = linearHoriAdvance * dpi_f * 64.0 / 655360.0;
+        //! -> dpi_f = 5.0 constant
+        //! -> f26dot6_t advance = linearHoriAdvance * 320.0 / 655360.0;
+        //! -> f26dot6_t advance = linearHoriAdvance / 2048;
+        sm.linearAdvance = m_data->face->glyph->linearHoriAdvance / 2048;
+    }
 
-    return &sm;
+    //! NOTE If another thread has already added it, that one is returned, they are the same
+    std::unique_lock lock(m_cacheMutex);
+    return &m_data->symbolMetrics.emplace(idx, sm).first->second;
 }
@@ -22,6 +22,9 @@
 #ifndef MUSE_DRAW_FONTFACEFT_H
 #define MUSE_DRAW_FONTFACEFT_H
 
+#include <mutex>
+#include <shared_mutex>
+
 #include "ifontface.h"
 
 namespace muse::draw {
@@ -68,6 +71,12 @@ private:
 #ifndef MUSE_MODULE_DRAW_USE_QTTEXTDRAW
     mutable std::unordered_map<glyph_idx_t, msdfgen::Shape> m_cache;
 #endif
+
+    //! NOTE The face is immutable after load, but FreeType and HarfBuzz can't use it
+    //! from several threads at once, so the calls to them are serialized.
+    //! The caches of their results are read concurrently, the entries are never removed
+    mutable std::mutex m_faceMutex;
+    mutable std::shared_mutex m_cacheMutex;
 };
 }
 
@@ -0,0 +1,522 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "fontrendercache.h"
+
+#include <cstring>
+
+#include "global/concurrency/taskscheduler.h"
+
+#include "log.h"
+
+using namespace muse;
+using namespace muse::draw;
+
+static const char DISK_MAGIC[4] = { 'M', 'S', 'D', 'F' };
+static constexpr uint32_t DISK_VERSION = 1;
+
+template<typename T>
+static void writeValue(ByteArray& out, const T& val)
+{
+    out.push_back(reinterpret_cast<const uint8_t*>(&val), sizeof(T));
+}
+
+template<typename T>
+static bool readValue(const ByteArray& in, size_t& pos, T& val)
+{
+    if (pos + sizeof(T) > in.size()) {
+        return false;
+    }
+
+    std::memcpy(&val, in.constData() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+static void writeEntry(ByteArray& out, glyph_idx_t idx, const GlyphImage& image)
+{
+    writeValue(out, idx);
+    writeValue(out, image.rect.x());
+    writeValue(out, image.rect.y());
+    writeValue(out, image.rect.width());
+    writeValue(out, image.rect.height());
+    writeValue(out, image.sdf.width);
+    writeValue(out, image.sdf.height);
+    writeValue(out, image.sdf.threshold);
+    writeValue(out, static_cast<uint64_t>(image.sdf.hash));
+    writeValue(out, static_cast<uint32_t>(image.sdf.bitmap.size()));
+    out.push_back(image.sdf.bitmap.constData(), image.sdf.bitmap.size());
+}
+
+//! NOTE pos must point to the entry after the glyph index
+static bool readEntry(const ByteArray& in, size_t& pos, GlyphImage& image)
+{
+    double x = 0.0;
+    double y = 0.0;
+    double width = 0.0;
+    double height = 0.0;
+    uint64_t hash = 0;
+    uint32_t bitmapSize = 0;
+
+    bool ok = readValue(in, pos, x) && readValue(in, pos, y) && readValue(in, pos, width) && readValue(in, pos, height)
+              && readValue(in, pos, image.sdf.width) && readValue(in, pos, image.sdf.height)
+              && readValue(in, pos, image.sdf.threshold) && readValue(in, pos, hash) && readValue(in, pos, bitmapSize);
+
+    if (!ok || pos + bitmapSize > in.size()) {
+        return false;
+    }
+
+    image.rect = RectF(x, y, width, height);
+    image.sdf.hash = static_cast<size_t>(hash);
+    image.sdf.bitmap = bitmapSize > 0 ? ByteArray(in.constData() + pos, bitmapSize) : ByteArray();
+    pos += bitmapSize;
+
+    return true;
+}
+
+size_t FontRenderCache::CacheKeyHash::operator()(const CacheKey& k) const
+{
+    size_t h = std::hash<FaceKey> {}(k.faceKey);
+    h ^= k.glyphIdx + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+FontRenderCache::~FontRenderCache()
+{
+    waitDiskWrite();
+}
+
+void FontRenderCache::init(const io::path_t& diskCacheDir, size_t capacity, size_t maxPending)
+{
+    std::lock_guard lock(m_mutex);
+
+    m_diskCacheDir = diskCacheDir;
+    m_capacity = std::max(capacity, size_t(1));
+    m_maxPending = std::max(maxPending, size_t(1));
+}
+
+void FontRenderCache::registerFace(const FaceKey& key, const io::path_t& fontPath)
+{
+    std::lock_guard lock(m_mutex);
+
+    if (m_diskCacheDir.empty()) {
+        return;
+    }
+
+    DiskFace& face = m_diskFaces[key];
+    face.fontPath = fontPath;
+}
+
+bool FontRenderCache::load(const FaceKey& key, glyph_idx_t idx, GlyphImage& out)
+{
+    std::lock_guard lock(m_mutex);
+
+    CacheKey cacheKey { key, idx };
+
+    auto it = m_index.find(cacheKey);
+    if (it != m_index.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        out = it->second->second;
+        ++m_stats.hits;
+        return true;
+    }
+
+    if (loadFromDisk(key, idx, out)) {
+        putToMemory(cacheKey, out);
+        ++m_stats.diskHits;
+        return true;
+    }
+
+    ++m_stats.misses;
+    return false;
+}
+
+void FontRenderCache::store(const FaceKey& key, glyph_idx_t idx, const GlyphImage& image)
+{
+    std::lock_guard lock(m_mutex);
+
+    putToMemory(CacheKey { key, idx }, image);
+
+    DiskFace* face = diskFace(key);
+    if (!face) {
+        return;
+    }
+
+    if (!face->loaded) {
+        loadDiskFace(key, *face);
+    }
+
+    if (face->offsets.find(idx) != face->offsets.end() || face->writing.find(idx) != face->writing.end()) {
+        return;
+    }
+
+    if (face->pending.insert_or_assign(idx, image).second) {
+        ++m_pendingCount;
+    }
+
+    //! NOTE The render thread doesn't wait for the disk; while a write is running, the new images keep waiting
+    std::vector<DiskWrite> writes;
+    if (m_pendingCount >= m_maxPending && beginDiskWrite(writes)) {
+        auto writesPtr = std::make_shared<std::vector<DiskWrite> >(std::move(writes));
+        TaskScheduler::workerPool()->push([this, writesPtr]() {
+            writeDiskFaces(*writesPtr);
+        });
+    }
+}
+
+void FontRenderCache::flush()
+{
+    std::vector<DiskWrite> writes;
+
+    {
+        std::unique_lock lock(m_mutex);
+        m_diskWriteFinished.wait(lock, [this]() {
+            return !m_isDiskWriting;
+        });
+
+        if (!beginDiskWrite(writes)) {
+            return;
+        }
+    }
+
+    writeDiskFaces(writes);
+}
+
+void FontRenderCache::clear()
+{
+    std::lock_guard lock(m_mutex);
+
+    m_lru.clear();
+    m_index.clear();
+
+    for (auto& pair : m_diskFaces) {
+        DiskFace& face = pair.second;
+        face.loaded = false;
+        face.data = ByteArray();
+        face.offsets.clear();
+        face.pending.clear();
+        face.writing.clear();
+    }
+
+    //! NOTE The running write doesn't update the faces anymore
+    ++m_diskGeneration;
+
+    m_pendingCount = 0;
+    m_stats = Stats();
+}
+
+FontRenderCache::Stats FontRenderCache::stats() const
+{
+    std::lock_guard lock(m_mutex);
+
+    Stats result = m_stats;
+    result.size = m_lru.size();
+    result.pending = m_pendingCount;
+    return result;
+}
+
+void FontRenderCache::putToMemory(const CacheKey& key, const GlyphImage& image)
+{
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        it->second->second = image;
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return;
+    }
+
+    m_lru.emplace_front(key, image);
+    m_index.emplace(key, m_lru.begin());
+
+    while (m_lru.size() > m_capacity) {
+        m_index.erase(m_lru.back().first);
+        m_lru.pop_back();
+        ++m_stats.evictions;
+    }
+}
+
+FontRenderCache::DiskFace* FontRenderCache::diskFace(const FaceKey& key)
+{
+    if (m_diskCacheDir.empty()) {
+        return nullptr;
+    }
+
+    auto it = m_diskFaces.find(key);
+    return it != m_diskFaces.end() ? &it->second : nullptr;
+}
+
+bool FontRenderCache::loadFromDisk(const FaceKey& key, glyph_idx_t idx, GlyphImage& out)
+{
+    DiskFace* face = diskFace(key);
+    if (!face) {
+        return false;
+    }
+
+    if (!face->loaded) {
+        loadDiskFace(key, *face);
+    }
+
+    auto pending = face->pending.find(idx);
+    if (pending != face->pending.end()) {
+        out = pending->second;
+        return true;
+    }
+
+    auto writing = face->writing.find(idx);
+    if (writing != face->writing.end()) {
+        out = writing->second;
+        return true;
+    }
+
+    auto offset = face->offsets.find(idx);
+    if (offset == face->offsets.end()) {
+        return false;
+    }
+
+    size_t pos = offset->second;
+    return readEntry(face->data, pos, out);
+}
+
+void FontRenderCache::loadDiskFace(const FaceKey& key, DiskFace& face)
+{
+    TRACEFUNC;
+
+    face.loaded = true;
+    face.stamp = fontStamp(face.fontPath);
+
+    io::path_t path = diskFacePath(key, face.fontPath);
+    if (!fileSystem()->exists(path)) {
+        return;
+    }
+
+    RetVal<ByteArray> data = fileSystem()->readFile(path);
+    if (!data.ret) {
+        LOGW() << "failed read glyph cache: " << path << ", err: " << data.ret.toString();
+        return;
+    }
+
+    face.data = data.val;
+    indexDiskFace(face);
+}
+
+void FontRenderCache::indexDiskFace(DiskFace& face) const
+{
+    face.offsets.clear();
+    face.entriesBegin = 0;
+    face.entriesEnd = 0;
+    face.entriesCount = 0;
+
+    const ByteArray& data = face.data;
+    size_t pos = 0;
+
+    char magic[4] = {};
+    uint32_t version = 0;
+    uint32_t stampSize = 0;
+
+    bool ok = readValue(data, pos, magic) && readValue(data, pos, version) && readValue(data, pos, stampSize);
+    if (!ok || std::memcmp(magic, DISK_MAGIC, sizeof(DISK_MAGIC)) != 0 || version != DISK_VERSION) {
+        face.data = ByteArray();
+        return;
+    }
+
+    if (pos + stampSize > data.size()
+        || std::string(data.constChar() + pos, stampSize) != face.stamp) {
+        //! NOTE The font has changed, the cached images are not valid anymore
+        face.data = ByteArray();
+        return;
+    }
+    pos += stampSize;
+
+    uint32_t count = 0;
+    if (!readValue(data, pos, count)) {
+        face.data = ByteArray();
+        return;
+    }
+
+    face.entriesBegin = pos;
+    face.entriesEnd = pos;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        glyph_idx_t idx = 0;
+        if (!readValue(data, pos, idx)) {
+            break;
+        }
+
+        size_t entryPos = pos;
+        GlyphImage image;
+        if (!readEntry(data, pos, image)) {
+            LOGW() << "glyph cache is corrupted";
+            break;
+        }
+
+        face.offsets.emplace(idx, entryPos);
+        face.entriesEnd = pos;
+        ++face.entriesCount;
+    }
+}
+
+//! NOTE Called with the mutex locked; the images are moved to the writing ones, so they can still be loaded
+bool FontRenderCache::beginDiskWrite(std::vector<DiskWrite>& writes)
+{
+    if (m_isDiskWriting || m_pendingCount == 0) {
+        return false;
+    }
+
+    for (auto& pair : m_diskFaces) {
+        DiskFace& face = pair.second;
+        if (face.pending.empty()) {
+            continue;
+        }
+
+        DiskWrite write;
+        write.key = pair.first;
+        write.path = diskFacePath(pair.first, face.fontPath);
+        write.stamp = face.stamp;
+        write.data = face.data;
+        write.entriesBegin = face.entriesBegin;
+        write.entriesEnd = face.entriesEnd;
+        write.entriesCount = face.entriesCount;
+        write.images = std::move(face.pending);
+        write.generation = m_diskGeneration;
+
+        face.pending.clear();
+        face.writing.insert(write.images.begin(), write.images.end());
+
+        writes.push_back(std::move(write));
+    }
+
+    m_pendingCount = 0;
+    m_isDiskWriting = true;
+
+    return true;
+}
+
+//! NOTE Called without the mutex, only one write runs at a time
+void FontRenderCache::writeDiskFaces(std::vector<DiskWrite>& writes)
+{
+    TRACEFUNC;
+
+    for (DiskWrite& write : writes) {
+        //! NOTE The current entries are copied as they are, only the new images are serialized
+        DiskFace written;
+        written.stamp = write.stamp;
+
+        ByteArray& out = written.data;
+        out.push_back(reinterpret_cast<const uint8_t*>(DISK_MAGIC), sizeof(DISK_MAGIC));
+        writeValue(out, DISK_VERSION);
+        writeValue(out, static_cast<uint32_t>(write.stamp.size()));
+        out.push_back(reinterpret_cast<const uint8_t*>(write.stamp.data()), write.stamp.size());
+        writeValue(out, static_cast<uint32_t>(write.entriesCount + write.images.size()));
+
+        if (write.entriesEnd > write.entriesBegin) {
+            out.push_back(write.data.constData() + write.entriesBegin, write.entriesEnd - write.entriesBegin);
+        }
+
+        for (const auto& pair : write.images) {
+            writeEntry(out, pair.first, pair.second);
+        }
+
+        fileSystem()->makePath(io::dirpath(write.path));
+
+        Ret ret = fileSystem()->writeFile(write.path, out);
+        if (ret) {
+            indexDiskFace(written);
+        } else {
+            LOGW() << "failed write glyph cache: " << write.path << ", err: " << ret.toString();
+        }
+
+        std::lock_guard lock(m_mutex);
+
+        DiskFace* face = diskFace(write.key);
+        if (!face || write.generation != m_diskGeneration) {
+            continue;
+        }
+
+        //! NOTE The images, which failed to be written, are dropped, they are still in the memory tier
+        for (const auto& pair : write.images) {
+            face->writing.erase(pair.first);
+        }
+
+        if (!ret) {
+            continue;
+        }
+
+        face->data = written.data;
+        face->entriesBegin = written.entriesBegin;
+        face->entriesEnd = written.entriesEnd;
+        face->entriesCount = written.entriesCount;
+        face->offsets = std::move(written.offsets);
+
+        ++m_stats.diskWrites;
+    }
+
+    std::lock_guard lock(m_mutex);
+    m_isDiskWriting = false;
+    m_diskWriteFinished.notify_all();
+}
+
+void FontRenderCache::waitDiskWrite()
+{
+    std::unique_lock lock(m_mutex);
+    m_diskWriteFinished.wait(lock, [this]() {
+        return !m_isDiskWriting;
+    });
+}
+
+io::path_t FontRenderCache::diskFacePath(const FaceKey& key, const io::path_t& fontPath) const
+{
+    //! NOTE The file is named after the whole face key and the font file,
+    //! so the faces, whose names differ only in the characters not allowed in a file name, don't share it
+    ByteArray id;
+    const std::string& family = key.dataKey.family();
+    writeValue(id, static_cast<uint32_t>(family.size()));
+    id.push_back(reinterpret_cast<const uint8_t*>(family.data()), family.size());
+    writeValue(id, static_cast<uint8_t>(key.dataKey.bold()));
+    writeValue(id, static_cast<uint8_t>(key.dataKey.italic()));
+    writeValue(id, static_cast<int32_t>(key.type));
+    writeValue(id, static_cast<int32_t>(key.pixelSize));
+    const std::string path = fontPath.toStdString();
+    id.push_back(reinterpret_cast<const uint8_t*>(path.data()), path.size());
+
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+
+    ByteArray hash = cryptographicHash()->hash(id, ICryptographicHash::Algorithm::Md4);
+
+    std::string name;
+    name.reserve(hash.size() * 2);
+    for (size_t i = 0; i < hash.size(); ++i) {
+        name += HEX_DIGITS[hash.at(i) >> 4];
+        name += HEX_DIGITS[hash.at(i) & 0x0f];
+    }
+
+    return m_diskCacheDir + "/" + name + ".sdfcache";
+}
+
+std::string FontRenderCache::fontStamp(const io::path_t& fontPath) const
+{
+    if (fontPath.empty()) {
+        return std::string();
+    }
+
+    RetVal<uint64_t> size = fileSystem()->fileSize(fontPath);
+    DateTime modified = fileSystem()->lastModified(fontPath);
+
+    return std::to_string(size.val) + "_" + modified.toString().toStdString();
+}
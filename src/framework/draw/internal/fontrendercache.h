@@ -0,0 +1,153 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_DRAW_FONTRENDERCACHE_H
+#define MUSE_DRAW_FONTRENDERCACHE_H
+
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "global/modularity/ioc.h"
+#include "global/io/ifilesystem.h"
+#include "global/icryptographichash.h"
+
+#include "types/fontstypes.h"
+
+namespace muse::draw {
+//! NOTE Cache of generated glyph images (SDF).
+//! The memory tier is a LRU of a limited size, the optional disk tier keeps
+//! the images of each face in a separate file, so warm starts skip the generation.
+//! The new images wait for the disk in memory; once there are too many of them, they are written out on a worker.
+class FontRenderCache
+{
+    GlobalInject<io::IFileSystem> fileSystem;
+    GlobalInject<ICryptographicHash> cryptographicHash;
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+    static constexpr size_t DEFAULT_MAX_PENDING = 1024;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t diskHits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t diskWrites = 0;
+        size_t size = 0;
+        size_t pending = 0;
+    };
+
+    ~FontRenderCache();
+
+    //! diskCacheDir - if empty, the disk tier is disabled
+    //! maxPending - how many new images are kept for the disk tier before they are written out
+    void init(const io::path_t& diskCacheDir = io::path_t(), size_t capacity = DEFAULT_CAPACITY,
+              size_t maxPending = DEFAULT_MAX_PENDING);
+
+    //! The font file is used to invalidate the disk tier, when the font has changed
+    void registerFace(const FaceKey& key, const io::path_t& fontPath);
+
+    bool load(const FaceKey& key, glyph_idx_t idx, GlyphImage& out);
+    void store(const FaceKey& key, glyph_idx_t idx, const GlyphImage& image);
+
+    //! Writes the new images to the disk tier and waits until they are written
+    void flush();
+    void clear();
+
+    Stats stats() const;
+
+private:
+    struct CacheKey {
+        FaceKey faceKey;
+        glyph_idx_t glyphIdx = 0;
+
+        bool operator==(const CacheKey& o) const { return glyphIdx == o.glyphIdx && faceKey == o.faceKey; }
+    };
+
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey& k) const;
+    };
+
+    using LruList = std::list<std::pair<CacheKey, GlyphImage> >;
+
+    struct DiskFace {
+        io::path_t fontPath;
+        std::string stamp;
+        bool loaded = false;
+        ByteArray data;
+        size_t entriesBegin = 0;
+        size_t entriesEnd = 0;
+        uint32_t entriesCount = 0;
+        std::unordered_map<glyph_idx_t, size_t> offsets;
+        std::map<glyph_idx_t, GlyphImage> pending;
+        std::map<glyph_idx_t, GlyphImage> writing;
+    };
+
+    //! NOTE The new file of a face: the entries of the current one followed by the new images
+    struct DiskWrite {
+        FaceKey key;
+        io::path_t path;
+        std::string stamp;
+        ByteArray data;
+        size_t entriesBegin = 0;
+        size_t entriesEnd = 0;
+        uint32_t entriesCount = 0;
+        std::map<glyph_idx_t, GlyphImage> images;
+        uint64_t generation = 0;
+    };
+
+    void putToMemory(const CacheKey& key, const GlyphImage& image);
+
+    DiskFace* diskFace(const FaceKey& key);
+    bool loadFromDisk(const FaceKey& key, glyph_idx_t idx, GlyphImage& out);
+    void loadDiskFace(const FaceKey& key, DiskFace& face);
+    void indexDiskFace(DiskFace& face) const;
+
+    bool beginDiskWrite(std::vector<DiskWrite>& writes);
+    void writeDiskFaces(std::vector<DiskWrite>& writes);
+    void waitDiskWrite();
+
+    io::path_t diskFacePath(const FaceKey& key, const io::path_t& fontPath) const;
+    std::string fontStamp(const io::path_t& fontPath) const;
+
+    mutable std::mutex m_mutex;
+
+    size_t m_capacity = DEFAULT_CAPACITY;
+    LruList m_lru;
+    std::unordered_map<CacheKey, LruList::iterator, CacheKeyHash> m_index;
+
+    io::path_t m_diskCacheDir;
+    std::map<FaceKey, DiskFace> m_diskFaces;
+    size_t m_maxPending = DEFAULT_MAX_PENDING;
+    size_t m_pendingCount = 0;
+    bool m_isDiskWriting = false;
+    std::condition_variable m_diskWriteFinished;
+    uint64_t m_diskGeneration = 0;
+
+    Stats m_stats;
+};
+}
+
+#endif // MUSE_DRAW_FONTRENDERCACHE_H
@@ -21,12 +21,15 @@
  */
 #include "fontsengine.h"
 
+#include <sstream>
+
 #ifndef MUSE_MODULE_DRAW_USE_QTTEXTDRAW
 #include <msdfgen.h>
 #include <ext/import-font.h>
 #endif
 
 #include "global/io/fileinfo.h"
+#include "global/profiler.h"
 
 #include "ifontface.h"
 #include "fontfaceft.h"
@@ -74,6 +77,13 @@ bool FontsEngine::RequireFace::isSymbolMode() const
     return face ? face->isSymbolMode() : false;
 }
 
+size_t FontsEngine::RequireFaceKeyHash::operator()(const RequireFaceKey& k) const
+{
+    size_t h = std::hash<FaceKey> {}(k.faceKey);
+    h ^= static_cast<size_t>(k.isSymbolMode) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
 double FontsEngine::RequireFace::pixelScale() const
 {
     if (!face) {
@@ -85,8 +95,8 @@ double FontsEngine::RequireFace::pixelScale() const
 
 FontsEngine::~FontsEngine()
 {
-    for (RequireFace* f : m_requiredFaces) {
-        delete f;
+    for (auto& pair : m_requiredFaces) {
+        delete pair.second;
     }
 
     for (IFontFace* f : m_loadedFaces) {
@@ -94,9 +104,38 @@ FontsEngine::~FontsEngine()
     }
 }
 
-void FontsEngine::init()
+void FontsEngine::init(const io::path_t& renderCacheDir)
+{
+    m_renderCache.init(renderCacheDir);
+    m_textRunCache.init();
+}
+
+void FontsEngine::deinit()
+{
+    m_renderCache.flush();
+
+    FontRenderCache::Stats stats = m_renderCache.stats();
+    LOGI() << "glyph render cache, hits: " << stats.hits << ", disk hits: " << stats.diskHits
+           << ", misses: " << stats.misses << ", evictions: " << stats.evictions;
+
+    TextRunCache::Stats runStats = textRunCacheStats();
+    uint64_t requests = runStats.hits + runStats.misses;
+    double hitRate = requests > 0 ? static_cast<double>(runStats.hits) / static_cast<double>(requests) : 0.0;
+
+    std::stringstream runStream;
+    runStream << "text run cache, hits: " << runStats.hits << ", misses: " << runStats.misses
+              << ", hit rate: " << hitRate * 100.0 << "%, evictions: " << runStats.evictions << ", runs: " << runStats.size;
+    muse::profiler::Profiler::print(runStream.str());
+}
+
+FontRenderCache::Stats FontsEngine::renderCacheStats() const
+{
+    return m_renderCache.stats();
+}
+
+TextRunCache::Stats FontsEngine::textRunCacheStats() const
 {
-    //m_renderCache.init();
+    return m_textRunCache.stats();
 }
 
 double FontsEngine::lineSpacing(const Font& f) const
@@ -181,10 +220,10 @@ double FontsEngine::horizontalAdvance(const Font& f, const std::u32string& text)
         return 0.0;
     }
 
-    std::vector<GlyphPos> glyphs = rf->face->glyphs(&text[0], (int)text.size());
     f26dot6_t advance = 0;
-    for (const GlyphPos& g : glyphs) {
-        advance += g.x_advance;
+    if (!m_textRunCache.load(rf->id, text, &TextRunCache::Run::advance, advance)) {
+        advance = textAdvance(rf, text);
+        m_textRunCache.store(rf->id, text, &TextRunCache::Run::advance, advance);
     }
 
     return from_f26d6(advance) * rf->pixelScale();
@@ -212,51 +251,10 @@ RectF FontsEngine::boundingRect(const Font& f, const std::u32string& text) const
         return RectF();
     }
 
-    FBBox rect;      // f26dot6_t units
-    FBBox lineRect;  // f26dot6_t units
-    bool isFirstLine = true;
-    bool isFirstInLine = true;
-
-    std::vector<TextBlock> lines = splitTextByLines(text);
-    for (const TextBlock& l : lines) {
-        lineRect = FBBox();
-        isFirstInLine = true;
-
-        std::vector<TextBlock> fontFaceBlocks = splitTextByFontFaces(rf, l);
-        for (const TextBlock& ffBlock : fontFaceBlocks) {
-            const IFontFace* fontFace = nullptr;
-            if (rf->face->glyphIndex(*ffBlock.text) != 0) {
-                fontFace = rf->face;
-            } else {
-                fontFace = findSubtitutionFont(*ffBlock.text, rf->subtitutionFaces);
-            }
-            if (!fontFace) {
-                continue;
-            }
-
-            std::vector<GlyphPos> glyphs = fontFace->glyphs(ffBlock.text, ffBlock.lenght);
-
-            for (const GlyphPos& g : glyphs) {
-                FBBox bbox = rf->face->glyphBbox(g.idx);
-                if (isFirstInLine) {
-                    lineRect = bbox;
-                    isFirstInLine = false;
-                } else {
-                    lineRect.setWidth(lineRect.width() + bbox.width());
-                    lineRect.setHeight(std::max(lineRect.height(), bbox.height()));
-                    lineRect.setTop(std::min(lineRect.top(), bbox.top()));
-                    lineRect.setLeft(std::min(lineRect.left(), bbox.left()));
-                }
-            }
-        }
-
-        if (isFirstLine) {
-            rect = lineRect;
-            isFirstLine = false;
-        } else {
-            rect.setWidth(std::max(rect.width(), lineRect.width()));
-            rect.setHeight(rect.height() + lineRect.height());
-        }
+    FBBox rect;
+    if (!m_textRunCache.load(rf->id, text, &TextRunCache::Run::boundingRect, rect)) {
+        rect = textBoundingRect(rf, text);
+        m_textRunCache.store(rf->id, text, &TextRunCache::Run::boundingRect, rect);
     }
 
     return fromFBBox(rect, rf->pixelScale());
@@ -273,59 +271,10 @@ RectF FontsEngine::tightBoundingRect(const Font& f, const std::u32string& text)
         return RectF();
     }
 
-    FBBox rect;      // f26dot6_t units
-    FBBox lineRect;  // f26dot6_t units
-    bool isFirstLine = true;
-    bool isFirstInLine = true;
-
-    std::vector<TextBlock> lines = splitTextByLines(text);
-    for (const TextBlock& l : lines) {
-        lineRect = FBBox();
-        isFirstInLine = true;
-        f26dot6_t advance = 0;
-
-        std::vector<TextBlock> fontFaceBlocks = splitTextByFontFaces(rf, l);
-
-        GlyphPos lastGlyph;
-        for (const TextBlock& ffBlock : fontFaceBlocks) {
-            const IFontFace* fontFace = nullptr;
-            if (rf->face->glyphIndex(*ffBlock.text) != 0) {
-                fontFace = rf->face;
-            } else {
-                fontFace = findSubtitutionFont(*ffBlock.text, rf->subtitutionFaces);
-            }
-            if (!fontFace) {
-                continue;
-            }
-
-            std::vector<GlyphPos> glyphs = fontFace->glyphs(ffBlock.text, ffBlock.lenght);
-
-            for (const GlyphPos& g : glyphs) {
-                FBBox bbox = rf->face->glyphBbox(g.idx);
-                if (isFirstInLine) {
-                    lineRect = bbox;
-                    isFirstInLine = false;
-                } else {
-                    /// width is calculated as x_advance instead
-                    lineRect.setTop(std::min(lineRect.top(), bbox.top()));
-                    lineRect.setLeft(std::min(lineRect.left(), bbox.left()));
-                    lineRect.setBottom(std::max(lineRect.bottom(), bbox.bottom()));
-                }
-                advance += g.x_advance;
-            }
-            lastGlyph = glyphs.back();
-        }
-
-        advance -= (lastGlyph.x_advance - rf->face->glyphBbox(lastGlyph.idx).width());
-        lineRect.setWidth(advance);
-
-        if (isFirstLine) {
-            rect = lineRect;
-            isFirstLine = false;
-        } else {
-            rect.setWidth(std::max(rect.width(), lineRect.width()));
-            rect.setHeight(rect.height() + lineRect.height());
-        }
+    FBBox rect;
+    if (!m_textRunCache.load(rf->id, text, &TextRunCache::Run::tightBoundingRect, rect)) {
+        rect = textTightBoundingRect(rf, text);
+        m_textRunCache.store(rf->id, text, &TextRunCache::Run::tightBoundingRect, rect);
     }
 
     return fromFBBox(rect, rf->pixelScale());
@@ -462,10 +411,10 @@ std::vector<GlyphImage> FontsEngine::render(const Font& f, const std::u32string&
 
             for (const GlyphPos& g : glyphs) {
                 if (NOT_RENDER_GLYPHS.find(g.idx) == NOT_RENDER_GLYPHS.end()) {
-                    GlyphImage image;// = m_renderCache.load(fontFace->key(), g.idx);
-                    if (image.isNull()) {
+                    GlyphImage image;
+                    if (!m_renderCache.load(fontFace->key(), g.idx, image)) {
                         generateSdf(image, g.idx, fontFace);
-                        //m_renderCache.store(fontFace->key(), g.idx, image);
+                        m_renderCache.store(fontFace->key(), g.idx, image);
                     }
 
                     image.rect = scaleRect(image.rect, pixelScale);
@@ -529,14 +478,26 @@ FontsEngine::RequireFace* FontsEngine::fontFace(const Font& f, bool isSymbolMode
     }
 
     //! NOTE We are looking for the require font we need among the previously loaded ones
-    for (RequireFace* face : m_requiredFaces) {
-        if (face->requireKey == requireKey && face->isSymbolMode() == isSymbolMode) {
-            return face;
+    RequireFaceKey requireFaceKey { requireKey, isSymbolMode };
+    {
+        std::shared_lock lock(m_facesMutex);
+        auto it = m_requiredFaces.find(requireFaceKey);
+        if (it != m_requiredFaces.end()) {
+            return it->second;
         }
     }
 
+    std::unique_lock lock(m_facesMutex);
+
+    //! NOTE It may have been created by another thread in the meantime
+    auto it = m_requiredFaces.find(requireFaceKey);
+    if (it != m_requiredFaces.end()) {
+        return it->second;
+    }
+
     //! If we didn't find it, we create a new require font
     RequireFace* newFont = new RequireFace();
+    newFont->id = m_requiredFaces.size();
     newFont->requireKey = requireKey;
 
     //! Let's find out which real font will be used
@@ -569,6 +530,7 @@ FontsEngine::RequireFace* FontsEngine::fontFace(const Font& f, bool isSymbolMode
 
         face->load(loadedKey, fontPath, isSymbolMode);
         m_loadedFaces.push_back(face);
+        m_renderCache.registerFace(loadedKey, fontPath);
     }
 
     newFont->face = face;
@@ -598,15 +560,139 @@ FontsEngine::RequireFace* FontsEngine::fontFace(const Font& f, bool isSymbolMode
 
             subtitutionFace->load(loadedKey, fontPath, isSymbolMode);
             m_loadedFaces.push_back(subtitutionFace);
+            m_renderCache.registerFace(loadedKey, fontPath);
         }
         newFont->subtitutionFaces.push_back(subtitutionFace);
     }
 
-    m_requiredFaces.push_back(newFont);
+    m_requiredFaces.emplace(requireFaceKey, newFont);
 
     return newFont;
 }
 
+f26dot6_t FontsEngine::textAdvance(const RequireFace* rf, const std::u32string& text) const
+{
+    std::vector<GlyphPos> glyphs = rf->face->glyphs(&text[0], (int)text.size());
+    f26dot6_t advance = 0;
+    for (const GlyphPos& g : glyphs) {
+        advance += g.x_advance;
+    }
+
+    return advance;
+}
+
+FBBox FontsEngine::textBoundingRect(const RequireFace* rf, const std::u32string& text) const
+{
+    FBBox rect;      // f26dot6_t units
+    FBBox lineRect;  // f26dot6_t units
+    bool isFirstLine = true;
+    bool isFirstInLine = true;
+
+    std::vector<TextBlock> lines = splitTextByLines(text);
+    for (const TextBlock& l : lines) {
+        lineRect = FBBox();
+        isFirstInLine = true;
+
+        std::vector<TextBlock> fontFaceBlocks = splitTextByFontFaces(rf, l);
+        for (const TextBlock& ffBlock : fontFaceBlocks) {
+            const IFontFace* fontFace = nullptr;
+            if (rf->face->glyphIndex(*ffBlock.text) != 0) {
+                fontFace = rf->face;
+            } else {
+                fontFace = findSubtitutionFont(*ffBlock.text, rf->subtitutionFaces);
+            }
+            if (!fontFace) {
+                continue;
+            }
+
+            std::vector<GlyphPos> glyphs = fontFace->glyphs(ffBlock.text, ffBlock.lenght);
+
+            for (const GlyphPos& g : glyphs) {
+                FBBox bbox = rf->face->glyphBbox(g.idx);
+                if (isFirstInLine) {
+                    lineRect = bbox;
+                    isFirstInLine = false;
+                } else {
+                    lineRect.setWidth(lineRect.width() + bbox.width());
+                    lineRect.setHeight(std::max(lineRect.height(), bbox.height()));
+                    lineRect.setTop(std::min(lineRect.top(), bbox.top()));
+                    lineRect.setLeft(std::min(lineRect.left(), bbox.left()));
+                }
+            }
+        }
+
+        if (isFirstLine) {
+            rect = lineRect;
+            isFirstLine = false;
+        } else {
+            rect.setWidth(std::max(rect.width(), lineRect.width()));
+            rect.setHeight(rect.height() + lineRect.height());
+        }
+    }
+
+    return rect;
+}
+
+FBBox FontsEngine::textTightBoundingRect(const RequireFace* rf, const std::u32string& text) const
+{
+    FBBox rect;      // f26dot6_t units
+    FBBox lineRect;  // f26dot6_t units
+    bool isFirstLine = true;
+    bool isFirstInLine = true;
+
+    std::vector<TextBlock> lines = splitTextByLines(text);
+    for (const TextBlock& l : lines) {
+        lineRect = FBBox();
+        isFirstInLine = true;
+        f26dot6_t advance = 0;
+
+        std::vector<TextBlock> fontFaceBlocks = splitTextByFontFaces(rf, l);
+
+        GlyphPos lastGlyph;
+        for (const TextBlock& ffBlock : fontFaceBlocks) {
+            const IFontFace* fontFace = nullptr;
+            if (rf->face->glyphIndex(*ffBlock.text) != 0) {
+                fontFace = rf->face;
+            } else {
+                fontFace = findSubtitutionFont(*ffBlock.text, rf->subtitutionFaces);
+            }
+            if (!fontFace) {
+                continue;
+            }
+
+            std::vector<GlyphPos> glyphs = fontFace->glyphs(ffBlock.text, ffBlock.lenght);
+
+            for (const GlyphPos& g : glyphs) {
+                FBBox bbox = rf->face->glyphBbox(g.idx);
+                if (isFirstInLine) {
+                    lineRect = bbox;
+                    isFirstInLine = false;
+                } else {
+                    /// width is calculated as x_advance instead
+                    lineRect.setTop(std::min(lineRect.top(), bbox.top()));
+                    lineRect.setLeft(std::min(lineRect.left(), bbox.left()));
+                    lineRect.setBottom(std::max(lineRect.bottom(), bbox.bottom()));
+                }
+                advance += g.x_advance;
+            }
+            lastGlyph = glyphs.back();
+        }
+
+        advance -= (lastGlyph.x_advance - rf->face->glyphBbox(lastGlyph.idx).width());
+        lineRect.setWidth(advance);
+
+        if (isFirstLine) {
+            rect = lineRect;
+            isFirstLine = false;
+        } else {
+            rect.setWidth(std::max(rect.width(), lineRect.width()));
+            rect.setHeight(rect.height() + lineRect.height());
+        }
+    }
+
+    return rect;
+}
+
 std::vector<FontsEngine::TextBlock> FontsEngine::splitTextByLines(const std::u32string& text) const
 {
     std::vector<TextBlock> lines;
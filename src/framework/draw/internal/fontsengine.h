@@ -24,13 +24,16 @@
 
 #include <vector>
 #include <functional>
+#include <shared_mutex>
+#include <unordered_map>
 
 #include "ifontsengine.h"
 
 #include "global/modularity/ioc.h"
 #include "ifontsdatabase.h"
 
-//#include "fontrendercache.h"
+#include "fontrendercache.h"
+#include "textruncache.h"
 
 namespace muse::draw {
 class IFontFace;
@@ -42,7 +45,9 @@ public:
     FontsEngine() = default;
     ~FontsEngine();
 
-    void init();
+    //! renderCacheDir - directory for the disk tier of the glyph render cache (empty - memory only)
+    void init(const io::path_t& renderCacheDir = io::path_t());
+    void deinit();
 
     double lineSpacing(const Font& f) const override;
     double xHeight(const Font& f) const override;
@@ -66,7 +71,11 @@ public:
     // For draw
     std::vector<GlyphImage> render(const Font& f, const std::u32string& text) const override;
 
+    FontRenderCache::Stats renderCacheStats() const;
+    TextRunCache::Stats textRunCacheStats() const;
+
     // For dev
+    //! NOTE Must be set before the fonts are used
     using FontFaceFactory = std::function<IFontFace* (const io::path_t&)>;
     void setFontFaceFactory(const FontFaceFactory& f);
 
@@ -78,6 +87,7 @@ private:
     };
 
     struct RequireFace {
+        size_t id = 0;               // key of the text runs in the cache
         IFontFace* face = nullptr;   // real loaded face
         std::vector<IFontFace*> subtitutionFaces;
         FaceKey requireKey;          // require face
@@ -86,18 +96,38 @@ private:
         double pixelScale() const;
     };
 
+    struct RequireFaceKey {
+        FaceKey faceKey;
+        bool isSymbolMode = false;
+
+        bool operator==(const RequireFaceKey& o) const { return isSymbolMode == o.isSymbolMode && faceKey == o.faceKey; }
+    };
+
+    struct RequireFaceKeyHash {
+        size_t operator()(const RequireFaceKey& k) const;
+    };
+
     IFontFace* createFontFace(const io::path_t& path) const;
     RequireFace* fontFace(const Font& f, bool isSymbolMode = false) const;
 
+    // Measurements of the shaped text in the units of the face, see TextRunCache
+    f26dot6_t textAdvance(const RequireFace* rf, const std::u32string& text) const;
+    FBBox textBoundingRect(const RequireFace* rf, const std::u32string& text) const;
+    FBBox textTightBoundingRect(const RequireFace* rf, const std::u32string& text) const;
+
     std::vector<TextBlock> splitTextByLines(const std::u32string& text) const;
     std::vector<TextBlock> splitTextByFontFaces(const RequireFace* rf, const TextBlock& text) const;
 
     FontFaceFactory m_fontFaceFactory;
 
+    //! NOTE The faces are created on the first request and never changed or removed after that,
+    //! so the lookups can run concurrently, only creating a face is exclusive
+    mutable std::shared_mutex m_facesMutex;
     mutable std::vector<IFontFace*> m_loadedFaces;
-    mutable std::vector<RequireFace*> m_requiredFaces;
+    mutable std::unordered_map<RequireFaceKey, RequireFace*, RequireFaceKeyHash> m_requiredFaces;
 
-    //mutable FontRenderCache m_renderCache;
+    mutable FontRenderCache m_renderCache;
+    mutable TextRunCache m_textRunCache;
 };
 }
 
@@ -0,0 +1,89 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "textruncache.h"
+
+#include <algorithm>
+
+using namespace muse;
+using namespace muse::draw;
+
+size_t TextRunCache::IndexKeyHash::operator()(const IndexKey& k) const
+{
+    size_t h = std::hash<std::u32string_view> {}(k.text);
+    h ^= k.faceId + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+void TextRunCache::init(size_t capacity)
+{
+    std::lock_guard lock(m_mutex);
+
+    m_capacity = std::max(capacity, size_t(1));
+}
+
+void TextRunCache::clear()
+{
+    std::lock_guard lock(m_mutex);
+
+    m_lru.clear();
+    m_index.clear();
+    m_stats = Stats();
+}
+
+TextRunCache::Stats TextRunCache::stats() const
+{
+    std::lock_guard lock(m_mutex);
+
+    Stats result = m_stats;
+    result.size = m_lru.size();
+    return result;
+}
+
+TextRunCache::Run* TextRunCache::find(size_t faceId, const std::u32string& text)
+{
+    auto it = m_index.find(IndexKey { faceId, text });
+    if (it == m_index.end()) {
+        return nullptr;
+    }
+
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return &it->second->second;
+}
+
+TextRunCache::Run& TextRunCache::findOrInsert(size_t faceId, const std::u32string& text)
+{
+    if (Run* run = find(faceId, text)) {
+        return *run;
+    }
+
+    m_lru.emplace_front(RunKey { faceId, text }, Run());
+    m_index.emplace(IndexKey { faceId, m_lru.front().first.text }, m_lru.begin());
+
+    while (m_lru.size() > m_capacity) {
+        const RunKey& key = m_lru.back().first;
+        m_index.erase(IndexKey { key.faceId, key.text });
+        m_lru.pop_back();
+        ++m_stats.evictions;
+    }
+
+    return m_lru.front().second;
+}
@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MUSE_DRAW_TEXTRUNCACHE_H
+#define MUSE_DRAW_TEXTRUNCACHE_H
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "ifontface.h"
+
+namespace muse::draw {
+//! NOTE Cache of the measurements of shaped text runs, keyed by the face and the text.
+//! A LRU of a limited size, each measurement of a run is stored on its first request.
+//! The measurements are in the units of the face, they don't depend on the required pixel size
+class TextRunCache
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 8192;
+
+    struct Run {
+        std::optional<f26dot6_t> advance;
+        std::optional<FBBox> boundingRect;
+        std::optional<FBBox> tightBoundingRect;
+    };
+
+    template<typename T>
+    using Field = std::optional<T> Run::*;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t size = 0;
+    };
+
+    void init(size_t capacity = DEFAULT_CAPACITY);
+
+    template<typename T>
+    bool load(size_t faceId, const std::u32string& text, Field<T> field, T& out)
+    {
+        std::lock_guard lock(m_mutex);
+
+        const Run* run = find(faceId, text);
+        if (run && (run->*field).has_value()) {
+            out = (run->*field).value();
+            ++m_stats.hits;
+            return true;
+        }
+
+        ++m_stats.misses;
+        return false;
+    }
+
+    template<typename T>
+    void store(size_t faceId, const std::u32string& text, Field<T> field, const T& value)
+    {
+        std::lock_guard lock(m_mutex);
+
+        findOrInsert(faceId, text).*field = value;
+    }
+
+    void clear();
+
+    Stats stats() const;
+
+private:
+    struct RunKey {
+        size_t faceId = 0;
+        std::u32string text;
+    };
+
+    //! NOTE Views the text of the key in the list, so looking up doesn't copy the text
+    struct IndexKey {
+        size_t faceId = 0;
+        std::u32string_view text;
+
+        bool operator==(const IndexKey& o) const { return faceId == o.faceId && text == o.text; }
+    };
+
+    struct IndexKeyHash {
+        size_t operator()(const IndexKey& k) const;
+    };
+
+    using LruList = std::list<std::pair<RunKey, Run> >;
+
+    Run* find(size_t faceId, const std::u32string& text);
+    Run& findOrInsert(size_t faceId, const std::u32string& text);
+
+    mutable std::mutex m_mutex;
+
+    size_t m_capacity = DEFAULT_CAPACITY;
+    LruList m_lru;
+    std::unordered_map<IndexKey, LruList::iterator, IndexKeyHash> m_index;
+
+    Stats m_stats;
+};
+}
+
+#endif // MUSE_DRAW_TEXTRUNCACHE_H
@@ -0,0 +1,223 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+
+#include "draw/internal/fontrendercache.h"
+
+using namespace muse;
+using namespace muse::draw;
+
+class Draw_FontRenderCacheTests : public ::testing::Test
+{
+public:
+    static FaceKey faceKey()
+    {
+        return FaceKey(FontDataKey("Bravura"), Font::Type::MusicSymbol, 200);
+    }
+
+    static GlyphImage glyphImage(uint8_t fill)
+    {
+        GlyphImage image;
+        image.rect = RectF(-1.5, -2.5, 10.0, 20.0);
+        image.sdf.width = 4;
+        image.sdf.height = 4;
+        image.sdf.bitmap = ByteArray(16);
+        for (size_t i = 0; i < 16; ++i) {
+            image.sdf.bitmap[i] = fill;
+        }
+        image.sdf.hash = fill;
+        return image;
+    }
+};
+
+TEST_F(Draw_FontRenderCacheTests, LoadStore_Memory)
+{
+    //! GIVEN Memory only cache
+    FontRenderCache cache;
+    cache.init();
+
+    //! DO Load a glyph, which was not stored
+    GlyphImage image;
+    EXPECT_FALSE(cache.load(faceKey(), 42, image));
+
+    //! DO Store and load it
+    cache.store(faceKey(), 42, glyphImage(7));
+    EXPECT_TRUE(cache.load(faceKey(), 42, image));
+
+    //! CHECK
+    EXPECT_EQ(image.rect, glyphImage(7).rect);
+    EXPECT_EQ(image.sdf.bitmap, glyphImage(7).sdf.bitmap);
+
+    //! CHECK Another pixel size is another key
+    FaceKey otherKey = faceKey();
+    otherKey.pixelSize = 100;
+    EXPECT_FALSE(cache.load(otherKey, 42, image));
+
+    FontRenderCache::Stats stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.size, 1u);
+}
+
+TEST_F(Draw_FontRenderCacheTests, Lru_Eviction)
+{
+    //! GIVEN Cache for two glyphs
+    FontRenderCache cache;
+    cache.init(io::path_t(), 2);
+
+    cache.store(faceKey(), 1, glyphImage(1));
+    cache.store(faceKey(), 2, glyphImage(2));
+
+    //! DO Touch the first glyph and store the third one
+    GlyphImage image;
+    EXPECT_TRUE(cache.load(faceKey(), 1, image));
+    cache.store(faceKey(), 3, glyphImage(3));
+
+    //! CHECK The least recently used glyph is evicted
+    EXPECT_TRUE(cache.load(faceKey(), 1, image));
+    EXPECT_FALSE(cache.load(faceKey(), 2, image));
+    EXPECT_TRUE(cache.load(faceKey(), 3, image));
+    EXPECT_EQ(cache.stats().evictions, 1u);
+}
+
+TEST_F(Draw_FontRenderCacheTests, LoadStore_Disk)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    //! GIVEN Cache with the disk tier, the images are flushed to the disk
+    {
+        FontRenderCache cache;
+        cache.init(dir.path());
+        cache.registerFace(faceKey(), io::path_t());
+        cache.store(faceKey(), 42, glyphImage(7));
+        cache.store(faceKey(), 43, GlyphImage());
+        cache.flush();
+    }
+
+    //! DO Load the images with a new cache (warm start)
+    FontRenderCache cache;
+    cache.init(dir.path());
+    cache.registerFace(faceKey(), io::path_t());
+
+    GlyphImage image;
+    EXPECT_TRUE(cache.load(faceKey(), 42, image));
+
+    //! CHECK
+    EXPECT_EQ(image.rect, glyphImage(7).rect);
+    EXPECT_EQ(image.sdf.width, 4u);
+    EXPECT_EQ(image.sdf.bitmap, glyphImage(7).sdf.bitmap);
+    EXPECT_EQ(image.sdf.hash, 7u);
+
+    //! CHECK Not printable glyphs are cached too
+    EXPECT_TRUE(cache.load(faceKey(), 43, image));
+    EXPECT_TRUE(image.isNull());
+
+    EXPECT_EQ(cache.stats().diskHits, 2u);
+    EXPECT_EQ(cache.stats().misses, 0u);
+}
+
+TEST_F(Draw_FontRenderCacheTests, Disk_FacesDoNotShareFile)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    //! GIVEN Faces, whose names differ only in the characters not allowed in a file name
+    const std::vector<FaceKey> faces = {
+        FaceKey(FontDataKey("Leland Text"), Font::Type::MusicSymbolText, 200),
+        FaceKey(FontDataKey("Leland-Text"), Font::Type::MusicSymbolText, 200),
+        FaceKey(FontDataKey("Lélànd Text"), Font::Type::MusicSymbolText, 200),
+    };
+
+    //! DO Store the same glyph of each face
+    {
+        FontRenderCache cache;
+        cache.init(dir.path());
+        for (size_t i = 0; i < faces.size(); ++i) {
+            cache.registerFace(faces.at(i), io::path_t());
+            cache.store(faces.at(i), 42, glyphImage(static_cast<uint8_t>(i + 1)));
+        }
+        cache.flush();
+    }
+
+    FontRenderCache cache;
+    cache.init(dir.path());
+
+    //! CHECK Each face gets its own image back
+    for (size_t i = 0; i < faces.size(); ++i) {
+        cache.registerFace(faces.at(i), io::path_t());
+
+        GlyphImage image;
+        EXPECT_TRUE(cache.load(faces.at(i), 42, image));
+        EXPECT_EQ(image.sdf.hash, i + 1);
+    }
+}
+
+TEST_F(Draw_FontRenderCacheTests, Disk_PendingIsBounded)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    //! GIVEN Cache with the disk tier, which keeps up to 4 new images in memory
+    {
+        FontRenderCache cache;
+        cache.init(dir.path(), FontRenderCache::DEFAULT_CAPACITY, 4);
+        cache.registerFace(faceKey(), io::path_t());
+
+        //! DO Store 10 images without flushing
+        for (glyph_idx_t idx = 0; idx < 10; ++idx) {
+            cache.store(faceKey(), idx, glyphImage(static_cast<uint8_t>(idx)));
+        }
+
+        //! CHECK The first 4 images are being written out in the background, the rest are waiting
+        EXPECT_LE(cache.stats().pending, 6u);
+
+        //! CHECK The images are available while they are written
+        GlyphImage image;
+        for (glyph_idx_t idx = 0; idx < 10; ++idx) {
+            EXPECT_TRUE(cache.load(faceKey(), idx, image));
+        }
+
+        //! DO Write the rest
+        cache.flush();
+
+        FontRenderCache::Stats stats = cache.stats();
+        EXPECT_GE(stats.diskWrites, 2u);
+        EXPECT_EQ(stats.pending, 0u);
+    }
+
+    //! DO Load the images with a new cache
+    FontRenderCache cache;
+    cache.init(dir.path());
+    cache.registerFace(faceKey(), io::path_t());
+
+    //! CHECK The images of all the writes are in the file
+    GlyphImage image;
+    for (glyph_idx_t idx = 0; idx < 10; ++idx) {
+        EXPECT_TRUE(cache.load(faceKey(), idx, image));
+        EXPECT_EQ(image.sdf.hash, idx);
+    }
+
+    EXPECT_EQ(cache.stats().diskHits, 10u);
+}
@@ -0,0 +1,185 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "modularity/ioc.h"
+
+#include "draw/internal/fontsengine.h"
+#include "draw/internal/fontsdatabase.h"
+
+using namespace muse;
+using namespace muse::draw;
+
+static const io::path_t FONTS_ROOT(muse_draw_tests_DATA_ROOT);
+
+static constexpr int THREADS = 8;
+static constexpr int REPEATS = 20;
+
+static const std::vector<std::u32string> TEXTS = {
+    U"Allegro", U"Allegro ma non troppo", U"ff", U"Line 1\nLine 2", U"1.", U"Vln. I", U"été"
+};
+
+static const std::vector<char32_t> CHARS = {
+    U'A', U'g', U'x', U'1', U' ', U'é', U'♯'
+};
+
+class Draw_FontsEngineTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_fontsDatabase = std::make_shared<FontsDatabase>();
+        m_fontsDatabase->addFont(FontDataKey("FreeSans"), FONTS_ROOT + "/FreeSans.ttf");
+        m_fontsDatabase->addFont(FontDataKey("FreeSerif"), FONTS_ROOT + "/FreeSerif.ttf");
+        m_fontsDatabase->addFont(FontDataKey("FreeSerif", true, false), FONTS_ROOT + "/FreeSerifBold.ttf");
+
+        m_fontsDatabase->setDefaultFont(Font::Type::Unknown, FontDataKey("FreeSans"));
+        m_fontsDatabase->setDefaultFont(Font::Type::Text, FontDataKey("FreeSans"));
+        m_fontsDatabase->setDefaultFont(Font::Type::MusicSymbol, FontDataKey("FreeSerif"));
+
+        modularity::globalIoc()->unregister<IFontsDatabase>("utests");
+        modularity::globalIoc()->registerExport<IFontsDatabase>("utests", m_fontsDatabase);
+    }
+
+    void TearDown() override
+    {
+        modularity::globalIoc()->unregister<IFontsDatabase>("utests");
+    }
+
+    static std::vector<Font> fonts()
+    {
+        std::vector<Font> result;
+
+        for (int pixelSize : { 10, 24, 50 }) {
+            Font sans(u"FreeSans", Font::Type::Text);
+            sans.setPixelSize(pixelSize);
+            result.push_back(sans);
+
+            Font serif(u"FreeSerif", Font::Type::Text);
+            serif.setPixelSize(pixelSize);
+            serif.setBold(pixelSize > 10);
+            result.push_back(serif);
+        }
+
+        result.push_back(Font(u"FreeSerif", Font::Type::MusicSymbol));
+
+        return result;
+    }
+
+    static void addRect(std::vector<double>& values, const RectF& r)
+    {
+        values.push_back(r.x());
+        values.push_back(r.y());
+        values.push_back(r.width());
+        values.push_back(r.height());
+    }
+
+    static std::vector<double> measure(const FontsEngine& engine, const Font& font)
+    {
+        std::vector<double> values;
+
+        values.push_back(engine.lineSpacing(font));
+        values.push_back(engine.xHeight(font));
+        values.push_back(engine.ascent(font));
+        values.push_back(engine.descent(font));
+
+        for (const std::u32string& text : TEXTS) {
+            values.push_back(engine.horizontalAdvance(font, text));
+            addRect(values, engine.boundingRect(font, text));
+            addRect(values, engine.tightBoundingRect(font, text));
+
+#ifndef MUSE_MODULE_DRAW_USE_QTTEXTDRAW
+            for (const GlyphImage& image : engine.render(font, text)) {
+                addRect(values, image.rect);
+                values.push_back(static_cast<double>(image.sdf.hash));
+            }
+#endif
+        }
+
+        for (char32_t ch : CHARS) {
+            values.push_back(engine.inFontUcs4(font, ch) ? 1.0 : 0.0);
+            values.push_back(engine.horizontalAdvance(font, ch));
+            addRect(values, engine.boundingRect(font, ch));
+            addRect(values, engine.symBBox(font, ch));
+            values.push_back(engine.symAdvance(font, ch));
+        }
+
+        return values;
+    }
+
+private:
+    std::shared_ptr<FontsDatabase> m_fontsDatabase;
+};
+
+TEST_F(Draw_FontsEngineTests, ConcurrentReaders)
+{
+    const std::vector<Font> fonts = Draw_FontsEngineTests::fonts();
+
+    //! GIVEN The metrics measured on a single thread
+    std::vector<std::vector<double> > expected;
+    {
+        FontsEngine engine;
+        engine.init();
+        for (const Font& font : fonts) {
+            expected.push_back(measure(engine, font));
+        }
+    }
+
+    //! DO Measure the same with a new engine from many threads at once,
+    //! so that the faces and the caches are also created concurrently
+    FontsEngine engine;
+    engine.init();
+
+    std::atomic<bool> start = false;
+    std::atomic<int> mismatches = 0;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+
+            for (int r = 0; r < REPEATS; ++r) {
+                for (size_t i = 0; i < fonts.size(); ++i) {
+                    //! NOTE Each thread walks the fonts in its own order
+                    size_t idx = (i + static_cast<size_t>(t)) % fonts.size();
+                    if (measure(engine, fonts.at(idx)) != expected.at(idx)) {
+                        ++mismatches;
+                    }
+                }
+            }
+        });
+    }
+
+    start = true;
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    //! CHECK
+    EXPECT_EQ(mismatches.load(), 0);
+    EXPECT_GT(engine.textRunCacheStats().hits, 0u);
+}
@@ -0,0 +1,94 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "draw/internal/textruncache.h"
+
+using namespace muse;
+using namespace muse::draw;
+
+class Draw_TextRunCacheTests : public ::testing::Test
+{
+public:
+    static FBBox bbox(f26dot6_t width)
+    {
+        return FBBox(-64, -640, width, 768);
+    }
+};
+
+TEST_F(Draw_TextRunCacheTests, LoadStore)
+{
+    //! GIVEN Empty cache
+    TextRunCache cache;
+    cache.init();
+
+    //! DO Load a run, which was not stored
+    f26dot6_t advance = 0;
+    EXPECT_FALSE(cache.load(0, U"Allegro", &TextRunCache::Run::advance, advance));
+
+    //! DO Store and load it
+    cache.store(0, U"Allegro", &TextRunCache::Run::advance, f26dot6_t(2048));
+    EXPECT_TRUE(cache.load(0, U"Allegro", &TextRunCache::Run::advance, advance));
+
+    //! CHECK
+    EXPECT_EQ(advance, 2048);
+
+    //! CHECK The other measurements of the run are not stored yet
+    FBBox rect;
+    EXPECT_FALSE(cache.load(0, U"Allegro", &TextRunCache::Run::boundingRect, rect));
+
+    cache.store(0, U"Allegro", &TextRunCache::Run::boundingRect, bbox(2000));
+    EXPECT_TRUE(cache.load(0, U"Allegro", &TextRunCache::Run::boundingRect, rect));
+    EXPECT_EQ(rect, bbox(2000));
+
+    //! CHECK Another face is another key
+    EXPECT_FALSE(cache.load(1, U"Allegro", &TextRunCache::Run::advance, advance));
+
+    TextRunCache::Stats stats = cache.stats();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.size, 1u);
+}
+
+TEST_F(Draw_TextRunCacheTests, Lru_Eviction)
+{
+    //! GIVEN Cache for two runs
+    TextRunCache cache;
+    cache.init(2);
+
+    cache.store(0, U"la", &TextRunCache::Run::advance, f26dot6_t(1));
+    cache.store(0, U"la la", &TextRunCache::Run::advance, f26dot6_t(2));
+
+    //! DO Touch the first run and store the third one
+    f26dot6_t advance = 0;
+    EXPECT_TRUE(cache.load(0, U"la", &TextRunCache::Run::advance, advance));
+    cache.store(0, U"la la la", &TextRunCache::Run::advance, f26dot6_t(3));
+
+    //! CHECK The least recently used run is evicted
+    EXPECT_TRUE(cache.load(0, U"la", &TextRunCache::Run::advance, advance));
+    EXPECT_EQ(advance, 1);
+    EXPECT_FALSE(cache.load(0, U"la la", &TextRunCache::Run::advance, advance));
+    EXPECT_TRUE(cache.load(0, U"la la la", &TextRunCache::Run::advance, advance));
+    EXPECT_EQ(advance, 3);
+    EXPECT_EQ(cache.stats().evictions, 1u);
+    EXPECT_EQ(cache.stats().size, 2u);
+}
@@ -154,4 +154,23 @@ struct FontParams {
 };
 }
 
+template<>
+struct std::hash<muse::draw::FaceKey>
+{
+    std::size_t operator()(const muse::draw::FaceKey& k) const noexcept
+    {
+        std::size_t h = std::hash<std::string> {}(k.dataKey.family());
+        auto combine = [&h](std::size_t v) {
+            h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2);
+        };
+
+        combine(k.dataKey.bold());
+        combine(k.dataKey.italic());
+        combine(static_cast<std::size_t>(k.type));
+        combine(static_cast<std::size_t>(k.pixelSize));
+
+        return h;
+    }
+};
+
 #endif // MUSE_DRAW_FONTSTYPES_H
@@ -50,6 +50,15 @@ public:
         return &s;
     }
 
+    //! NOTE The pool for the CPU-bound work of the app (layout, image export, saving in the background),
+    //! instance() is kept for the audio engine. It has the default number of threads (half of the cores).
+    //! A task must not wait for the tasks queued after it
+    static TaskScheduler* workerPool()
+    {
+        static TaskScheduler s;
+        return &s;
+    }
+
     explicit TaskScheduler(const thread_pool_size_t desiredThreadCount = 0)
         : m_threadPoolSize(vaildateThreadPoolCapacity(desiredThreadCount)),
         m_threadPool(std::make_unique<std::thread[]>(vaildateThreadPoolCapacity(desiredThreadCount)))
@@ -43,6 +43,11 @@ path_t File::filePath() const
     return m_filePath;
 }
 
+void File::setMapOnRead(bool arg)
+{
+    m_mapOnRead = arg;
+}
+
 bool File::exists() const
 {
     return fileSystem()->exists(m_filePath);
@@ -105,6 +110,18 @@ bool File::doOpen(OpenMode m)
     }
 
     m_data = ByteArray();
+    m_mapping = nullptr;
+
+    if (m_mapOnRead && m == IODevice::ReadOnly) {
+        RetVal<FileMappingPtr> mapping = fileSystem()->mapFile(m_filePath);
+        if (mapping.ret) {
+            m_mapping = mapping.val;
+            return true;
+        }
+
+        //! NOTE For example, an empty file can't be mapped
+    }
+
     Ret ret = fileSystem()->readFile(m_filePath, m_data);
     if (!ret) {
         setError(ret.code(), ret.text());
@@ -116,12 +133,12 @@ bool File::doOpen(OpenMode m)
 
 size_t File::dataSize() const
 {
-    return m_data.size();
+    return m_mapping ? m_mapping->size() : m_data.size();
 }
 
 const uint8_t* File::rawData() const
 {
-    return m_data.constData();
+    return m_mapping ? m_mapping->data() : m_data.constData();
 }
 
 bool File::resizeData(size_t size)
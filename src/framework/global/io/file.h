@@ -41,6 +41,11 @@ public:
 
     path_t filePath() const;
 
+    //! NOTE In the ReadOnly mode, map the file instead of reading it whole,
+    //! so only the parts that are actually read get loaded.
+    //! The file must not be truncated by someone else while it's mapped
+    void setMapOnRead(bool arg);
+
     bool exists() const;
     bool remove();
 
@@ -63,6 +68,8 @@ private:
 
     path_t m_filePath;
     ByteArray m_data;
+    bool m_mapOnRead = false;
+    FileMappingPtr m_mapping;
 };
 }
 
@@ -22,6 +22,8 @@
 #ifndef MUSE_IO_IFILESYSTEM_H
 #define MUSE_IO_IFILESYSTEM_H
 
+#include <memory>
+
 #include "global/modularity/imoduleinterface.h"
 #include "global/types/bytearray.h"
 #include "global/types/datetime.h"
@@ -31,6 +33,19 @@
 #include "ioenums.h"
 
 namespace muse::io {
+//! NOTE A read-only view of a file mapped into memory,
+//! the file is unmapped when the view is destroyed
+class FileMapping
+{
+public:
+    virtual ~FileMapping() = default;
+
+    virtual const uint8_t* data() const = 0;
+    virtual size_t size() const = 0;
+};
+
+using FileMappingPtr = std::shared_ptr<FileMapping>;
+
 class IFileSystem : MODULE_EXPORT_INTERFACE
 {
     INTERFACE_ID(IFileSystem)
@@ -64,6 +79,9 @@ public:
     virtual Ret readFile(const io::path_t& filePath, ByteArray& data) const = 0;
     virtual Ret writeFile(const io::path_t& filePath, const ByteArray& data) const = 0;
 
+    //! NOTE Unlike readFile, only the pages that are actually read get loaded into memory
+    virtual RetVal<FileMappingPtr> mapFile(const io::path_t& filePath) const = 0;
+
     //! NOTE File info
     virtual io::path_t canonicalFilePath(const io::path_t& filePath) const = 0;
     virtual io::path_t absolutePath(const io::path_t& filePath) const = 0;
@@ -219,6 +219,71 @@ Ret FileSystem::writeFile(const io::path_t& filePath, const ByteArray& data) con
     return ret;
 }
 
+namespace {
+class QFileMapping : public FileMapping
+{
+public:
+    QFileMapping(const QString& filePath)
+        : m_file(filePath) {}
+
+    ~QFileMapping() override
+    {
+        if (m_data) {
+            m_file.unmap(m_data);
+        }
+    }
+
+    Ret map()
+    {
+        if (!m_file.open(QIODevice::ReadOnly)) {
+            Ret ret = make_ret(Err::FSReadError);
+            ret.setText(m_file.errorString().toStdString());
+            return ret;
+        }
+
+        m_size = static_cast<size_t>(m_file.size());
+        m_data = m_size > 0 ? m_file.map(0, m_file.size()) : nullptr;
+
+        Ret ret = make_ok();
+        if (!m_data) {
+            ret = make_ret(Err::FSReadError);
+            ret.setText(m_file.errorString().toStdString());
+        }
+
+        //! NOTE The mapping stays valid after the file is closed
+        m_file.close();
+
+        return ret;
+    }
+
+    const uint8_t* data() const override
+    {
+        return m_data;
+    }
+
+    size_t size() const override
+    {
+        return m_size;
+    }
+
+private:
+    QFile m_file;
+    uchar* m_data = nullptr;
+    size_t m_size = 0;
+};
+}
+
+RetVal<FileMappingPtr> FileSystem::mapFile(const io::path_t& filePath) const
+{
+    std::shared_ptr<QFileMapping> mapping = std::make_shared<QFileMapping>(filePath.toQString());
+    Ret ret = mapping->map();
+    if (!ret) {
+        return ret;
+    }
+
+    return RetVal<FileMappingPtr>::make_ok(mapping);
+}
+
 Ret FileSystem::makePath(const io::path_t& path) const
 {
     if (!QDir().mkpath(path.toQString())) {
@@ -48,6 +48,8 @@ public:
     Ret readFile(const io::path_t& filePath, ByteArray& data) const override;
     Ret writeFile(const io::path_t& filePath, const ByteArray& data) const override;
 
+    RetVal<FileMappingPtr> mapFile(const io::path_t& filePath) const override;
+
     void setAttribute(const io::path_t& path, Attribute attribute) const override;
     bool setPermissionsAllowedForAll(const io::path_t& path) const override;
 
@@ -778,22 +778,26 @@ ByteArray ZipContainer::fileData(const std::string& fileName) const
         return ByteArray();
     }
 
-    ByteArray compressed = p->device->read(compressed_size);
+    //! NOTE The device holds the whole container in memory (or mapped), so read the entry in place, without a copy
+    const uint8_t* deviceData = p->device->readData();
+    const size_t dataPos = p->device->pos();
+    const size_t available = p->device->size() > dataPos ? p->device->size() - dataPos : 0;
+    const ByteArray compressed = deviceData
+                                 ? ByteArray::fromRawData(deviceData + dataPos, std::min(static_cast<size_t>(compressed_size), available))
+                                 : ByteArray();
     if (compression_method == CompressionMethodStored) {
         // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
+        return ByteArray(compressed.constData(), std::min(compressed.size(), static_cast<size_t>(uncompressed_size)));
     } else if (compression_method == CompressionMethodDeflated) {
         // Deflate
         //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
         ByteArray baunzip;
         ulong len = std::max(uncompressed_size,  1);
         int res;
         do {
             baunzip.resize(len);
             res = inflate((uint8_t*)baunzip.data(), &len,
-                          (const uint8_t*)compressed.constData(), compressed_size);
+                          (const uint8_t*)compressed.constData(), compressed.size());
 
             switch (res) {
             case Z_OK:
@@ -36,13 +36,562 @@ using namespace muse;
 using namespace muse::io;
 using namespace tinyxml2;
 
+static constexpr size_t STREAM_BLOCK_SIZE = 64 * 1024;
+
+//! NOTE: Incremental pull parser
+//! Tokens are read straight from the document bytes, nothing like a DOM is built.
+//! The parser works in place on its own copy of the data (like tinyxml2 did):
+//! names, values and texts are terminated with '\0' and entities are decoded
+//! right inside the buffer, so all returned views point into it and stay valid
+//! until the next setData(). The syntax accepted, the whitespace handling
+//! and the entity/newline processing follow tinyxml2, used before.
+//! A device is read block by block, as the parser gets to the end of a block.
+//! The blocks are kept until the next setData(), so the views stay valid;
+//! a token cut by the end of a block is parsed again from the start of the next one.
 struct XmlStreamReader::Xml {
-    XMLDocument doc;
-    XMLNode* node = nullptr;
-    XMLError err;
+    struct Attr {
+        AsciiStringView name;
+        const char* value = nullptr;
+    };
+
+    struct AttrBounds {
+        char* name = nullptr;
+        char* nameEnd = nullptr;
+        char* value = nullptr;
+        char* valueEnd = nullptr;
+    };
+
+    std::vector<ByteArray> blocks;
+    IODevice* device = nullptr;
+    char* blockBegin = nullptr;
+    //! NOTE: The terminating '\0' of the current block
+    char* blockEnd = nullptr;
+    //! NOTE: The offset of the current block in the document
+    int64_t blockOffset = 0;
+
+    char* pos = nullptr;
+    //! NOTE: The char at pos was '<', but it was replaced by '\0' to terminate the preceding text
+    bool ltConsumed = false;
+
+    int64_t line = 1;
+    //! NOTE: The offset of the line in the document, the blocks don't keep whole lines
+    int64_t lineStart = 0;
+    int64_t tokenLine = 0;
+    int64_t tokenColumn = 0;
+
+    std::vector<AsciiStringView> openElements;
+    bool declarationAllowed = true;
+    bool selfClosed = false;
+
+    // current token
+    AsciiStringView name;
+    const char* value = nullptr;
+    size_t valueSize = 0;
+    std::vector<Attr> attrs;
+    std::vector<AttrBounds> attrBounds;
+
+    bool parseError = false;
+    String parseErr;
     String customErr;
+
+    void reset()
+    {
+        blocks.clear();
+        device = nullptr;
+        blockBegin = nullptr;
+        blockEnd = nullptr;
+        blockOffset = 0;
+        pos = nullptr;
+        ltConsumed = false;
+        line = 1;
+        lineStart = 0;
+        tokenLine = 0;
+        tokenColumn = 0;
+        openElements.clear();
+        declarationAllowed = true;
+        selfClosed = false;
+        clearToken();
+        parseError = false;
+        parseErr.clear();
+        customErr.clear();
+    }
+
+    void clearToken()
+    {
+        name = AsciiStringView();
+        value = nullptr;
+        valueSize = 0;
+        attrs.clear();
+    }
+
+    TokenType setError(const char* message)
+    {
+        parseError = true;
+        parseErr = String::fromAscii(message) + u" at line " + String::number(line);
+
+        //! NOTE: The token may be cut by the end of the block, it will be parsed again
+        if (!hasMoreData()) {
+            LOGE() << parseErr;
+        }
+
+        return TokenType::Invalid;
+    }
+
+    void setBlock(ByteArray block, int64_t offset)
+    {
+        blocks.push_back(std::move(block));
+        blockBegin = reinterpret_cast<char*>(blocks.back().data());
+        blockEnd = blockBegin + blocks.back().size();
+        blockOffset = offset;
+    }
+
+    bool hasMoreData() const
+    {
+        return device && device->pos() < device->size();
+    }
+
+    //! NOTE: Starts a new block with the rest of the current one from tailStart and the next data of the device
+    bool readMore(const char* tailStart)
+    {
+        if (!hasMoreData()) {
+            return false;
+        }
+
+        //! NOTE: A token longer than a block makes the next one bigger
+        const size_t tailSize = blockEnd - tailStart;
+        const size_t readSize = std::max(STREAM_BLOCK_SIZE, tailSize);
+
+        ByteArray block(tailSize + readSize);
+        std::memcpy(block.data(), tailStart, tailSize);
+        const size_t read = device->read(block.data() + tailSize, readSize);
+        if (read == 0) {
+            device = nullptr;
+            return false;
+        }
+        block.resize(tailSize + read);
+
+        setBlock(std::move(block), offsetOf(tailStart));
+        return true;
+    }
+
+    //! NOTE: Skips the leading whitespace and the BOM of the first block
+    bool begin(ByteArray block)
+    {
+        setBlock(std::move(block), 0);
+
+        char* p = skipWhiteSpace(blockBegin);
+        if (std::strncmp(p, "\xEF\xBB\xBF", 3) == 0) {
+            p += 3;
+        }
+
+        if (!*p && !hasMoreData()) {
+            setError("Empty document");
+            return false;
+        }
+
+        pos = p;
+        return true;
+    }
+
+    int64_t offsetOf(const char* p) const
+    {
+        return blockOffset + (p - blockBegin);
+    }
+
+    int64_t columnOf(const char* p) const
+    {
+        return offsetOf(p) - lineStart + 1;
+    }
+
+    const Attr* findAttr(const char* attrName) const
+    {
+        for (const Attr& a : attrs) {
+            if (a.name == attrName) {
+                return &a;
+            }
+        }
+        return nullptr;
+    }
+
+    void newLine(const char* p)
+    {
+        ++line;
+        lineStart = offsetOf(p) + 1;
+    }
+
+    char* skipWhiteSpace(char* p)
+    {
+        while (XMLUtil::IsWhiteSpace(*p)) {
+            if (*p == '\n') {
+                newLine(p);
+            }
+            ++p;
+        }
+        return p;
+    }
+
+    //! NOTE: Returns the position of the end tag or nullptr if the document ends before it
+    char* findEndTag(char* p, const char* endTag)
+    {
+        const char endChar = *endTag;
+        const size_t length = std::strlen(endTag);
+
+        while (*p) {
+            if (*p == endChar && std::strncmp(p, endTag, length) == 0) {
+                return p;
+            } else if (*p == '\n') {
+                newLine(p);
+            }
+            ++p;
+        }
+        return nullptr;
+    }
+
+    static char* parseName(char* p)
+    {
+        if (!XMLUtil::IsNameStartChar(static_cast<unsigned char>(*p))) {
+            return nullptr;
+        }
+
+        ++p;
+        while (*p && XMLUtil::IsNameChar(static_cast<unsigned char>(*p))) {
+            ++p;
+        }
+        return p;
+    }
+
+    //! NOTE: Terminates [start, end) and normalizes newlines, optionally decodes entities, in place
+    static size_t finishString(char* start, char* end, bool processEntities)
+    {
+        static const struct {
+            const char* pattern;
+            size_t length;
+            char value;
+        } ENTITIES[] = {
+            { "quot", 4, '\"' },
+            { "amp", 3, '&' },
+            { "apos", 4, '\'' },
+            { "lt", 2, '<' },
+            { "gt", 2, '>' }
+        };
+
+        *end = 0;
+
+        const char* p = start;
+        char* q = start;
+
+        while (p < end) {
+            if (*p == '\r') {
+                p += (*(p + 1) == '\n') ? 2 : 1;
+                *q++ = '\n';
+            } else if (*p == '\n') {
+                p += (*(p + 1) == '\r') ? 2 : 1;
+                *q++ = '\n';
+            } else if (processEntities && *p == '&') {
+                if (*(p + 1) == '#') {
+                    char buf[10] = { 0 };
+                    int len = 0;
+                    const char* adjusted = XMLUtil::GetCharacterRef(p, buf, &len);
+                    if (!adjusted) {
+                        *q++ = *p++;
+                    } else {
+                        p = adjusted;
+                        std::memcpy(q, buf, len);
+                        q += len;
+                    }
+                } else {
+                    bool found = false;
+                    for (const auto& entity : ENTITIES) {
+                        if (std::strncmp(p + 1, entity.pattern, entity.length) == 0 && *(p + entity.length + 1) == ';') {
+                            *q++ = entity.value;
+                            p += entity.length + 2;
+                            found = true;
+                            break;
+                        }
+                    }
+
+                    if (!found) {
+                        *q++ = *p++;
+                    }
+                }
+            } else {
+                *q++ = *p++;
+            }
+        }
+
+        *q = 0;
+        return q - start;
+    }
+
+    void setValue(char* start, char* end, bool processEntities)
+    {
+        valueSize = finishString(start, end, processEntities);
+        value = start;
+    }
+
+    TokenType next();
+    TokenType nextToken();
+    TokenType parseMarkup(char* p);
+    TokenType parseStartElement(char* p);
+    TokenType parseEndElement(char* p);
+    TokenType parseText(char* p);
 };
 
+XmlStreamReader::TokenType XmlStreamReader::Xml::next()
+{
+    TokenType token = TokenType::NoToken;
+    while (token == TokenType::NoToken) {
+        // the state to parse the token again from, if it's cut by the end of the block
+        char* tokenStart = pos;
+        const bool startLtConsumed = ltConsumed;
+        const bool startDeclarationAllowed = declarationAllowed;
+        const int64_t startLine = line;
+        const int64_t startLineStart = lineStart;
+
+        token = nextToken();
+
+        if ((token == TokenType::Invalid || token == TokenType::EndDocument) && readMore(tokenStart)) {
+            pos = blockBegin;
+            ltConsumed = startLtConsumed;
+            declarationAllowed = startDeclarationAllowed;
+            line = startLine;
+            lineStart = startLineStart;
+            parseError = false;
+            parseErr.clear();
+            clearToken();
+            token = TokenType::NoToken;
+        }
+    }
+    return token;
+}
+
+XmlStreamReader::TokenType XmlStreamReader::Xml::nextToken()
+{
+    if (selfClosed) {
+        selfClosed = false;
+        name = openElements.back();
+        openElements.pop_back();
+        attrs.clear();
+        return TokenType::EndElement;
+    }
+
+    clearToken();
+
+    char* p = pos;
+    if (ltConsumed) {
+        ltConsumed = false;
+        tokenLine = line;
+        tokenColumn = columnOf(p);
+        return parseMarkup(p + 1);
+    }
+
+    char* start = p;
+    int64_t startLine = line;
+    int64_t startLineStart = lineStart;
+
+    p = skipWhiteSpace(p);
+
+    tokenLine = line;
+    tokenColumn = columnOf(p);
+
+    if (!*p) {
+        pos = p;
+        if (!openElements.empty()) {
+            return setError("Unexpected end of document");
+        }
+        return TokenType::EndDocument;
+    }
+
+    if (*p == '<') {
+        return parseMarkup(p + 1);
+    }
+
+    // all the text counts, including the leading whitespace
+    line = startLine;
+    lineStart = startLineStart;
+    declarationAllowed = false;
+
+    return parseText(start);
+}
+
+XmlStreamReader::TokenType XmlStreamReader::Xml::parseMarkup(char* p)
+{
+    if (*p == '?') {
+        char* end = findEndTag(p + 1, "?>");
+        if (!end) {
+            return setError("Unterminated declaration");
+        }
+        pos = end + 2;
+
+        //! NOTE: Declarations (processing instructions) after the beginning of the document are skipped
+        if (!declarationAllowed || !openElements.empty()) {
+            return TokenType::NoToken;
+        }
+
+        setValue(p + 1, end, false);
+        return TokenType::StartDocument;
+    }
+
+    declarationAllowed = false;
+
+    if (std::strncmp(p, "!--", 3) == 0) {
+        char* end = findEndTag(p + 3, "-->");
+        if (!end) {
+            return setError("Unterminated comment");
+        }
+        pos = end + 3;
+        setValue(p + 3, end, false);
+        return TokenType::Comment;
+    }
+
+    if (std::strncmp(p, "![CDATA[", 8) == 0) {
+        char* end = findEndTag(p + 8, "]]>");
+        if (!end) {
+            return setError("Unterminated CDATA section");
+        }
+        pos = end + 3;
+        setValue(p + 8, end, false);
+        return TokenType::Characters;
+    }
+
+    if (*p == '!') {
+        char* end = findEndTag(p + 1, ">");
+        if (!end) {
+            return setError("Unterminated DTD");
+        }
+        pos = end + 1;
+        setValue(p + 1, end, false);
+        return TokenType::DTD;
+    }
+
+    p = skipWhiteSpace(p);
+    if (*p == '/') {
+        return parseEndElement(p + 1);
+    }
+
+    return parseStartElement(p);
+}
+
+XmlStreamReader::TokenType XmlStreamReader::Xml::parseStartElement(char* p)
+{
+    char* nameStart = p;
+    char* nameEnd = parseName(p);
+    if (!nameEnd) {
+        return setError("Invalid element name");
+    }
+
+    //! NOTE: The terminators are written only when the whole tag is parsed,
+    //! because they overwrite the chars that separate its parts
+    std::vector<AttrBounds>& bounds = attrBounds;
+    bounds.clear();
+
+    p = nameEnd;
+    bool closed = false;
+    while (true) {
+        p = skipWhiteSpace(p);
+
+        if (XMLUtil::IsNameStartChar(static_cast<unsigned char>(*p))) {
+            AttrBounds b;
+            b.name = p;
+            b.nameEnd = parseName(p);
+            p = skipWhiteSpace(b.nameEnd);
+            if (*p != '=') {
+                return setError("Invalid attribute");
+            }
+
+            p = skipWhiteSpace(p + 1);
+            if (*p != '\"' && *p != '\'') {
+                return setError("Invalid attribute value");
+            }
+
+            const char endTag[2] = { *p, 0 };
+            b.value = p + 1;
+            b.valueEnd = findEndTag(b.value, endTag);
+            if (!b.valueEnd) {
+                return setError("Unterminated attribute value");
+            }
+
+            for (const AttrBounds& other : bounds) {
+                if (other.nameEnd - other.name == b.nameEnd - b.name
+                    && std::strncmp(other.name, b.name, b.nameEnd - b.name) == 0) {
+                    return setError("Duplicated attribute");
+                }
+            }
+
+            bounds.push_back(b);
+            p = b.valueEnd + 1;
+        } else if (*p == '>') {
+            ++p;
+            break;
+        } else if (*p == '/' && *(p + 1) == '>') {
+            p += 2;
+            closed = true;
+            break;
+        } else {
+            return setError("Invalid element");
+        }
+    }
+
+    pos = p;
+
+    *nameEnd = 0;
+    name = AsciiStringView(nameStart, nameEnd - nameStart);
+
+    for (const AttrBounds& b : bounds) {
+        *b.nameEnd = 0;
+        finishString(b.value, b.valueEnd, true);
+        attrs.push_back({ AsciiStringView(b.name, b.nameEnd - b.name), b.value });
+    }
+
+    openElements.push_back(name);
+    selfClosed = closed;
+
+    return TokenType::StartElement;
+}
+
+XmlStreamReader::TokenType XmlStreamReader::Xml::parseEndElement(char* p)
+{
+    char* nameEnd = parseName(p);
+    if (!nameEnd) {
+        return setError("Invalid element name");
+    }
+
+    if (openElements.empty()) {
+        return setError("Unexpected end tag");
+    }
+
+    const AsciiStringView& openName = openElements.back();
+    if (AsciiStringView(p, nameEnd - p) != openName) {
+        return setError("Mismatched end tag");
+    }
+
+    p = skipWhiteSpace(nameEnd);
+    if (*p != '>') {
+        return setError("Invalid end tag");
+    }
+
+    pos = p + 1;
+    name = openName;
+    openElements.pop_back();
+
+    return TokenType::EndElement;
+}
+
+XmlStreamReader::TokenType XmlStreamReader::Xml::parseText(char* p)
+{
+    char* end = findEndTag(p, "<");
+    if (!end) {
+        return setError("Unexpected end of document in text");
+    }
+
+    //! NOTE: The '<' becomes the terminator of the text
+    pos = end;
+    ltConsumed = true;
+    setValue(p, end, true);
+
+    return TokenType::Characters;
+}
+
 XmlStreamReader::XmlStreamReader()
 {
     m_xml = new Xml();
@@ -51,8 +600,20 @@ XmlStreamReader::XmlStreamReader()
 XmlStreamReader::XmlStreamReader(IODevice* device)
 {
     m_xml = new Xml();
-    ByteArray data = device->readAll();
-    setData(data);
+
+    ByteArray block = device->read(STREAM_BLOCK_SIZE);
+    const bool atEnd = device->pos() >= device->size();
+
+    //! NOTE: UTF-16 is converted as a whole, and a short document gets the checks of setData
+    UtfCodec::Encoding enc = block.size() < 4 ? UtfCodec::Encoding::Unknown : UtfCodec::xmlEncoding(block);
+    if (atEnd || enc != UtfCodec::Encoding::UTF_8) {
+        block.push_back(device->readAll());
+        setData(block);
+        return;
+    }
+
+    m_xml->device = device;
+    m_token = m_xml->begin(std::move(block)) ? TokenType::NoToken : TokenType::Invalid;
 }
 
 XmlStreamReader::XmlStreamReader(const ByteArray& data)
@@ -78,39 +639,36 @@ XmlStreamReader::~XmlStreamReader()
 
 void XmlStreamReader::setData(const ByteArray& data_)
 {
-    m_xml->doc.Clear();
-    m_xml->customErr.clear();
+    m_xml->reset();
+    m_entities.clear();
     m_token = TokenType::Invalid;
 
     if (data_.size() < 4) {
-        m_xml->err = XML_ERROR_EMPTY_DOCUMENT;
-        LOGE() << m_xml->doc.ErrorIDToName(m_xml->err);
+        m_xml->setError("Empty document");
         return;
     }
 
     UtfCodec::Encoding enc = UtfCodec::xmlEncoding(data_);
     if (enc == UtfCodec::Encoding::Unknown) {
-        m_xml->err = XML_CAN_NOT_CONVERT_TEXT;
-        LOGE() << "unknown encoding";
+        m_xml->setError("Unknown encoding");
         return;
     }
 
-    ByteArray data = data_; // no copy, implicit sharing
+    ByteArray data;
     if (enc == UtfCodec::Encoding::UTF_16LE) {
-        String u16 = String::fromUtf16LE(data_);
-        data = u16.toUtf8();
+        data = String::fromUtf16LE(data_).toUtf8();
     } else if (enc == UtfCodec::Encoding::UTF_16BE) {
-        String u16 = String::fromUtf16BE(data_);
-        data = u16.toUtf8();
+        data = String::fromUtf16BE(data_).toUtf8();
+    } else {
+        data = data_; // no copy, implicit sharing
     }
 
-    m_xml->err = m_xml->doc.Parse(reinterpret_cast<const char*>(data.constData()), data.size());
-
-    if (m_xml->err == XML_SUCCESS) {
-        m_token = TokenType::NoToken;
-    } else {
-        LOGE() << m_xml->doc.ErrorIDToName(m_xml->err);
+    //! NOTE: The data is parsed in place, so a shared buffer is detached (copied) when the block is set
+    if (!m_xml->begin(std::move(data))) {
+        return;
     }
+
+    m_token = TokenType::NoToken;
 }
 
 bool XmlStreamReader::readNextStartElement()
@@ -130,73 +688,19 @@ bool XmlStreamReader::atEnd() const
     return m_token == TokenType::EndDocument || m_token == TokenType::Invalid;
 }
 
-static XmlStreamReader::TokenType resolveToken(XMLNode* n, bool isStartElement)
-{
-    if (n->ToElement()) {
-        return isStartElement ? XmlStreamReader::TokenType::StartElement : XmlStreamReader::TokenType::EndElement;
-    } else if (n->ToText()) {
-        return XmlStreamReader::TokenType::Characters;
-    } else if (n->ToComment()) {
-        return XmlStreamReader::TokenType::Comment;
-    } else if (n->ToDeclaration()) {
-        return XmlStreamReader::TokenType::StartDocument;
-    } else if (n->ToDocument()) {
-        return XmlStreamReader::TokenType::EndDocument;
-    } else if (n->ToUnknown()) {
-        return XmlStreamReader::TokenType::DTD;
-    }
-    return XmlStreamReader::TokenType::Unknown;
-}
-
-static std::pair<XMLNode*, XmlStreamReader::TokenType> resolveNode(XMLNode* currentNode, XmlStreamReader::TokenType currentToken)
-{
-    if (currentToken == XmlStreamReader::TokenType::StartElement) {
-        XMLNode* child = currentNode->FirstChild();
-        if (child) {
-            return { child, resolveToken(child, true) };
-        }
-
-        XMLNode* sibling = currentNode->NextSibling();
-        if (!sibling || sibling->ToElement() || sibling->ToText()) {
-            return { currentNode, XmlStreamReader::TokenType::EndElement };
-        }
-    }
-
-    XMLNode* sibling = currentNode->NextSibling();
-    if (sibling) {
-        return { sibling, resolveToken(sibling, true) };
-    }
-
-    XMLNode* parent = currentNode->Parent();
-    if (parent) {
-        return { parent, resolveToken(parent, false) };
-    }
-
-    return { nullptr, XmlStreamReader::TokenType::EndDocument };
-}
-
 XmlStreamReader::TokenType XmlStreamReader::readNext()
 {
     if (m_token == TokenType::Invalid) {
         return m_token;
     }
 
-    if (m_xml->err != XML_SUCCESS || m_token == EndDocument) {
-        m_xml->node = nullptr;
+    if (m_xml->parseError || m_token == EndDocument) {
+        m_xml->clearToken();
         m_token = TokenType::Invalid;
         return m_token;
     }
 
-    if (!m_xml->node) {
-        m_xml->node = m_xml->doc.FirstChild();
-        m_token = m_xml->node->ToDeclaration() ? TokenType::StartDocument : resolveToken(m_xml->node, true);
-        return m_token;
-    }
-
-    std::pair<XMLNode*, XmlStreamReader::TokenType> p = resolveNode(m_xml->node, m_token);
-
-    m_xml->node = p.first;
-    m_token = p.second;
+    m_token = m_xml->next();
 
     if (m_token == XmlStreamReader::TokenType::DTD) {
         tryParseEntity(m_xml);
@@ -212,7 +716,7 @@ void XmlStreamReader::tryParseEntity(Xml* xml)
 {
     static const char* ENTITY = { "ENTITY" };
 
-    const char* str = xml->node->Value();
+    const char* str = xml->value;
     if (std::strncmp(str, ENTITY, 6) == 0) {
         // Syntax: '<!ENTITY [%] Name [SYSTEM|PUBLIC] "Value" [additional info] >'
         // the '<!' and '>' stripped away already from str
@@ -239,7 +743,7 @@ void XmlStreamReader::tryParseEntity(Xml* xml)
 
 String XmlStreamReader::nodeValue(Xml* xml) const
 {
-    String str = String::fromUtf8(xml->node->Value());
+    String str = String::fromUtf8(xml->value);
     if (!m_entities.empty()) {
         for (const auto& p : m_entities) {
             str.replace(p.first, p.second);
@@ -289,7 +793,7 @@ void XmlStreamReader::skipCurrentElement()
 
 AsciiStringView XmlStreamReader::name() const
 {
-    return (m_xml->node && m_xml->node->ToElement()) ? m_xml->node->Value() : AsciiStringView();
+    return (m_token == TokenType::StartElement || m_token == TokenType::EndElement) ? m_xml->name : AsciiStringView();
 }
 
 bool XmlStreamReader::hasAttribute(const char* name) const
@@ -298,11 +802,7 @@ bool XmlStreamReader::hasAttribute(const char* name) const
         return false;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return false;
-    }
-    return e->FindAttribute(name) != nullptr;
+    return m_xml->findAttr(name) != nullptr;
 }
 
 String XmlStreamReader::attribute(const char* name) const
@@ -311,11 +811,11 @@ String XmlStreamReader::attribute(const char* name) const
         return String();
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
+    const Xml::Attr* a = m_xml->findAttr(name);
+    if (!a) {
         return String();
     }
-    return String::fromUtf8(e->Attribute(name));
+    return String::fromUtf8(a->value);
 }
 
 String XmlStreamReader::attribute(const char* name, const String& def) const
@@ -329,11 +829,11 @@ AsciiStringView XmlStreamReader::asciiAttribute(const char* name) const
         return AsciiStringView();
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
+    const Xml::Attr* a = m_xml->findAttr(name);
+    if (!a) {
         return AsciiStringView();
     }
-    return e->Attribute(name);
+    return a->value;
 }
 
 AsciiStringView XmlStreamReader::asciiAttribute(const char* name, const AsciiStringView& def) const
@@ -368,15 +868,11 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
         return attrs;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return attrs;
-    }
-
-    for (const XMLAttribute* xa = e->FirstAttribute(); xa; xa = xa->Next()) {
+    attrs.reserve(m_xml->attrs.size());
+    for (const Xml::Attr& xa : m_xml->attrs) {
         Attribute a;
-        a.name = xa->Name();
-        a.value = String::fromUtf8(xa->Value());
+        a.name = xa.name;
+        a.value = String::fromUtf8(xa.value);
         attrs.push_back(std::move(a));
     }
     return attrs;
@@ -384,7 +880,7 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
 
 String XmlStreamReader::text() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
         return nodeValue(m_xml);
     }
     return String();
@@ -392,8 +888,8 @@ String XmlStreamReader::text() const
 
 AsciiStringView XmlStreamReader::asciiText() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
-        return m_xml->node->Value();
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
+        return AsciiStringView(m_xml->value, m_xml->valueSize);
     }
     return AsciiStringView();
 }
@@ -428,7 +924,7 @@ AsciiStringView XmlStreamReader::readAsciiText()
         while (1) {
             switch (readNext()) {
             case Characters:
-                result = AsciiStringView(m_xml->node->Value());
+                result = AsciiStringView(m_xml->value, m_xml->valueSize);
                 break;
             case EndElement:
                 return result;
@@ -458,12 +954,12 @@ double XmlStreamReader::readDouble(bool* ok)
 
 int64_t XmlStreamReader::lineNumber() const
 {
-    return m_xml->doc.ErrorLineNum();
+    return m_xml->parseError ? m_xml->line : m_xml->tokenLine;
 }
 
 int64_t XmlStreamReader::columnNumber() const
 {
-    return 0;
+    return m_xml->parseError ? 0 : m_xml->tokenColumn;
 }
 
 XmlStreamReader::Error XmlStreamReader::error() const
@@ -472,8 +968,7 @@ XmlStreamReader::Error XmlStreamReader::error() const
         return CustomError;
     }
 
-    XMLError err = m_xml->doc.ErrorID();
-    if (err == XML_SUCCESS) {
+    if (!m_xml->parseError) {
         return NoError;
     }
 
@@ -490,7 +985,7 @@ String XmlStreamReader::errorString() const
     if (!m_xml->customErr.empty()) {
         return m_xml->customErr;
     }
-    return String::fromUtf8(m_xml->doc.ErrorStr());
+    return m_xml->parseErr;
 }
 
 void XmlStreamReader::raiseError(const String& message)
@@ -66,6 +66,7 @@ public:
     };
 
     XmlStreamReader();
+    //! NOTE: The device is read as the document is parsed, so it must outlive the reader
     explicit XmlStreamReader(io::IODevice* device);
     explicit XmlStreamReader(const ByteArray& data);
 #ifndef NO_QT_SUPPORT
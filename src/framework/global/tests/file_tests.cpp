@@ -207,3 +207,47 @@ TEST_F(Global_IO_FileTests, FileTests_Exists_Append)
         EXPECT_EQ(refba, data);
     }
 }
+
+TEST_F(Global_IO_FileTests, FileTests_MapOnRead)
+{
+    path_t filePath("FileTests_MapOnRead.txt");
+    std::string ref = "Hello World!";
+    createFile(filePath, ref);
+
+    {
+        //! GIVEN File mapped for reading
+        File f(filePath);
+        f.setMapOnRead(true);
+
+        //! DO Open file
+        EXPECT_TRUE(f.open(IODevice::ReadOnly));
+
+        //! CHECK
+        EXPECT_EQ(f.size(), ref.size());
+
+        //! DO Read a part, then the rest
+        EXPECT_TRUE(f.seek(6));
+        ByteArray tail = f.read(6);
+        EXPECT_EQ(tail, ByteArray(reinterpret_cast<const uint8_t*>("World!"), 6));
+
+        EXPECT_TRUE(f.seek(0));
+        ByteArray all = f.readAll();
+        EXPECT_EQ(all, ByteArray(reinterpret_cast<const uint8_t*>(ref.c_str()), ref.size()));
+    }
+
+    {
+        //! GIVEN Empty file, it can't be mapped
+        path_t emptyFilePath("FileTests_MapOnRead_Empty.txt");
+        createFile(emptyFilePath, "");
+
+        File f(emptyFilePath);
+        f.setMapOnRead(true);
+
+        //! DO Open file
+        EXPECT_TRUE(f.open(IODevice::ReadOnly));
+
+        //! CHECK It's read the usual way
+        EXPECT_EQ(f.size(), 0);
+        EXPECT_TRUE(f.readAll().empty());
+    }
+}
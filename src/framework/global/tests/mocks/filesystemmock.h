@@ -44,6 +44,8 @@ public:
     MOCK_METHOD(Ret, readFile, (const io::path_t& filePath, ByteArray & data), (const, override));
     MOCK_METHOD(Ret, writeFile, (const io::path_t& filePath, const ByteArray& data), (const, override));
 
+    MOCK_METHOD(RetVal<FileMappingPtr>, mapFile, (const io::path_t& filePath), (const, override));
+
     MOCK_METHOD(Ret, makePath, (const io::path_t&), (const, override));
 
     MOCK_METHOD(RetVal<io::paths_t>, scanFiles, (const io::path_t&, const std::vector<std::string>&, ScanMode), (const, override));
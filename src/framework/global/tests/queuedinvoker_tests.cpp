@@ -0,0 +1,200 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "global/thirdparty/kors_async/async/internal/queuedinvoker.h"
+#include "global/thirdparty/kors_async/async/asyncable.h"
+#include "global/thirdparty/kors_async/async/channel.h"
+
+using namespace kors::async;
+
+class Global_Async_QueuedInvokerTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Global_Async_QueuedInvokerTests, Invoke_FromManyThreads)
+{
+    constexpr size_t PRODUCERS_COUNT = 4;
+    constexpr size_t FUNCTORS_PER_PRODUCER = 5000; // more than the preallocated cells, so the overflow may be used too
+
+    QueuedInvoker* invoker = QueuedInvoker::instance();
+
+    std::vector<size_t> lastValues(PRODUCERS_COUNT, 0);
+    std::atomic<size_t> calledCount = 0;
+    std::atomic<bool> isOrderBroken = false;
+    std::atomic<bool> isConsumerReady = false;
+
+    // [GIVEN] A thread, which processes its queued functors
+    std::thread::id consumerID;
+    std::thread consumer([&]() {
+        isConsumerReady = true;
+        while (calledCount < PRODUCERS_COUNT * FUNCTORS_PER_PRODUCER) {
+            invoker->processEvents();
+            std::this_thread::yield();
+        }
+    });
+    consumerID = consumer.get_id();
+
+    while (!isConsumerReady) {
+        std::this_thread::yield();
+    }
+
+    QueuedInvoker::QueueStats statsBefore = invoker->queueStats(consumerID);
+
+    // [WHEN] Several threads queue functors to it at the same time
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < PRODUCERS_COUNT; ++p) {
+        producers.emplace_back([&, p]() {
+            for (size_t i = 1; i <= FUNCTORS_PER_PRODUCER; ++i) {
+                invoker->invoke(consumerID, [&, p, i]() {
+                    if (lastValues[p] + 1 != i) {
+                        isOrderBroken = true;
+                    }
+                    lastValues[p] = i;
+                    ++calledCount;
+                });
+            }
+        });
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    consumer.join();
+
+    // [THEN] Every functor is called once, in the order of its producer
+    EXPECT_EQ(calledCount, PRODUCERS_COUNT * FUNCTORS_PER_PRODUCER);
+    EXPECT_FALSE(isOrderBroken);
+    for (size_t p = 0; p < PRODUCERS_COUNT; ++p) {
+        EXPECT_EQ(lastValues[p], FUNCTORS_PER_PRODUCER);
+    }
+
+    // [THEN] The stats count all of them
+    QueuedInvoker::QueueStats stats = invoker->queueStats(consumerID);
+    EXPECT_EQ(stats.invokedCount - statsBefore.invokedCount, PRODUCERS_COUNT * FUNCTORS_PER_PRODUCER);
+    EXPECT_EQ(stats.processedCount - statsBefore.processedCount, PRODUCERS_COUNT * FUNCTORS_PER_PRODUCER);
+    EXPECT_GT(stats.maxDepth, 0u);
+}
+
+TEST_F(Global_Async_QueuedInvokerTests, Channel_SendToAnotherThread)
+{
+    constexpr int ROUNDS_COUNT = 50;
+    constexpr int VALUES_PER_ROUND = 100; // more than the invokers kept for reuse
+
+    Channel<int> channel;
+
+    std::atomic<bool> isSubscribed = false;
+    std::atomic<bool> isDone = false;
+    std::atomic<int> receivedCount = 0;
+    std::atomic<bool> isOrderBroken = false;
+
+    // [GIVEN] A receiver on another thread
+    std::thread consumer([&]() {
+        Asyncable receiver;
+        int lastValue = 0;
+        channel.onReceive(&receiver, [&](int value) {
+            if (value != lastValue + 1) {
+                isOrderBroken = true;
+            }
+            lastValue = value;
+            ++receivedCount;
+        });
+
+        isSubscribed = true;
+
+        while (!isDone) {
+            QueuedInvoker::instance()->processEvents();
+            std::this_thread::yield();
+        }
+
+        QueuedInvoker::instance()->processEvents();
+    });
+
+    while (!isSubscribed) {
+        std::this_thread::yield();
+    }
+
+    // [WHEN] Values are sent in bursts, so the invokers are queued, called and reused again and again
+    int value = 0;
+    for (int round = 0; round < ROUNDS_COUNT; ++round) {
+        for (int i = 0; i < VALUES_PER_ROUND; ++i) {
+            channel.send(++value);
+        }
+
+        while (receivedCount < value) {
+            std::this_thread::yield();
+        }
+    }
+
+    isDone = true;
+    consumer.join();
+
+    // [THEN] Every value is received once, in order
+    EXPECT_EQ(receivedCount, ROUNDS_COUNT * VALUES_PER_ROUND);
+    EXPECT_FALSE(isOrderBroken);
+}
+
+TEST_F(Global_Async_QueuedInvokerTests, Channel_DestroyedWhileQueued)
+{
+    auto channel = std::make_unique<Channel<int> >();
+
+    std::atomic<bool> isSubscribed = false;
+    std::atomic<bool> isDestroyed = false;
+    std::atomic<int> receivedCount = 0;
+
+    // [GIVEN] A receiver on another thread, which doesn't process its queue yet
+    std::thread consumer([&]() {
+        Asyncable receiver;
+        channel->onReceive(&receiver, [&](int) {
+            ++receivedCount;
+        });
+
+        isSubscribed = true;
+
+        while (!isDestroyed) {
+            std::this_thread::yield();
+        }
+
+        QueuedInvoker::instance()->processEvents();
+    });
+
+    while (!isSubscribed) {
+        std::this_thread::yield();
+    }
+
+    // [WHEN] Values are queued to it and the channel is destroyed before they are processed
+    for (int i = 0; i < 10; ++i) {
+        channel->send(i);
+    }
+
+    channel.reset();
+    isDestroyed = true;
+    consumer.join();
+
+    // [THEN] The queued values are dropped
+    EXPECT_EQ(receivedCount, 0);
+}
@@ -0,0 +1,236 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "serialization/xmlstreamreader.h"
+#include "io/buffer.h"
+
+using namespace muse;
+using namespace muse::io;
+
+static std::string readTokens(XmlStreamReader& xml)
+{
+    std::string tokens;
+    while (!xml.atEnd()) {
+        XmlStreamReader::TokenType token = xml.readNext();
+        tokens += std::to_string(token) + " " + std::to_string(xml.lineNumber()) + ":" + std::to_string(xml.columnNumber());
+        tokens += " " + std::string(xml.name().ascii(), xml.name().size()) + " " + xml.text().toStdString();
+        for (const XmlStreamReader::Attribute& a : xml.attributes()) {
+            tokens += " " + std::string(a.name.ascii(), a.name.size()) + "=" + a.value.toStdString();
+        }
+        tokens += "\n";
+    }
+    return tokens;
+}
+
+class Global_Ser_XmlStreamReaderTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Global_Ser_XmlStreamReaderTests, ReadTokens)
+{
+    //! GIVEN Document with a declaration, attributes, entities, comments and an empty element
+    ByteArray data(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<museScore version=\"4.20\">\n"
+        "  <Staff id=\"1\" name='a &amp; b'/>\n"
+        "  <!-- comment -->\n"
+        "  <text>1 &lt; 2 &#65;</text>\n"
+        "</museScore>\n");
+
+    XmlStreamReader xml(data);
+
+    //! CHECK Tokens follow the document
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartDocument);
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.name(), "museScore");
+    EXPECT_EQ(xml.attribute("version"), u"4.20");
+    EXPECT_EQ(xml.lineNumber(), 2);
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.name(), "Staff");
+    EXPECT_EQ(xml.intAttribute("id"), 1);
+    EXPECT_EQ(xml.attribute("name"), u"a & b");
+    EXPECT_FALSE(xml.hasAttribute("type"));
+    EXPECT_EQ(xml.attributes().size(), 2);
+
+    //! CHECK The empty element is closed before the comment
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(xml.name(), "Staff");
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::Comment);
+    EXPECT_EQ(xml.text(), u" comment ");
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.name(), "text");
+    EXPECT_EQ(xml.readText(), u"1 < 2 A");
+    EXPECT_TRUE(xml.isEndElement());
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(xml.name(), "museScore");
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndDocument);
+    EXPECT_TRUE(xml.atEnd());
+    EXPECT_FALSE(xml.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, ReadValues)
+{
+    //! GIVEN Document with values and Windows line endings
+    ByteArray data("<a>\r\n<i>42</i>\r\n<d>0.5</d>\r\n<t>x\r\ny</t>\r\n<s></s><e/></a>");
+
+    XmlStreamReader xml(data);
+
+    //! CHECK Values are read, newlines are normalized
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "a");
+
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readInt(), 42);
+
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_DOUBLE_EQ(xml.readDouble(), 0.5);
+
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readText(), u"x\ny");
+
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_TRUE(xml.readText().isEmpty());
+
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "e");
+    EXPECT_TRUE(xml.readAsciiText().empty());
+
+    EXPECT_FALSE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "a");
+    EXPECT_FALSE(xml.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, SkipCurrentElement)
+{
+    //! GIVEN Document with nested elements
+    ByteArray data("<a><b><c>1</c><c/></b><d>2</d></a>");
+
+    XmlStreamReader xml(data);
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "b");
+
+    //! DO Skip the element
+    xml.skipCurrentElement();
+
+    //! CHECK The reader is at the next sibling
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "d");
+    EXPECT_EQ(xml.readText(), u"2");
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, DocumentEntities)
+{
+    //! GIVEN Document with a custom entity
+    ByteArray data(
+        "<?xml version=\"1.0\"?>\n"
+        "<!ENTITY mu \"MuseScore\">\n"
+        "<a>&mu; 4</a>\n");
+
+    XmlStreamReader xml(data);
+
+    //! CHECK The entity is replaced in texts
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartDocument);
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::DTD);
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readText(), u"MuseScore 4");
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, NotWellFormed)
+{
+    //! GIVEN Document with a mismatched end tag
+    ByteArray data("<a>\n<b>\n</a>\n");
+
+    XmlStreamReader xml(data);
+
+    //! CHECK Tokens are read until the error
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::Invalid);
+
+    //! CHECK The error is reported with the line
+    EXPECT_TRUE(xml.atEnd());
+    EXPECT_EQ(xml.error(), XmlStreamReader::NotWellFormedError);
+    EXPECT_EQ(xml.lineNumber(), 3);
+
+    //! GIVEN Document ending inside an element
+    xml.setData(ByteArray("<a><b></b>"));
+
+    //! CHECK The error is reported
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_FALSE(xml.readNextStartElement());
+    EXPECT_FALSE(xml.readNextStartElement());
+    EXPECT_TRUE(xml.isError());
+}
+
+TEST_F(Global_Ser_XmlStreamReaderTests, ReadFromDevice)
+{
+    //! GIVEN Document bigger than the blocks read from a device, with tokens of every kind cut by the blocks
+    std::string doc = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<!ENTITY mu \"MuseScore\">\n<museScore>\n";
+    for (int i = 0; i < 5000; ++i) {
+        std::string n = std::to_string(i);
+        doc += "  <Chord id=\"" + n + "\" name='a &amp; " + std::string(i % 7, 'b') + "'>\r\n";
+        doc += "    <text>" + n + " &lt; &mu; &#65;" + std::string(i % 5, ' ') + "</text>\n";
+        doc += "    <!-- comment " + n + " --><![CDATA[" + n + "]]>\n";
+        doc += "    <empty" + std::string(i % 3, ' ') + "/>\n";
+        doc += "  </Chord" + std::string(i % 2, ' ') + ">\n";
+    }
+    doc += "  <long>" + std::string(100000, 'x') + "</long>\n";
+    doc += "</museScore>\n";
+
+    ByteArray data(doc.c_str());
+    ASSERT_GT(data.size(), 200000);
+
+    //! DO Read it from the data and from a device
+    XmlStreamReader dataXml(data);
+    std::string expected = readTokens(dataXml);
+
+    Buffer buf(ByteArray(doc.c_str()));
+    buf.open(IODevice::ReadOnly);
+    XmlStreamReader deviceXml(&buf);
+    std::string tokens = readTokens(deviceXml);
+
+    //! CHECK The same tokens are read, at the same positions
+    EXPECT_FALSE(dataXml.isError());
+    EXPECT_FALSE(deviceXml.isError());
+    EXPECT_EQ(tokens, expected);
+
+    //! GIVEN The document ending inside an element
+    doc.resize(doc.size() - std::string("</museScore>\n").size());
+
+    Buffer truncated(ByteArray(doc.c_str()));
+    truncated.open(IODevice::ReadOnly);
+    XmlStreamReader truncatedXml(&truncated);
+    readTokens(truncatedXml);
+
+    //! CHECK The error is reported
+    EXPECT_TRUE(truncatedXml.isError());
+}
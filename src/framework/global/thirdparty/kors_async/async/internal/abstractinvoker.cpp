@@ -30,14 +30,32 @@ SOFTWARE.
 using namespace kors::async;
 
 AbstractInvoker::AbstractInvoker()
+    : m_qInvokerPool(std::make_shared<QInvokerPool>())
 {
+    m_qInvokerPool->invoker = this;
 }
 
 AbstractInvoker::~AbstractInvoker()
 {
-    std::lock_guard<std::mutex> lock(m_qInvokersMutex);
-    for (QInvoker* qi : m_qInvokers) {
-        qi->invalidate();
+    QInvoker* free = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_qInvokerPool->mutex);
+        m_qInvokerPool->invoker = nullptr;
+
+        //! NOTE The queued ones are released by the queue, after they are called
+        for (QInvoker* qi = m_qInvokerPool->queued; qi; qi = qi->next) {
+            qi->isValid = false;
+        }
+
+        free = m_qInvokerPool->free;
+        m_qInvokerPool->free = nullptr;
+        m_qInvokerPool->freeCount = 0;
+    }
+
+    while (free) {
+        QInvoker* next = free->next;
+        delete free;
+        free = next;
     }
 }
 
@@ -66,15 +84,93 @@ void AbstractInvoker::invoke(int type, const NotifyData& data)
         if (c.threadID == threadID) {
             invokeCallback(type, c, data);
         } else {
-            QInvoker* qi = new QInvoker(this, type, c, data);
+            QInvoker* qi = takeQInvoker(type, c, data);
             QueuedInvoker::instance()->invoke(c.threadID, [qi]() {
-                qi->invoke();
-                delete qi;
+                invokeQInvoker(qi);
             });
         }
     }
 }
 
+AbstractInvoker::QInvoker* AbstractInvoker::takeQInvoker(int type, const CallBack& c, const NotifyData& data)
+{
+    QInvokerPool* pool = m_qInvokerPool.get();
+    std::lock_guard<std::mutex> lock(pool->mutex);
+
+    QInvoker* qi = pool->free;
+    if (qi) {
+        pool->free = qi->next;
+        --pool->freeCount;
+    } else {
+        qi = new QInvoker();
+        qi->pool = m_qInvokerPool;
+    }
+
+    qi->type = type;
+    qi->call = c;
+    qi->data = data;
+    qi->isValid = true;
+
+    qi->prev = nullptr;
+    qi->next = pool->queued;
+    if (pool->queued) {
+        pool->queued->prev = qi;
+    }
+    pool->queued = qi;
+
+    return qi;
+}
+
+void AbstractInvoker::invokeQInvoker(QInvoker* qi)
+{
+    AbstractInvoker* inv = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(qi->pool->mutex);
+        if (qi->isValid) {
+            inv = qi->pool->invoker;
+        }
+    }
+
+    if (inv) {
+        inv->invokeCallback(qi->type, qi->call, qi->data);
+    }
+
+    releaseQInvoker(qi);
+}
+
+void AbstractInvoker::releaseQInvoker(QInvoker* qi)
+{
+    QInvokerPool* pool = qi->pool.get();
+    bool isReused = false;
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+
+        if (qi->prev) {
+            qi->prev->next = qi->next;
+        } else {
+            pool->queued = qi->next;
+        }
+
+        if (qi->next) {
+            qi->next->prev = qi->prev;
+        }
+
+        if (pool->invoker && pool->freeCount < QInvokerPool::MAX_FREE_COUNT) {
+            qi->data.clear();
+            qi->prev = nullptr;
+            qi->next = pool->free;
+            pool->free = qi;
+            ++pool->freeCount;
+            isReused = true;
+        }
+    }
+
+    //! NOTE May release the last reference to the pool, so it's done outside of the lock
+    if (!isReused) {
+        delete qi;
+    }
+}
+
 void AbstractInvoker::invokeCallback(int type, const CallBack& c, const NotifyData& data)
 {
     assert(c.threadID == std::this_thread::get_id());
@@ -146,11 +242,10 @@ void AbstractInvoker::removeCallBack(int type, Asyncable* receiver)
     callbacks.erase(callbacks.begin() + index);
 
     {
-        std::lock_guard<std::mutex> lock(m_qInvokersMutex);
-        for (QInvoker* qi : m_qInvokers) {
+        std::lock_guard<std::mutex> lock(m_qInvokerPool->mutex);
+        for (QInvoker* qi = m_qInvokerPool->queued; qi; qi = qi->next) {
             if (qi->call.call == c.call) {
-                qi->invalidate();
-                break;
+                qi->isValid = false;
             }
         }
     }
@@ -210,18 +305,6 @@ void AbstractInvoker::disconnectAsync(Asyncable* receiver)
     }
 }
 
-void AbstractInvoker::addQInvoker(QInvoker* qi)
-{
-    std::lock_guard<std::mutex> lock(m_qInvokersMutex);
-    m_qInvokers.push_back(qi);
-}
-
-void AbstractInvoker::removeQInvoker(QInvoker* qi)
-{
-    std::lock_guard<std::mutex> lock(m_qInvokersMutex);
-    m_qInvokers.remove(qi);
-}
-
 bool AbstractInvoker::containsReceiver(Asyncable* receiver) const
 {
     for (auto it = m_callbacks.begin(); it != m_callbacks.end(); ++it) {
@@ -70,6 +70,12 @@ public:
         return d->val;
     }
 
+    //! NOTE Keeps the capacity, so a reused NotifyData doesn't allocate for the same count of args
+    void clear()
+    {
+        m_args.clear();
+    }
+
     struct IArg {
         virtual ~IArg() = default;
     };
@@ -123,62 +129,51 @@ protected:
         bool containsReceiver(Asyncable* receiver) const;
     };
 
+    //! NOTE Carries a notification to a receiver on another thread.
+    //! The QInvokers are reused through the pool of their AbstractInvoker, so a cross-thread
+    //! notification doesn't allocate them once the pool has warmed up.
+    //! The pool is shared with the queued QInvokers, so it outlives the AbstractInvoker while they are in the queue.
+    struct QInvokerPool;
+
     struct QInvoker
     {
-        std::mutex mutex;
-        AbstractInvoker* invoker = nullptr;
+        std::shared_ptr<QInvokerPool> pool;
         int type = -1;
         CallBack call;
         NotifyData data;
+        bool isValid = true;
 
-        QInvoker(AbstractInvoker* i, int t, CallBack c, NotifyData d)
-            : invoker(i), type(t), call(c), data(d)
-        {
-            invoker->addQInvoker(this);
-        }
-
-        ~QInvoker()
-        {
-            if (invoker) {
-                invoker->removeQInvoker(this);
-            }
-        }
+        // intrusive links of the pool lists
+        QInvoker* prev = nullptr;
+        QInvoker* next = nullptr;
+    };
 
-        void invoke()
-        {
-            AbstractInvoker* inv = nullptr;
-            {
-                std::lock_guard<std::mutex> lock(mutex);
-                inv = invoker;
-            }
-
-            if (inv) {
-                inv->invokeCallback(type, call, data);
-            }
-        }
+    struct QInvokerPool
+    {
+        static constexpr size_t MAX_FREE_COUNT = 64;
 
-        void invalidate()
-        {
-            std::lock_guard<std::mutex> lock(mutex);
-            invoker = nullptr;
-        }
+        std::mutex mutex;
+        AbstractInvoker* invoker = nullptr;
+        QInvoker* queued = nullptr;
+        QInvoker* free = nullptr;
+        size_t freeCount = 0;
     };
 
+    QInvoker* takeQInvoker(int type, const CallBack& c, const NotifyData& data);
+    static void invokeQInvoker(QInvoker* qi);
+    static void releaseQInvoker(QInvoker* qi);
+
     void invokeCallback(int type, const CallBack& c, const NotifyData& data);
 
     void addCallBack(int type, Asyncable* receiver, void* call, Asyncable::AsyncMode mode = Asyncable::AsyncMode::AsyncSetRepeat);
     void removeCallBack(int type, Asyncable* receiver);
     void removeAllCallBacks();
 
-    void addQInvoker(QInvoker* qi);
-    void removeQInvoker(QInvoker* qi);
-
     bool containsReceiver(Asyncable* receiver) const;
 
     std::map<int /*type*/, CallBacks > m_callbacks;
 
-    std::mutex m_qInvokersMutex;
-    std::list<QInvoker*> m_qInvokers;
+    std::shared_ptr<QInvokerPool> m_qInvokerPool;
 };
 }
 
@@ -23,42 +23,233 @@ SOFTWARE.
 */
 #include "queuedinvoker.h"
 
+#include <chrono>
+#include <deque>
+
 using namespace kors::async;
 
+// ====================================================
+// Queue
+// ====================================================
+
+//! NOTE Bounded multi producer, single consumer queue (D. Vyukov's algorithm) of preallocated cells.
+//! Functors of the invokers capture a pointer or two, so they fit the small buffer of std::function
+//! and moving them into a cell doesn't allocate.
+//! If all cells are busy, functors go to a locked overflow list until the consumer drains it,
+//! this keeps the order for every producer.
+class QueuedInvoker::Queue
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t CAPACITY = 1024; // must be a power of two
+    static constexpr size_t INDEX_MASK = CAPACITY - 1;
+
+    explicit Queue(const std::thread::id& th)
+        : m_threadID(th), m_cells(CAPACITY)
+    {
+        for (size_t i = 0; i < CAPACITY; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    const std::thread::id& threadID() const
+    {
+        return m_threadID;
+    }
+
+    // any thread
+    void push(Functor&& f)
+    {
+        Clock::time_point now = Clock::now();
+
+        if (!m_isOverflowed.load(std::memory_order_acquire) && tryPush(f, now)) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_overflowMutex);
+        if (!m_isOverflowed.load(std::memory_order_relaxed) && tryPush(f, now)) {
+            return;
+        }
+
+        m_isOverflowed.store(true, std::memory_order_release);
+        m_overflow.push_back({ std::move(f), now });
+        m_overflowCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // only the queue thread
+    void process()
+    {
+        //! NOTE Functors queued by the called functors wait for the next call
+        size_t pending = m_enqueuePos.load(std::memory_order_acquire) - m_dequeuePos.load(std::memory_order_relaxed);
+        updateMaxDepth(pending);
+
+        Functor f;
+        Clock::time_point time;
+        for (size_t i = 0; i < pending && tryPop(f, time); ++i) {
+            call(f, time);
+        }
+
+        if (!m_isOverflowed.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        std::deque<Entry> overflow;
+        {
+            std::lock_guard<std::mutex> lock(m_overflowMutex);
+
+            // the cells have been queued before the overflow, so they go first
+            if (m_dequeuePos.load(std::memory_order_relaxed) != m_enqueuePos.load(std::memory_order_acquire)) {
+                return;
+            }
+
+            overflow.swap(m_overflow);
+            m_isOverflowed.store(false, std::memory_order_release);
+        }
+
+        updateMaxDepth(overflow.size());
+
+        for (Entry& e : overflow) {
+            call(e.functor, e.time);
+        }
+    }
+
+    QueueStats stats() const
+    {
+        QueueStats s;
+        s.overflowCount = m_overflowCount.load(std::memory_order_relaxed);
+        s.invokedCount = m_enqueuePos.load(std::memory_order_relaxed) + s.overflowCount;
+        s.processedCount = m_processedCount.load(std::memory_order_relaxed);
+        s.maxDepth = m_maxDepth.load(std::memory_order_relaxed);
+        s.maxLatencyUs = m_maxLatencyUs.load(std::memory_order_relaxed);
+        s.totalLatencyUs = m_totalLatencyUs.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence = 0;
+        Clock::time_point time;
+        Functor functor;
+    };
+
+    struct Entry {
+        Functor functor;
+        Clock::time_point time;
+    };
+
+    bool tryPush(Functor& f, const Clock::time_point& time)
+    {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & INDEX_MASK];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.functor = std::move(f);
+                    cell.time = time;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(Functor& f, Clock::time_point& time)
+    {
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        Cell& cell = m_cells[pos & INDEX_MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+            return false; // empty, or the producer hasn't finished writing yet
+        }
+
+        f = std::move(cell.functor);
+        cell.functor = nullptr;
+        time = cell.time;
+
+        cell.sequence.store(pos + CAPACITY, std::memory_order_release);
+        m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void call(Functor& f, const Clock::time_point& time)
+    {
+        uint64_t latencyUs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - time).count());
+
+        m_totalLatencyUs.store(m_totalLatencyUs.load(std::memory_order_relaxed) + latencyUs, std::memory_order_relaxed);
+        if (latencyUs > m_maxLatencyUs.load(std::memory_order_relaxed)) {
+            m_maxLatencyUs.store(latencyUs, std::memory_order_relaxed);
+        }
+
+        if (f) {
+            f();
+        }
+        f = nullptr;
+
+        m_processedCount.store(m_processedCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void updateMaxDepth(size_t depth)
+    {
+        if (depth > m_maxDepth.load(std::memory_order_relaxed)) {
+            m_maxDepth.store(depth, std::memory_order_relaxed);
+        }
+    }
+
+    const std::thread::id m_threadID;
+    std::vector<Cell> m_cells;
+
+    alignas(64) std::atomic<size_t> m_enqueuePos = 0;
+    alignas(64) std::atomic<size_t> m_dequeuePos = 0;
+
+    // written by the queue thread only
+    std::atomic<uint64_t> m_processedCount = 0;
+    std::atomic<uint64_t> m_maxDepth = 0;
+    std::atomic<uint64_t> m_maxLatencyUs = 0;
+    std::atomic<uint64_t> m_totalLatencyUs = 0;
+
+    alignas(64) std::atomic<bool> m_isOverflowed = false;
+    std::mutex m_overflowMutex;
+    std::deque<Entry> m_overflow;
+    std::atomic<uint64_t> m_overflowCount = 0;
+};
+
+// ====================================================
+// QueuedInvoker
+// ====================================================
+
 QueuedInvoker* QueuedInvoker::instance()
 {
     static QueuedInvoker i;
     return &i;
 }
 
-void QueuedInvoker::invoke(const std::thread::id& callbackTh, const Functor& f, bool isAlwaysQueued)
+QueuedInvoker::~QueuedInvoker() = default;
+
+void QueuedInvoker::invoke(const std::thread::id& callbackTh, Functor f, bool isAlwaysQueued)
 {
     if (m_onMainThreadInvoke) {
         if (callbackTh == m_mainThreadID) {
             m_onMainThreadInvoke(f, isAlwaysQueued);
+            return;
         }
     }
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    m_queues[callbackTh].push(f);
+    findOrAddQueue(callbackTh)->push(std::move(f));
 }
 
 void QueuedInvoker::processEvents()
 {
-    Queue q;
-    {
-        std::lock_guard<std::recursive_mutex> lock(m_mutex);
-        auto n = m_queues.extract(std::this_thread::get_id());
-        if (!n.empty()) {
-            q = n.mapped();
-        }
-    }
-    while (!q.empty()) {
-        const auto& f = q.front();
-        if (f) {
-            f();
-        }
-        q.pop();
+    Queue* q = findQueue(std::this_thread::get_id());
+    if (q) {
+        q->process();
     }
 }
 
@@ -67,3 +258,50 @@ void QueuedInvoker::onMainThreadInvoke(const std::function<void(const std::funct
     m_onMainThreadInvoke = f;
     m_mainThreadID = std::this_thread::get_id();
 }
+
+QueuedInvoker::QueueStats QueuedInvoker::queueStats(const std::thread::id& th) const
+{
+    const Queue* q = findQueue(th);
+    return q ? q->stats() : QueueStats();
+}
+
+QueuedInvoker::Queue* QueuedInvoker::findQueue(const std::thread::id& th) const
+{
+    const Queues* queues = m_queues.load(std::memory_order_acquire);
+    if (!queues) {
+        return nullptr;
+    }
+
+    for (Queue* q : *queues) {
+        if (q->threadID() == th) {
+            return q;
+        }
+    }
+
+    return nullptr;
+}
+
+QueuedInvoker::Queue* QueuedInvoker::findOrAddQueue(const std::thread::id& th)
+{
+    if (Queue* q = findQueue(th)) {
+        return q;
+    }
+
+    std::lock_guard<std::mutex> lock(m_addQueueMutex);
+    if (Queue* q = findQueue(th)) {
+        return q;
+    }
+
+    m_ownedQueues.push_back(std::make_unique<Queue>(th));
+    Queue* q = m_ownedQueues.back().get();
+
+    //! NOTE Previous lists may still be read by other threads, so they are kept
+    const Queues* current = m_queues.load(std::memory_order_relaxed);
+    auto queues = std::make_unique<Queues>(current ? *current : Queues());
+    queues->push_back(q);
+
+    m_queues.store(queues.get(), std::memory_order_release);
+    m_queuesSnapshots.push_back(std::move(queues));
+
+    return q;
+}
@@ -24,11 +24,13 @@ SOFTWARE.
 #ifndef KORS_ASYNC_QUEUEDINVOKER_H
 #define KORS_ASYNC_QUEUEDINVOKER_H
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
-#include <queue>
-#include <map>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace kors::async {
 class QueuedInvoker
@@ -39,18 +41,37 @@ public:
 
     using Functor = std::function<void ()>;
 
-    void invoke(const std::thread::id& th, const Functor& f, bool isAlwaysQueued = false);
+    struct QueueStats {
+        uint64_t invokedCount = 0;
+        uint64_t processedCount = 0;
+        uint64_t overflowCount = 0;     // invoked while all preallocated cells were busy
+        uint64_t maxDepth = 0;          // the most pending functors seen by processEvents
+        uint64_t maxLatencyUs = 0;      // from invoke to call
+        uint64_t totalLatencyUs = 0;
+    };
+
+    void invoke(const std::thread::id& th, Functor f, bool isAlwaysQueued = false);
     void processEvents();
     void onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f);
 
+    QueueStats queueStats(const std::thread::id& th) const;
+
 private:
 
     QueuedInvoker() = default;
+    ~QueuedInvoker();
+
+    class Queue;
+    using Queues = std::vector<Queue*>;
 
-    using Queue = std::queue<Functor>;
+    Queue* findQueue(const std::thread::id& th) const;
+    Queue* findOrAddQueue(const std::thread::id& th);
 
-    std::recursive_mutex m_mutex;
-    std::map<std::thread::id, Queue > m_queues;
+    // queues are only added, readers take a snapshot of the list without locking
+    std::atomic<const Queues*> m_queues = nullptr;
+    std::mutex m_addQueueMutex;
+    std::vector<std::unique_ptr<Queue> > m_ownedQueues;
+    std::vector<std::unique_ptr<const Queues> > m_queuesSnapshots;
 
     std::function<void(const std::function<void()>&, bool)> m_onMainThreadInvoke;
     std::thread::id m_mainThreadID;
@@ -47,7 +47,28 @@ using PlaybackParamList = std::vector<PlaybackParam>;
 using PlaybackParamMap = std::map<timestamp_t, PlaybackParamList>;
 using PlaybackParamLayers = std::map<layer_idx_t, PlaybackParamMap>;
 
+//! NOTE: An inclusive range of origin timestamps (the keys of PlaybackEventsMap)
+struct TimestampRange {
+    timestamp_t from = 0;
+    timestamp_t to = 0;
+
+    bool contains(const timestamp_t timestamp) const
+    {
+        return timestamp >= from && timestamp <= to;
+    }
+
+    bool operator==(const TimestampRange& other) const
+    {
+        return from == other.from && to == other.to;
+    }
+};
+
+using TimestampRangeList = std::vector<TimestampRange>;
+
 using MainStreamChanges = async::Channel<PlaybackEventsMap, DynamicLevelLayers, PlaybackParamLayers>;
+//! NOTE: Carries only the events within the changed ranges: the receiver drops
+//! its events from these ranges and takes the sent ones instead
+using MainStreamRangeChanges = async::Channel<TimestampRangeList, PlaybackEventsMap, DynamicLevelLayers, PlaybackParamLayers>;
 using OffStreamChanges = async::Channel<PlaybackEventsMap, PlaybackParamList>;
 
 struct ArrangementContext
@@ -319,6 +340,7 @@ struct PlaybackData {
     PlaybackParamLayers params;
 
     MainStreamChanges mainStream;
+    MainStreamRangeChanges mainStreamRanges;
     OffStreamChanges offStream;
 
     bool operator==(const PlaybackData& other) const
@@ -334,6 +356,33 @@ struct PlaybackData {
         return setupData.isValid();
     }
 };
+
+inline bool containsTimestamp(const TimestampRangeList& ranges, const timestamp_t timestamp)
+{
+    for (const TimestampRange& range : ranges) {
+        if (range.contains(timestamp)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//! NOTE: Applies the changes received via MainStreamRangeChanges to a full copy of the events
+inline void applyRangeChanges(PlaybackEventsMap& destination, const TimestampRangeList& ranges, const PlaybackEventsMap& events)
+{
+    for (const TimestampRange& range : ranges) {
+        if (range.from > range.to) {
+            continue;
+        }
+
+        destination.erase(destination.lower_bound(range.from), destination.upper_bound(range.to));
+    }
+
+    for (const auto& pair : events) {
+        destination.insert_or_assign(pair.first, pair.second);
+    }
+}
 }
 
 #endif // MUSE_MPE_EVENTS_H
@@ -155,15 +155,16 @@ void MuseSamplerSequencer::updateOffStreamEvents(const PlaybackEventsMap& events
             AuditionStartNoteEvent noteOn;
             noteOn.msEvent = { pitch, centsOffset, articulationFlag, notehead, 0.5, presets_cstr, textArticulation_cstr };
             noteOn.msTrack = track;
-            m_offStreamEvents[timestampFrom].emplace(std::move(noteOn));
+            m_offStreamEvents.add(timestampFrom, std::move(noteOn));
 
             AuditionStopNoteEvent noteOff;
             noteOff.msEvent = { pitch };
             noteOff.msTrack = track;
-            m_offStreamEvents[timestampTo].emplace(std::move(noteOff));
+            m_offStreamEvents.add(timestampTo, std::move(noteOff));
         }
     }
 
+    m_offStreamEvents.finalize();
     updateOffSequenceIterator();
 }
 
@@ -174,6 +175,8 @@ void MuseSamplerSequencer::updateMainStreamEvents(const PlaybackEventsMap& event
         return;
     }
 
+    m_originEvents = events;
+
     clearAllTracks();
 
     loadNoteEvents(events);
@@ -183,6 +186,26 @@ void MuseSamplerSequencer::updateMainStreamEvents(const PlaybackEventsMap& event
     finalizeAllTracks();
 }
 
+void MuseSamplerSequencer::updateMainStreamEvents(const TimestampRangeList& ranges, const PlaybackEventsMap& events,
+                                                  const DynamicLevelLayers& dynamics, const PlaybackParamLayers& params)
+{
+    IF_ASSERT_FAILED(m_samplerLib && m_sampler) {
+        return;
+    }
+
+    //! NOTE: The sampler tracks can only be refilled as a whole,
+    //! so the changes are applied to the local copy of the events
+    applyRangeChanges(m_originEvents, ranges, events);
+
+    clearAllTracks();
+
+    loadNoteEvents(m_originEvents);
+    loadParams(params);
+    loadDynamicEvents(dynamics);
+
+    finalizeAllTracks();
+}
+
 void MuseSamplerSequencer::clearAllTracks()
 {
     m_layerIdxToTrackIdx.clear();
@@ -69,6 +69,8 @@ public:
     void updateOffStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::PlaybackParamList& params) override;
     void updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
                                 const mpe::PlaybackParamLayers& params) override;
+    void updateMainStreamEvents(const mpe::TimestampRangeList& ranges, const mpe::PlaybackEventsMap& events,
+                                const mpe::DynamicLevelLayers& dynamics, const mpe::PlaybackParamLayers& params) override;
 
 private:
     void clearAllTracks();
@@ -104,6 +106,8 @@ private:
 
     std::unordered_map<mpe::layer_idx_t, track_idx_t> m_layerIdxToTrackIdx;
 
+    mpe::PlaybackEventsMap m_originEvents;
+
     struct {
         std::string presets;
         std::string textArticulation;
@@ -62,6 +62,7 @@ void VstSequencer::updateOffStreamEvents(const mpe::PlaybackEventsMap& events, c
     }
 
     updatePlaybackEvents(m_offStreamEvents, events);
+    m_offStreamEvents.finalize();
     updateOffSequenceIterator();
 }
 
@@ -83,9 +84,38 @@ void VstSequencer::updateMainStreamEvents(const mpe::PlaybackEventsMap& events,
     }
 
     updatePlaybackEvents(m_mainStreamEvents, events);
+    m_mainStreamEvents.finalize();
     updateMainSequenceIterator();
 
     updateDynamicEvents(m_dynamicEvents, dynamics);
+    m_dynamicEvents.finalize();
+    updateDynamicChangesIterator();
+}
+
+void VstSequencer::updateMainStreamEvents(const mpe::TimestampRangeList& ranges, const mpe::PlaybackEventsMap& events,
+                                          const mpe::DynamicLevelLayers& dynamics, const mpe::PlaybackParamLayers&)
+{
+    m_dynamicLevelLayers = dynamics;
+
+    if (!m_inited) {
+        mpe::applyRangeChanges(m_playbackEventsMap, ranges, events);
+        return;
+    }
+
+    m_dynamicEvents.clear();
+
+    if (m_onMainStreamFlushed) {
+        m_onMainStreamFlushed();
+    }
+
+    updatePlaybackEvents(m_mainStreamEvents, events);
+    m_mainStreamEvents.replace([&ranges](const mpe::timestamp_t origin) {
+        return mpe::containsTimestamp(ranges, origin);
+    });
+    updateMainSequenceIterator();
+
+    updateDynamicEvents(m_dynamicEvents, dynamics);
+    m_dynamicEvents.finalize();
     updateDynamicChangesIterator();
 }
 
@@ -95,7 +125,7 @@ muse::audio::gain_t VstSequencer::currentGain() const
     return expressionLevel(currentDynamicLevel);
 }
 
-void VstSequencer::updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& events)
+void VstSequencer::updatePlaybackEvents(EventTimeline& destination, const mpe::PlaybackEventsMap& events)
 {
     for (const auto& pair : events) {
         for (const mpe::PlaybackEvent& event : pair.second) {
@@ -112,25 +142,25 @@ void VstSequencer::updatePlaybackEvents(EventSequenceMap& destination, const mpe
             float velocityFraction = noteVelocityFraction(noteEvent);
             float tuning = noteTuning(noteEvent, noteId);
 
-            destination[timestampFrom].emplace(buildEvent(VstEvent::kNoteOnEvent, noteId, velocityFraction, tuning));
-            destination[timestampTo].emplace(buildEvent(VstEvent::kNoteOffEvent, noteId, velocityFraction, tuning));
+            destination.add(timestampFrom, buildEvent(VstEvent::kNoteOnEvent, noteId, velocityFraction, tuning), pair.first);
+            destination.add(timestampTo, buildEvent(VstEvent::kNoteOffEvent, noteId, velocityFraction, tuning), pair.first);
 
-            appendControlSwitch(destination, noteEvent, PEDAL_CC_SUPPORTED_TYPES, SUSTAIN_IDX);
-            appendPitchBend(destination, noteEvent, BEND_SUPPORTED_TYPES);
+            appendControlSwitch(destination, noteEvent, pair.first, PEDAL_CC_SUPPORTED_TYPES, SUSTAIN_IDX);
+            appendPitchBend(destination, noteEvent, pair.first, BEND_SUPPORTED_TYPES);
         }
     }
 }
 
-void VstSequencer::updateDynamicEvents(EventSequenceMap& destination, const mpe::DynamicLevelLayers& layers)
+void VstSequencer::updateDynamicEvents(EventTimeline& destination, const mpe::DynamicLevelLayers& layers)
 {
     for (const auto& layer : layers) {
         for (const auto& dynamic : layer.second) {
-            destination[dynamic.first].emplace(expressionLevel(dynamic.second));
+            destination.add(dynamic.first, expressionLevel(dynamic.second));
         }
     }
 }
 
-void VstSequencer::appendControlSwitch(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent,
+void VstSequencer::appendControlSwitch(EventTimeline& destination, const mpe::NoteEvent& noteEvent, const mpe::timestamp_t origin,
                                        const mpe::ArticulationTypeSet& appliableTypes, const ControllIdx controlIdx)
 {
     auto controlIt = m_mapping.find(controlIdx);
@@ -154,11 +184,11 @@ void VstSequencer::appendControlSwitch(EventSequenceMap& destination, const mpe:
     const mpe::ArticulationAppliedData& articulationData = noteEvent.expressionCtx().articulations.at(currentType);
     const mpe::ArticulationMeta& articulationMeta = articulationData.meta;
 
-    destination[noteEvent.arrangementCtx().actualTimestamp].emplace(buildParamInfo(controlIt->second, 1 /*on*/));
-    destination[articulationMeta.timestamp + articulationMeta.overallDuration].emplace(buildParamInfo(controlIt->second, 0 /*off*/));
+    destination.add(noteEvent.arrangementCtx().actualTimestamp, buildParamInfo(controlIt->second, 1 /*on*/), origin);
+    destination.add(articulationMeta.timestamp + articulationMeta.overallDuration, buildParamInfo(controlIt->second, 0 /*off*/), origin);
 }
 
-void VstSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent,
+void VstSequencer::appendPitchBend(EventTimeline& destination, const mpe::NoteEvent& noteEvent, const mpe::timestamp_t origin,
                                    const mpe::ArticulationTypeSet& appliableTypes)
 {
     auto pitchBendIt = m_mapping.find(PITCH_BEND_IDX);
@@ -186,7 +216,7 @@ void VstSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::Not
     PluginParamInfo event;
     event.id = pitchBendIt->second;
     event.defaultNormalizedValue = 0.5f;
-    destination[timestampTo].insert(event);
+    destination.add(timestampTo, event, origin);
 
     auto currIt = noteEvent.pitchCtx().pitchCurve.cbegin();
     auto nextIt = std::next(currIt);
@@ -219,7 +249,7 @@ void VstSequencer::appendPitchBend(EventSequenceMap& destination, const mpe::Not
             if (time < timestampTo) {
                 float bendValue = static_cast<float>(point.y);
                 event.defaultNormalizedValue = bendValue;
-                destination[time].insert(event);
+                destination.add(time, event, origin);
             }
         }
     }
@@ -62,16 +62,19 @@ public:
     void updateOffStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::PlaybackParamList& params) override;
     void updateMainStreamEvents(const mpe::PlaybackEventsMap& events, const mpe::DynamicLevelLayers& dynamics,
                                 const mpe::PlaybackParamLayers& params) override;
+    void updateMainStreamEvents(const mpe::TimestampRangeList& ranges, const mpe::PlaybackEventsMap& events,
+                                const mpe::DynamicLevelLayers& dynamics, const mpe::PlaybackParamLayers& params) override;
 
     muse::audio::gain_t currentGain() const;
 
 private:
-    void updatePlaybackEvents(EventSequenceMap& destination, const mpe::PlaybackEventsMap& events);
-    void updateDynamicEvents(EventSequenceMap& destination, const mpe::DynamicLevelLayers& layers);
+    void updatePlaybackEvents(EventTimeline& destination, const mpe::PlaybackEventsMap& events);
+    void updateDynamicEvents(EventTimeline& destination, const mpe::DynamicLevelLayers& layers);
 
-    void appendControlSwitch(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationTypeSet& appliableTypes,
-                             const ControllIdx controlIdx);
-    void appendPitchBend(EventSequenceMap& destination, const mpe::NoteEvent& noteEvent, const mpe::ArticulationTypeSet& appliableTypes);
+    void appendControlSwitch(EventTimeline& destination, const mpe::NoteEvent& noteEvent, const mpe::timestamp_t origin,
+                             const mpe::ArticulationTypeSet& appliableTypes, const ControllIdx controlIdx);
+    void appendPitchBend(EventTimeline& destination, const mpe::NoteEvent& noteEvent, const mpe::timestamp_t origin,
+                         const mpe::ArticulationTypeSet& appliableTypes);
 
     VstEvent buildEvent(const Steinberg::Vst::Event::EventTypes type, const int32_t noteIdx, const float velocityFraction,
                         const float tuning) const;
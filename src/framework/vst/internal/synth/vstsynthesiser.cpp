@@ -190,7 +190,7 @@ muse::audio::samples_t VstSynthesiser::process(float* buffer, muse::audio::sampl
     }
 
     muse::audio::msecs_t nextMsecs = samplesToMsecs(samplesPerChannel, m_sampleRate);
-    VstSequencer::EventSequence sequence = m_sequencer.eventsToBePlayed(nextMsecs);
+    const VstSequencer::EventSequence& sequence = m_sequencer.eventsToBePlayed(nextMsecs);
 
     for (const VstSequencer::EventType& event : sequence) {
         if (std::holds_alternative<VstEvent>(event)) {
@@ -22,10 +22,15 @@
 
 #include "pngwriter.h"
 
+#include <algorithm>
 #include <cmath>
+#include <deque>
 #include <QImage>
 #include <QBuffer>
 
+#include "global/concurrency/taskscheduler.h"
+#include "global/io/ioretcodes.h"
+
 #include "log.h"
 
 using namespace mu::iex::imagesexport;
@@ -39,12 +44,94 @@ std::vector<INotationWriter::UnitType> PngWriter::supportedUnitTypes() const
     return { UnitType::PER_PAGE };
 }
 
+static QByteArray encodePng(const QImage& image)
+{
+    QByteArray qdata;
+    QBuffer buf(&qdata);
+    buf.open(QIODevice::WriteOnly);
+    image.save(&buf, "png");
+
+    return qdata;
+}
+
 Ret PngWriter::write(INotationPtr notation, io::IODevice& destinationDevice, const Options& options)
 {
     IF_ASSERT_FAILED(notation) {
         return make_ret(Ret::Code::UnknownError);
     }
 
+    QByteArray qdata = encodePng(paintPage(notation, options));
+
+    ByteArray data = ByteArray::fromQByteArrayNoCopy(qdata);
+    destinationDevice.write(data);
+
+    return true;
+}
+
+Ret PngWriter::writePages(INotationPtr notation, size_t pageCount, const PageDeviceOpener& openDevice, const Options& options)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    //! NOTE: Painting uses the score and the shared drawing caches, so the pages are painted one by one here.
+    //! Compressing the images is independent of them and takes most of the time, so it is done concurrently.
+    //! The number of painted images waiting for the compression is limited, to bound the memory
+    muse::TaskScheduler* scheduler = muse::TaskScheduler::workerPool();
+    const size_t maxPendingCount = std::max(scheduler->threadPoolSize(), thread_pool_size_t(1));
+
+    std::deque<std::future<QByteArray> > pending;
+    size_t writtenCount = 0;
+
+    auto writeNext = [&pending, &writtenCount, &openDevice]() -> Ret {
+        QByteArray qdata = pending.front().get();
+        pending.pop_front();
+
+        std::unique_ptr<io::IODevice> device = openDevice(writtenCount++);
+        if (!device) {
+            return make_ret(Ret::Code::UnknownError);
+        }
+
+        ByteArray data = ByteArray::fromQByteArrayNoCopy(qdata);
+        if (device->write(data) != data.size()) {
+            return make_ret(io::Err::FSWriteError);
+        }
+
+        return make_ok();
+    };
+
+    Options pageOptions = options;
+
+    for (size_t i = 0; i < pageCount; ++i) {
+        pageOptions[OptionKey::PAGE_NUMBER] = Val(static_cast<int>(i));
+        QImage image = paintPage(notation, pageOptions);
+
+        if (pending.size() >= maxPendingCount) {
+            Ret ret = writeNext();
+            if (!ret) {
+                return ret;
+            }
+        }
+
+        pending.push_back(scheduler->submit([image]() {
+            return encodePng(image);
+        }));
+    }
+
+    while (!pending.empty()) {
+        Ret ret = writeNext();
+        if (!ret) {
+            return ret;
+        }
+    }
+
+    return make_ok();
+}
+
+QImage PngWriter::paintPage(INotationPtr notation, const Options& options) const
+{
     const float CANVAS_DPI = configuration()->exportPngDpiResolution();
 
     INotationPainting::Options opt;
@@ -71,13 +158,5 @@ Ret PngWriter::write(INotationPtr notation, io::IODevice& destinationDevice, con
 
     notation->painting()->paintPng(&painter, opt);
 
-    QByteArray qdata;
-    QBuffer buf(&qdata);
-    buf.open(QIODevice::WriteOnly);
-    image.save(&buf, "png");
-
-    ByteArray data = ByteArray::fromQByteArrayNoCopy(qdata);
-    destinationDevice.write(data);
-
-    return true;
+    return image;
 }
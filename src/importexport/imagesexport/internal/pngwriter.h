@@ -23,6 +23,8 @@
 #ifndef MU_IMPORTEXPORT_PNGWRITER_H
 #define MU_IMPORTEXPORT_PNGWRITER_H
 
+#include <QImage>
+
 #include "abstractimagewriter.h"
 
 #include "../iimagesexportconfiguration.h"
@@ -36,6 +38,11 @@ class PngWriter : public AbstractImageWriter
 public:
     std::vector<project::INotationWriter::UnitType> supportedUnitTypes() const override;
     muse::Ret write(notation::INotationPtr notation, muse::io::IODevice& dstDevice, const Options& options = Options()) override;
+    muse::Ret writePages(notation::INotationPtr notation, size_t pageCount, const PageDeviceOpener& openDevice,
+                         const Options& options = Options()) override;
+
+private:
+    QImage paintPage(notation::INotationPtr notation, const Options& options) const;
 };
 }
 
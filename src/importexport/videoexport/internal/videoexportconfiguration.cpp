@@ -28,6 +28,7 @@ static std::string DEFAULT_RESOLUTION = "1080p";
 static int DEFAULT_FPS = 24;
 static double DEFAULT_LEADING_SEC = 3.0;
 static double DEFAULT_TRAILING_SECONDS = 3.0;
+static bool DEFAULT_ENCODE_IN_BACKGROUND = true;
 
 using namespace mu::iex::videoexport;
 
@@ -100,3 +101,13 @@ void VideoExportConfiguration::setTrailingSec(std::optional<double> trailingSec)
 {
     m_trailingSec = trailingSec;
 }
+
+bool VideoExportConfiguration::encodeInBackground() const
+{
+    return m_encodeInBackground ? m_encodeInBackground.value() : DEFAULT_ENCODE_IN_BACKGROUND;
+}
+
+void VideoExportConfiguration::setEncodeInBackground(std::optional<bool> encodeInBackground)
+{
+    m_encodeInBackground = encodeInBackground;
+}
@@ -50,6 +50,9 @@ public:
     double trailingSec() const override;
     void setTrailingSec(std::optional<double> trailingSec) override;
 
+    bool encodeInBackground() const override;
+    void setEncodeInBackground(std::optional<bool> encodeInBackground) override;
+
 private:
     std::optional<ViewMode> m_viewMode = std::nullopt;
     std::optional<bool> m_showPiano = std::nullopt;
@@ -58,6 +61,7 @@ private:
     std::optional<int> m_fps = std::nullopt;
     std::optional<double> m_leadingSec = std::nullopt;
     std::optional<double> m_trailingSec = std::nullopt;
+    std::optional<bool> m_encodeInBackground = std::nullopt;
 };
 }
 
@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "videoframequeue.h"
+
+#include <algorithm>
+
+#include "log.h"
+
+using namespace mu::iex::videoexport;
+
+VideoFrameQueue::VideoFrameQueue(const EncodeFunc& encode, bool background, size_t capacity)
+    : m_encodeFunc(encode), m_capacity(std::max(capacity, size_t(1)))
+{
+    if (background) {
+        m_thread = std::thread(&VideoFrameQueue::encodeLoop, this);
+    }
+}
+
+VideoFrameQueue::~VideoFrameQueue()
+{
+    finish();
+}
+
+void VideoFrameQueue::push(const QImage& frame)
+{
+    if (!m_thread.joinable()) {
+        QImage encodedFrame = frame;
+        encode(encodedFrame);
+        return;
+    }
+
+    std::unique_lock lock(m_mutex);
+    m_framesChanged.wait(lock, [this]() {
+        return m_frames.size() < m_capacity;
+    });
+
+    m_frames.push_back(frame);
+    m_framesChanged.notify_all();
+}
+
+QImage VideoFrameQueue::takeFreeFrame()
+{
+    std::lock_guard lock(m_mutex);
+
+    if (m_freeFrames.empty()) {
+        return QImage();
+    }
+
+    QImage frame = std::move(m_freeFrames.back());
+    m_freeFrames.pop_back();
+
+    return frame;
+}
+
+bool VideoFrameQueue::finish()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_finished = true;
+        m_framesChanged.notify_all();
+    }
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    return m_ok;
+}
+
+void VideoFrameQueue::encode(QImage& frame)
+{
+    if (!m_encodeFunc(frame)) {
+        LOGE() << "failed encode frame";
+        m_ok = false;
+    }
+
+    std::lock_guard lock(m_mutex);
+
+    //! NOTE: The same frame may be pushed several times in a row, only the last user gives it back
+    if (frame.isDetached()) {
+        m_freeFrames.push_back(std::move(frame));
+    }
+}
+
+void VideoFrameQueue::encodeLoop()
+{
+    for (;;) {
+        QImage frame;
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_framesChanged.wait(lock, [this]() {
+                return !m_frames.empty() || m_finished;
+            });
+
+            if (m_frames.empty()) {
+                return;
+            }
+
+            frame = std::move(m_frames.front());
+            m_frames.pop_front();
+            m_framesChanged.notify_all();
+        }
+
+        encode(frame);
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_IMPORTEXPORT_VIDEOFRAMEQUEUE_H
+#define MU_IMPORTEXPORT_VIDEOFRAMEQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QImage>
+
+namespace mu::iex::videoexport {
+//! NOTE: Passes the composed frames to the encoder.
+//! In the background mode the frames are encoded on a separate thread, so composing
+//! the next frames overlaps with encoding the previous ones. The encoded frames
+//! are given back by takeFreeFrame(), so their buffers can be reused
+class VideoFrameQueue
+{
+public:
+    using EncodeFunc = std::function<bool (const QImage& frame)>;
+
+    VideoFrameQueue(const EncodeFunc& encode, bool background, size_t capacity = 4);
+    ~VideoFrameQueue();
+
+    void push(const QImage& frame);
+
+    //! NOTE: A frame which is no longer used by the encoder, or a null image
+    QImage takeFreeFrame();
+
+    //! NOTE: Waits until all the pushed frames are encoded, false if any of them failed
+    bool finish();
+
+private:
+    void encode(QImage& frame);
+    void encodeLoop();
+
+    EncodeFunc m_encodeFunc;
+    size_t m_capacity = 0;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_framesChanged;
+
+    std::deque<QImage> m_frames;
+    std::vector<QImage> m_freeFrames;
+
+    bool m_finished = false;
+    bool m_ok = true;
+};
+}
+
+#endif // MU_IMPORTEXPORT_VIDEOFRAMEQUEUE_H
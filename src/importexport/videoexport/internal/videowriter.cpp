@@ -22,6 +22,7 @@
 #include "videowriter.h"
 
 #include "videoencoder.h"
+#include "videoframequeue.h"
 
 #include "engraving/dom/page.h"
 #include "engraving/dom/repeatlist.h"
@@ -33,6 +34,8 @@
 
 #include <QPainter>
 
+#include <cstring>
+
 using namespace mu::iex::videoexport;
 using namespace mu::project;
 using namespace mu::notation;
@@ -175,19 +178,48 @@ muse::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, c
     score->update();
 
     // Setup painting
-    QImage frame(config.width, config.height, QImage::Format_RGB32);
-    frame.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / engraving::INCH));
-    frame.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / engraving::INCH));
-
-    QPainter qp(&frame);
-    qp.setRenderHint(QPainter::Antialiasing, true);
-    qp.setRenderHint(QPainter::TextAntialiasing, true);
-    muse::RectF frameRect = muse::RectF::fromQRectF(QRectF(frame.rect()));
+    QImage pageImage(config.width, config.height, QImage::Format_RGB32);
+    pageImage.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / engraving::INCH));
+    pageImage.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / engraving::INCH));
 
-    Painter painter(&qp, "video_writer");
+    muse::RectF frameRect = muse::RectF::fromQRectF(QRectF(pageImage.rect()));
 
     auto painting = masterNotation->notation()->painting();
 
+    //! NOTE: The page doesn't change while the cursor moves over it,
+    //! so it is painted once and every frame is a copy of it with the cursor on top
+    auto paintPage = [&pageImage, &frameRect, &painting, CANVAS_DPI](const Page* page) {
+        QPainter qp(&pageImage);
+        qp.setRenderHint(QPainter::Antialiasing, true);
+        qp.setRenderHint(QPainter::TextAntialiasing, true);
+
+        Painter painter(&qp, "video_writer");
+        painter.fillRect(frameRect, Color::WHITE);
+
+        INotationPainting::Options opt;
+        opt.fromPage = page->no();
+        opt.toPage = opt.fromPage;
+        opt.deviceDpi = CANVAS_DPI;
+
+        painting->paintPrint(&painter, opt);
+    };
+
+    const Color CURSOR_COLOR = Color(0, 0, 255, 50);
+
+    auto composeFrame = [&pageImage, CURSOR_COLOR](QImage& frame, const muse::RectF& cursorRect) {
+        if (frame.size() == pageImage.size() && frame.format() == pageImage.format()) {
+            std::memcpy(frame.bits(), pageImage.constBits(), pageImage.sizeInBytes());
+        } else {
+            frame = pageImage.copy();
+        }
+
+        QPainter qp(&frame);
+        qp.setRenderHint(QPainter::Antialiasing, true);
+
+        Painter painter(&qp, "video_writer");
+        painter.fillRect(cursorRect, CURSOR_COLOR);
+    };
+
     // Setup duration
     INotationPlaybackPtr playback = masterNotation->playback();
     float totalPlayTimeSec = playback->totalPlayTime() / 1000.0;
@@ -208,11 +240,18 @@ muse::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, c
         return nullptr;
     };
 
-    const Color CURSOR_COLOR = Color(0, 0, 255, 50);
-
     PlaybackCursor cursor;
     cursor.setNotation(masterNotation->notation());
 
+    VideoFrameQueue frameQueue([&encoder](const QImage& frame) {
+        return encoder.encodeImage(frame);
+    }, configuration()->encodeInBackground());
+
+    const Page* paintedPage = nullptr;
+    muse::RectF composedCursorRect;
+    bool frameActual = false;
+    QImage frame;
+
     for (int f = 0; f < frameCount; f++) {
         float currentTimeSec = (qreal)f / config.fps;
         currentTimeSec -= config.leadingSec;
@@ -230,14 +269,11 @@ muse::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, c
             break;
         }
 
-        INotationPainting::Options opt;
-        opt.fromPage = page->no();
-        opt.toPage = opt.fromPage;
-        opt.deviceDpi = CANVAS_DPI;
-
-        painter.fillRect(frameRect, Color::WHITE);
-
-        painting->paintPrint(&painter, opt);
+        if (page != paintedPage) {
+            paintPage(page);
+            paintedPage = page;
+            frameActual = false;
+        }
 
         cursor.move(tick);
 
@@ -245,12 +281,29 @@ muse::Ret VideoWriter::generatePagedOriginalVideo(INotationProjectPtr project, c
         muse::PointF pagePos = page->pos();
         muse::RectF cursorAbsRect = cursorRect.translated(-pagePos);
 
-        painter.fillRect(cursorAbsRect, CURSOR_COLOR);
+        //! NOTE: The cursor stays on the same chord for many frames, such frames are encoded again as they are
+        if (!frameActual || cursorAbsRect != composedCursorRect) {
+            QImage freeFrame = frameQueue.takeFreeFrame();
+            if (!freeFrame.isNull()) {
+                frame = std::move(freeFrame);
+            }
+
+            composeFrame(frame, cursorAbsRect);
+            composedCursorRect = cursorAbsRect;
+            frameActual = true;
+        }
 
-        encoder.encodeImage(frame);
+        frameQueue.push(frame);
     }
 
+    bool encoded = frameQueue.finish();
+
     encoder.close();
 
+    if (!encoded) {
+        LOGE() << "failed encode frames";
+        return make_ret(muse::Ret::Code::UnknownError);
+    }
+
     return muse::make_ok();
 }
@@ -56,6 +56,10 @@ public:
 
     virtual double trailingSec() const = 0;
     virtual void setTrailingSec(std::optional<double> trailingSec) = 0;
+
+    //! NOTE: Encode the frames on a separate thread, while the next ones are being composed
+    virtual bool encodeInBackground() const = 0;
+    virtual void setEncodeInBackground(std::optional<bool> encodeInBackground) = 0;
 };
 }
 
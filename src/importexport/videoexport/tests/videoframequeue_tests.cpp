@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-Studio-CLA-applies
+ *
+ * MuseScore Studio
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2024 MuseScore Limited and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "importexport/videoexport/internal/videoframequeue.h"
+
+using namespace mu::iex::videoexport;
+
+class VideoExport_VideoFrameQueueTests : public ::testing::Test
+{
+public:
+    static QImage makeFrame(int number)
+    {
+        QImage frame(1, 1, QImage::Format_RGB32);
+        frame.setPixel(0, 0, static_cast<QRgb>(number));
+        return frame;
+    }
+
+    static int frameNumber(const QImage& frame)
+    {
+        return static_cast<int>(frame.pixel(0, 0) & 0xffffff);
+    }
+
+    //! NOTE: Pushes the numbered frames, reusing the free ones like the video writer does
+    static std::vector<int> encodeFrames(bool background, int count, int failedNumber = -1, bool* ok = nullptr)
+    {
+        std::vector<int> encoded;
+
+        VideoFrameQueue queue([&encoded, failedNumber](const QImage& frame) {
+            encoded.push_back(frameNumber(frame));
+            return frameNumber(frame) != failedNumber;
+        }, background, 2);
+
+        for (int i = 0; i < count; ++i) {
+            QImage frame = queue.takeFreeFrame();
+            if (frame.isNull()) {
+                frame = makeFrame(i);
+            } else {
+                frame.setPixel(0, 0, static_cast<QRgb>(i));
+            }
+
+            queue.push(frame);
+        }
+
+        bool finished = queue.finish();
+        if (ok) {
+            *ok = finished;
+        }
+
+        return encoded;
+    }
+};
+
+TEST_F(VideoExport_VideoFrameQueueTests, EncodeInOrder)
+{
+    std::vector<int> expected(100);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    for (bool background : { false, true }) {
+        bool ok = false;
+        EXPECT_EQ(encodeFrames(background, 100, -1, &ok), expected);
+        EXPECT_TRUE(ok);
+    }
+}
+
+TEST_F(VideoExport_VideoFrameQueueTests, ReportFailedFrame)
+{
+    std::vector<int> expected(100);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    for (bool background : { false, true }) {
+        //! NOTE: The frames after the failed one are still encoded, the failure is reported by finish()
+        bool ok = true;
+        EXPECT_EQ(encodeFrames(background, 100, 42, &ok), expected);
+        EXPECT_FALSE(ok);
+    }
+}
@@ -26,6 +26,8 @@
 
 #include "io/path.h"
 #include "types/ret.h"
+#include "types/retval.h"
+#include "progress.h"
 
 #include "iprojectaudiosettings.h"
 #include "notation/imasternotation.h"
@@ -70,6 +72,11 @@ public:
     virtual void setNeedAutoSave(bool val) = 0;
 
     virtual muse::Ret save(const muse::io::path_t& path = muse::io::path_t(), SaveMode saveMode = SaveMode::Save) = 0;
+
+    //! NOTE The project is serialized on the calling thread, then compressed and written to the disk in the background.
+    //! Only SaveMode::AutoSave is supported. The progress is finished once the file is in place,
+    //! cancelling it before that leaves the previous file untouched
+    virtual muse::RetVal<muse::ProgressPtr> saveInBackground(const muse::io::path_t& path, SaveMode saveMode = SaveMode::AutoSave) = 0;
     virtual muse::Ret writeToDevice(QIODevice* device) = 0;
 
     virtual ProjectMeta metaInfo() const = 0;
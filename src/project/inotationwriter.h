@@ -23,7 +23,10 @@
 #ifndef MU_PROJECT_INOTATIONWRITER_H
 #define MU_PROJECT_INOTATIONWRITER_H
 
+#include <functional>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "global/types/ret.h"
 #include "global/types/val.h"
@@ -61,6 +64,33 @@ public:
     virtual muse::Ret writeList(const notation::INotationPtrList& notations, muse::io::IODevice& device,
                                 const Options& options = Options()) = 0;
 
+    //! NOTE: Opens the device of a page right before the page is written, returns nullptr if it can't be opened
+    using PageDeviceOpener = std::function<std::unique_ptr<muse::io::IODevice>(size_t page)>;
+
+    //! NOTE: Writes the pages one by one, each one to its own device, stops at the first failure.
+    //! Writers which can do a part of the work concurrently override it
+    virtual muse::Ret writePages(notation::INotationPtr notation, size_t pageCount, const PageDeviceOpener& openDevice,
+                                 const Options& options = Options())
+    {
+        Options pageOptions = options;
+
+        for (size_t i = 0; i < pageCount; ++i) {
+            std::unique_ptr<muse::io::IODevice> device = openDevice(i);
+            if (!device) {
+                return muse::make_ret(muse::Ret::Code::UnknownError);
+            }
+
+            pageOptions[OptionKey::PAGE_NUMBER] = muse::Val(static_cast<int>(i));
+
+            muse::Ret ret = write(notation, *device, pageOptions);
+            if (!ret) {
+                return ret;
+            }
+        }
+
+        return muse::make_ok();
+    }
+
     virtual muse::Progress* progress() { return nullptr; }
     virtual void abort() {}
 };
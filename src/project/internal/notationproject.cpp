@@ -21,10 +21,15 @@
  */
 #include "notationproject.h"
 
+#include <deque>
+#include <functional>
+#include <mutex>
+
 #include <QBuffer>
 #include <QDir>
 #include <QFile>
 
+#include "global/concurrency/taskscheduler.h"
 #include "global/io/buffer.h"
 #include "global/io/file.h"
 #include "global/io/ioretcodes.h"
@@ -57,6 +62,180 @@ using namespace mu::engraving;
 using namespace mu::notation;
 using namespace mu::project;
 
+static std::string autoSaveFileSuffix(const muse::io::path_t& path)
+{
+    std::string suffix = io::suffix(path);
+    if (suffix == IProjectAutoSaver::AUTOSAVE_SUFFIX) {
+        suffix = io::suffix(io::completeBasename(path));
+    }
+
+    if (suffix.empty()) {
+        // Then it must be a MSCX folder
+        suffix = engraving::MSCX;
+    }
+
+    return suffix;
+}
+
+static QString savingPath(const QString& targetContainerPath)
+{
+    return targetContainerPath + "_saving";
+}
+
+//! NOTE Replaces the target container with the one written to the saving path
+static Ret replaceWithSavedFile(const std::shared_ptr<IFileSystem>& fileSystem, const QString& savePath,
+                                const QString& targetContainerPath, MscIoMode ioMode)
+{
+    if (ioMode == MscIoMode::Dir) {
+        RetVal<io::paths_t> filesToBeMoved = fileSystem->scanFiles(savePath, { "*" }, io::ScanMode::FilesAndFoldersInCurrentDir);
+        if (!filesToBeMoved.ret) {
+            return filesToBeMoved.ret;
+        }
+
+        Ret ret = muse::make_ok();
+
+        for (const muse::io::path_t& fileToBeMoved : filesToBeMoved.val) {
+            muse::io::path_t destinationFile
+                = muse::io::path_t(targetContainerPath).appendingComponent(io::filename(fileToBeMoved));
+            LOGD() << fileToBeMoved << " to " << destinationFile;
+            ret = fileSystem->move(fileToBeMoved, destinationFile, true);
+            if (!ret) {
+                return ret;
+            }
+        }
+
+        // Try to remove the temp save folder (not problematic if fails)
+        ret = fileSystem->remove(savePath, true);
+        if (!ret) {
+            LOGW() << ret.toString();
+        }
+
+        return muse::make_ok();
+    }
+
+    return fileSystem->move(savePath, targetContainerPath, true);
+}
+
+//! NOTE Shared by the background save and the cancellation of its progress
+struct BackgroundSaveState {
+    std::mutex mutex;
+    bool cancelled = false;
+};
+
+//! NOTE The saves of the project write the same files, so they run one after another, in order.
+//! Only one task of the pool runs them at a time, it takes the saves queued meanwhile
+//! instead of a waiting task for each of them
+struct NotationProject::BackgroundSaveQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()> > saves;
+    bool running = false;
+
+    static void push(const std::shared_ptr<BackgroundSaveQueue>& queue, std::function<void()> save)
+    {
+        {
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            queue->saves.push_back(std::move(save));
+            if (queue->running) {
+                return;
+            }
+            queue->running = true;
+        }
+
+        muse::TaskScheduler::workerPool()->push([queue]() {
+            run(*queue);
+        });
+    }
+
+    static void run(BackgroundSaveQueue& queue)
+    {
+        while (true) {
+            std::function<void()> save;
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.saves.empty()) {
+                    queue.running = false;
+                    return;
+                }
+                save = std::move(queue.saves.front());
+                queue.saves.pop_front();
+            }
+
+            save();
+        }
+    }
+};
+
+//! NOTE Runs on the save thread: compresses the serialized project and moves it in place
+static Ret writeSnapshot(const std::shared_ptr<IFileSystem>& fileSystem, const MscWriter& snapshot,
+                         const QString& savePath, const QString& targetContainerPath, const muse::io::path_t& targetMainFilePath,
+                         MscIoMode ioMode, const ProgressPtr& progress, BackgroundSaveState& state)
+{
+    constexpr int64_t stepsCount = 3;
+
+    MscWriter::Params params = snapshot.params();
+    params.deferred = false;
+
+    // Step 1: compress
+    ByteArray data;
+    Buffer buf(&data);
+    if (ioMode != MscIoMode::Dir) {
+        //! NOTE The file device rewrites the whole file on every write, so collect it in memory first
+        params.device = &buf;
+    }
+
+    {
+        MscWriter writer(params);
+        Ret ret = writer.open();
+        if (!ret) {
+            LOGE() << "failed open writer: " << ret.toString();
+            return ret;
+        }
+
+        ret = snapshot.writeTo(writer);
+        writer.close();
+
+        if (!ret || writer.hasError()) {
+            LOGE() << "failed write project";
+            return ret ? make_ret(Ret::Code::UnknownError) : ret;
+        }
+    }
+
+    progress->progressChanged.send(1, stepsCount, "");
+
+    // Step 2: write
+    if (ioMode != MscIoMode::Dir) {
+        Ret ret = fileSystem->writeFile(savePath, data);
+        if (!ret) {
+            LOGE() << "failed write file: " << savePath << ", err: " << ret.toString();
+            return ret;
+        }
+    }
+
+    progress->progressChanged.send(2, stepsCount, "");
+
+    // Step 3: replace to saved file, unless the save has been cancelled meanwhile
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.cancelled) {
+            fileSystem->remove(savePath);
+            return make_ret(Ret::Code::Cancel);
+        }
+
+        Ret ret = replaceWithSavedFile(fileSystem, savePath, targetContainerPath, ioMode);
+        if (!ret) {
+            return ret;
+        }
+    }
+
+    // make file readable by all
+    QFile::setPermissions(targetMainFilePath.toQString(),
+                          QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser | QFile::ReadGroup | QFile::ReadOther);
+
+    progress->progressChanged.send(stepsCount, stepsCount, "");
+
+    return muse::make_ok();
+}
+
 static void setupScoreMetaTags(mu::engraving::MasterScore* masterScore, const ProjectCreateOptions& projectOptions)
 {
     if (!projectOptions.title.isEmpty()) {
@@ -494,20 +673,85 @@ Ret NotationProject::save(const muse::io::path_t& path, SaveMode saveMode)
         return ret;
     }
     case SaveMode::AutoSave:
-        std::string suffix = io::suffix(path);
-        if (suffix == IProjectAutoSaver::AUTOSAVE_SUFFIX) {
-            suffix = io::suffix(io::completeBasename(path));
+        return saveScore(path, autoSaveFileSuffix(path), false /*generateBackup*/, false /*createThumbnail*/);
+    }
+
+    return make_ret(notation::Err::UnknownError);
+}
+
+RetVal<ProgressPtr> NotationProject::saveInBackground(const muse::io::path_t& path, SaveMode saveMode)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(saveMode == SaveMode::AutoSave) {
+        return make_ret(Ret::Code::NotSupported);
+    }
+
+    MscIoMode ioMode = mscIoModeBySuffix(autoSaveFileSuffix(path));
+    IF_ASSERT_FAILED(ioMode != MscIoMode::Unknown) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    Ret ret = prepareSavePath(path, ioMode);
+    if (!ret) {
+        return ret;
+    }
+
+    QString targetContainerPath = engraving::containerPath(path).toQString();
+    muse::io::path_t targetMainFilePath = engraving::mainFilePath(path);
+    QString savePath = savingPath(targetContainerPath);
+
+    //! NOTE Serialize the project here, this is the only step that reads the score.
+    //! The result is a consistent snapshot of it, the rest runs in the background
+    MscWriter::Params params;
+    params.filePath = savePath;
+    params.mainFileName = engraving::mainFileName(path).toQString();
+    params.mode = ioMode;
+    params.deferred = true;
+
+    std::shared_ptr<MscWriter> snapshot = std::make_shared<MscWriter>(params);
+    ret = writeProject(*snapshot, false /*onlySelection*/, false /*createThumbnail*/);
+    snapshot->close();
+
+    if (!ret) {
+        LOGE() << "failed write project to buffer: " << ret.toString();
+        return ret;
+    }
+
+    ProgressPtr progress = std::make_shared<Progress>();
+    std::shared_ptr<BackgroundSaveState> state = std::make_shared<BackgroundSaveState>();
+
+    progress->cancelRequested.onNotify(this, [state]() {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->cancelled = true;
+    });
+
+    std::shared_ptr<IFileSystem> fs = fileSystem();
+
+    if (!m_backgroundSaveQueue) {
+        m_backgroundSaveQueue = std::make_shared<BackgroundSaveQueue>();
+    }
+
+    BackgroundSaveQueue::push(m_backgroundSaveQueue, [fs, snapshot, savePath, targetContainerPath, targetMainFilePath,
+                                                      ioMode, progress, state]() {
+        progress->started.notify();
+
+        Ret ret = writeSnapshot(fs, *snapshot, savePath, targetContainerPath, targetMainFilePath, ioMode, progress, *state);
+
+        if (ret) {
+            LOGI() << "success save file: " << targetContainerPath;
         }
 
-        if (suffix.empty()) {
-            // Then it must be a MSCX folder
-            suffix = engraving::MSCX;
+        //! NOTE Progress::cancel() reports the result itself
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->cancelled) {
+            return;
         }
 
-        return saveScore(path, suffix, false /*generateBackup*/, false /*createThumbnail*/);
-    }
+        progress->finished.send(ret);
+    });
 
-    return make_ret(notation::Err::UnknownError);
+    return RetVal<ProgressPtr>::make_ok(progress);
 }
 
 Ret NotationProject::writeToDevice(QIODevice* device)
@@ -568,22 +812,13 @@ Ret NotationProject::doSave(const muse::io::path_t& path, engraving::MscIoMode i
     QString targetContainerPath = engraving::containerPath(path).toQString();
     muse::io::path_t targetMainFilePath = engraving::mainFilePath(path);
     muse::io::path_t targetMainFileName = engraving::mainFileName(path);
-    QString savePath = targetContainerPath + "_saving";
+    QString savePath = savingPath(targetContainerPath);
 
     // Step 1: check writable
     {
-        if ((fileSystem()->exists(savePath) && !fileSystem()->isWritable(savePath))
-            || (fileSystem()->exists(targetContainerPath) && !fileSystem()->isWritable(targetContainerPath))) {
-            LOGE() << "failed save, not writable path: " << targetContainerPath;
-            return make_ret(io::Err::FSWriteError);
-        }
-
-        if (ioMode == engraving::MscIoMode::Dir) {
-            // Dir needs to be created, otherwise we can't move to it
-            if (!QDir(targetContainerPath).mkpath(".")) {
-                LOGE() << "Couldn't create container directory: " << targetContainerPath;
-                return make_ret(io::Err::FSMakingError);
-            }
+        Ret ret = prepareSavePath(path, ioMode);
+        if (!ret) {
+            return ret;
         }
     }
 
@@ -621,34 +856,9 @@ Ret NotationProject::doSave(const muse::io::path_t& path, engraving::MscIoMode i
 
     // Step 4: replace to saved file
     {
-        if (ioMode == MscIoMode::Dir) {
-            RetVal<io::paths_t> filesToBeMoved = fileSystem()->scanFiles(savePath, { "*" }, io::ScanMode::FilesAndFoldersInCurrentDir);
-            if (!filesToBeMoved.ret) {
-                return filesToBeMoved.ret;
-            }
-
-            Ret ret = muse::make_ok();
-
-            for (const muse::io::path_t& fileToBeMoved : filesToBeMoved.val) {
-                muse::io::path_t destinationFile
-                    = muse::io::path_t(targetContainerPath).appendingComponent(io::filename(fileToBeMoved));
-                LOGD() << fileToBeMoved << " to " << destinationFile;
-                ret = fileSystem()->move(fileToBeMoved, destinationFile, true);
-                if (!ret) {
-                    return ret;
-                }
-            }
-
-            // Try to remove the temp save folder (not problematic if fails)
-            ret = fileSystem()->remove(savePath, true);
-            if (!ret) {
-                LOGW() << ret.toString();
-            }
-        } else {
-            Ret ret = fileSystem()->move(savePath, targetContainerPath, true);
-            if (!ret) {
-                return ret;
-            }
+        Ret ret = replaceWithSavedFile(fileSystem(), savePath, targetContainerPath, ioMode);
+        if (!ret) {
+            return ret;
         }
     }
 
@@ -662,6 +872,28 @@ Ret NotationProject::doSave(const muse::io::path_t& path, engraving::MscIoMode i
     return make_ret(Ret::Code::Ok);
 }
 
+Ret NotationProject::prepareSavePath(const muse::io::path_t& path, engraving::MscIoMode ioMode) const
+{
+    QString targetContainerPath = engraving::containerPath(path).toQString();
+    QString savePath = savingPath(targetContainerPath);
+
+    if ((fileSystem()->exists(savePath) && !fileSystem()->isWritable(savePath))
+        || (fileSystem()->exists(targetContainerPath) && !fileSystem()->isWritable(targetContainerPath))) {
+        LOGE() << "failed save, not writable path: " << targetContainerPath;
+        return make_ret(io::Err::FSWriteError);
+    }
+
+    if (ioMode == engraving::MscIoMode::Dir) {
+        // Dir needs to be created, otherwise we can't move to it
+        if (!QDir(targetContainerPath).mkpath(".")) {
+            LOGE() << "Couldn't create container directory: " << targetContainerPath;
+            return make_ret(io::Err::FSMakingError);
+        }
+    }
+
+    return muse::make_ok();
+}
+
 Ret NotationProject::makeCurrentFileAsBackup()
 {
     TRACEFUNC;
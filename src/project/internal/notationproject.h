@@ -22,6 +22,8 @@
 #ifndef MU_PROJECT_NOTATIONPROJECT_H
 #define MU_PROJECT_NOTATIONPROJECT_H
 
+#include <memory>
+
 #include "../inotationproject.h"
 
 #include "async/asyncable.h"
@@ -92,6 +94,7 @@ public:
     void setNeedAutoSave(bool val) override;
 
     muse::Ret save(const muse::io::path_t& path = muse::io::path_t(), SaveMode saveMode = SaveMode::Save) override;
+    muse::RetVal<muse::ProgressPtr> saveInBackground(const muse::io::path_t& path, SaveMode saveMode = SaveMode::AutoSave) override;
     muse::Ret writeToDevice(QIODevice* device) override;
 
     ProjectMeta metaInfo() const override;
@@ -113,6 +116,7 @@ private:
     muse::Ret saveSelectionOnScore(const muse::io::path_t& path = muse::io::path_t());
     muse::Ret exportProject(const muse::io::path_t& path, const std::string& suffix);
     muse::Ret doSave(const muse::io::path_t& path, engraving::MscIoMode ioMode, bool generateBackup = true, bool createThumbnail = true);
+    muse::Ret prepareSavePath(const muse::io::path_t& path, engraving::MscIoMode ioMode) const;
     muse::Ret makeCurrentFileAsBackup();
     muse::Ret writeProject(engraving::MscWriter& msczWriter, bool onlySelection, bool createThumbnail = true);
 
@@ -136,6 +140,10 @@ private:
     bool m_isImported = false;
     bool m_needAutoSave = false;
     bool m_hasNonUndoStackChanges = false;
+
+    //! NOTE The background saves, which run one after another
+    struct BackgroundSaveQueue;
+    std::shared_ptr<BackgroundSaveQueue> m_backgroundSaveQueue;
 };
 }
 
@@ -93,6 +93,9 @@ void ProjectAutoSaver::removeProjectUnsavedChanges(const muse::io::path_t& proje
         path = projectAutoSavePath(projectPath);
     }
 
+    //! NOTE Otherwise the autosave still being written would land after the file is removed
+    cancelSaveInProgress();
+
     fileSystem()->remove(path);
 }
 
@@ -167,18 +170,67 @@ void ProjectAutoSaver::onTrySave()
         return;
     }
 
+    if (m_saveProgress) {
+        LOGD() << "[autosave] the previous autosave is still in progress";
+        return;
+    }
+
     muse::io::path_t projectPath = this->projectPath(project);
     muse::io::path_t savePath = project->isNewlyCreated() ? projectPath : projectAutoSavePath(projectPath);
 
-    Ret ret = project->save(savePath, SaveMode::AutoSave);
-    if (!ret) {
-        LOGE() << "[autosave] failed to save project, err: " << ret.toString();
+    RetVal<ProgressPtr> ret = project->saveInBackground(savePath, SaveMode::AutoSave);
+    if (!ret.ret) {
+        LOGE() << "[autosave] failed to save project, err: " << ret.ret.toString();
         return;
     }
 
+    //! NOTE The project has been serialized, the edits made from now on need the next autosave
     project->setNeedAutoSave(false);
 
-    LOGD() << "[autosave] successfully saved project";
+    m_saveProgress = ret.val;
+
+    //! NOTE The progress may report finished twice, when it's cancelled right after the save is done,
+    //! and the late result must not reset the progress of a newer autosave
+    const Progress* progress = m_saveProgress.get();
+    std::weak_ptr<INotationProject> weakProject = project;
+    m_saveProgress->finished.onReceive(this, [this, progress, weakProject](const ProgressResult& res) {
+        if (m_saveProgress.get() != progress) {
+            return;
+        }
+
+        m_saveProgress = nullptr;
+
+        if (res.ret) {
+            LOGD() << "[autosave] successfully saved project";
+            return;
+        }
+
+        if (res.ret.code() == static_cast<int>(Ret::Code::Cancel)) {
+            LOGD() << "[autosave] cancelled";
+            return;
+        }
+
+        LOGE() << "[autosave] failed to save project, err: " << res.ret.toString();
+
+        if (INotationProjectPtr savedProject = weakProject.lock()) {
+            savedProject->setNeedAutoSave(true);
+        }
+    });
+}
+
+void ProjectAutoSaver::cancelSaveInProgress()
+{
+    if (!m_saveProgress) {
+        return;
+    }
+
+    //! NOTE The result may be delivered later, the receiver ignores it then
+    ProgressPtr progress = m_saveProgress;
+    progress->cancel();
+
+    if (m_saveProgress == progress) {
+        m_saveProgress = nullptr;
+    }
 }
 
 muse::io::path_t ProjectAutoSaver::projectPath(INotationProjectPtr project) const
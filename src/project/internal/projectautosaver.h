@@ -25,6 +25,7 @@
 #include <QTimer>
 
 #include "async/asyncable.h"
+#include "progress.h"
 
 #include "modularity/ioc.h"
 #include "context/iglobalcontext.h"
@@ -59,11 +60,13 @@ private:
     void update();
 
     void onTrySave();
+    void cancelSaveInProgress();
 
     muse::io::path_t projectPath(INotationProjectPtr project) const;
 
     QTimer m_timer;
     muse::io::path_t m_lastProjectPathNeedingAutosave;
+    muse::ProgressPtr m_saveProgress;
 };
 }
 